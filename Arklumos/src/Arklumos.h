@@ -5,13 +5,19 @@
 #include "Arklumos/Core/Base.h"
 
 #include "Arklumos/Core/Application.h"
+#include "Arklumos/Core/JobSystem.h"
+#include "Arklumos/Core/FrameAllocator.h"
+#include "Arklumos/Debug/MemoryTracker.h"
 #include "Arklumos/Core/Layer.h"
 #include "Arklumos/Core/Log.h"
 #include "Arklumos/Core/Assert.h"
 
 #include "Arklumos/Core/Timestep.h"
+#include "Arklumos/Core/Timer.h"
+#include "Arklumos/Core/StringId.h"
 
 #include "Arklumos/Core/Input.h"
+#include "Arklumos/Core/InputActionMap.h"
 #include "Arklumos/Core/KeyCodes.h"
 #include "Arklumos/Core/MouseCodes.h"
 
@@ -22,17 +28,21 @@
 #include "Arklumos/Scene/Scene.h"
 #include "Arklumos/Scene/Entity.h"
 #include "Arklumos/Scene/ScriptableEntity.h"
+#include "Arklumos/Scene/SystemScheduler.h"
 #include "Arklumos/Scene/Components.h"
 
 // ---Renderer------------------------
 #include "Arklumos/Renderer/Renderer.h"
 #include "Arklumos/Renderer/Renderer2D.h"
+#include "Arklumos/Renderer/RenderThread.h"
+#include "Arklumos/Renderer/FramePacer.h"
 #include "Arklumos/Renderer/RenderCommand.h"
 
 #include "Arklumos/Renderer/Buffer.h"
 #include "Arklumos/Renderer/Shader.h"
 #include "Arklumos/Renderer/Framebuffer.h"
 #include "Arklumos/Renderer/Texture.h"
+#include "Arklumos/Renderer/TextureLoader.h"
 #include "Arklumos/Renderer/VertexArray.h"
 
 #include "Arklumos/Renderer/OrthographicCamera.h"
@@ -4,38 +4,119 @@
 #include "Arklumos/Core/Log.h"
 
 #include "Arklumos/Renderer/Renderer.h"
+#include "Arklumos/Renderer/Shader.h"
+#include "Arklumos/Renderer/ShaderHotReload.h"
 
 #include "Arklumos/Core/Input.h"
 
-#include <GLFW/glfw3.h>
 namespace Arklumos
 {
 
 	Application *Application::s_Instance = nullptr;
+	ApplicationCommandLineArgs Application::s_CommandLineArgs;
+
+	// Frames run after an event: ImGui needs a few frames to settle (hovered items are known a frame after the mouse moved, popups open the next frame, ...)
+	static constexpr uint32_t s_EventRedrawFrameCount = 3;
+
+	// Frames run after a shader reload: the new program replaces the previous one once the driver is done compiling it, which takes a few frames
+	static constexpr uint32_t s_ShaderReloadRedrawFrameCount = 60;
 
 	Application::Application(const std::string &name)
+			: Application(ApplicationSpecification{name})
+	{
+	}
+
+	Application::Application(const ApplicationSpecification &specification)
+			: m_Specification(specification)
 	{
 		// AK_PROFILE_FUNCTION();
 
+		AK_MEMORY_TAG(Core);
+
 		AK_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
 
+		ApplyCommandLineArgs();
+
+		AK_CORE_ASSERT(m_Specification.MaxFixedUpdatesPerFrame > 0, "At least one fixed update per frame is needed!");
+		if (m_Specification.FixedUpdateRate > 0)
+		{
+			m_FixedTimestep = 1000000000ll / m_Specification.FixedUpdateRate;
+		}
+
+		m_IdleRendering = m_Specification.IdleRendering;
+		// The first frames are always drawn
+		m_RedrawFrameCount = s_EventRedrawFrameCount;
+
+		// Started first so that every system (and the layers) can submit jobs from their initialization
+		JobSystem::Init(m_Specification.JobSystem);
+
 		// Creates a new window passing in a WindowProps object with the specified name
-		m_Window = Window::Create(WindowProps(name));
+		m_Window = Window::Create(WindowProps(m_Specification.Name, 1920, 1080, !m_Specification.Headless));
+		if (m_Specification.Headless)
+		{
+			// The frames aren't shown, nothing to synchronize with
+			m_Window->SetVSync(false);
+		}
+
+		if (!m_Specification.InputReplayPath.empty())
+		{
+			m_InputPlayer = CreateScope<InputPlayer>();
+			if (!m_InputPlayer->Open(m_Specification.InputReplayPath))
+			{
+				m_InputPlayer.reset();
+			}
+		}
+		else if (!m_Specification.InputRecordPath.empty())
+		{
+			m_InputRecorder = CreateScope<InputRecorder>();
+			if (!m_InputRecorder->Open(m_Specification.InputRecordPath))
+			{
+				m_InputRecorder.reset();
+			}
+		}
+
+		// The recorded frames are the frames that were run, the frames skipped while idle would be missing from a recording
+		if (m_InputRecorder || m_InputPlayer)
+		{
+			m_IdleRendering = false;
+		}
 
 		/*
 			Sets the event callback function for the window using the SetEventCallback method of the Window class.
 			The callback function is specified using the AK_BIND_EVENT_FN macro, which takes a function pointer and binds it to a particular class instance (Application in this case). The actual callback function being used is OnEvent
 		*/
 		m_Window->SetEventCallback(AK_BIND_EVENT_FN(Application::OnEvent));
+		// The events are queued while the window polls them, and dispatched together once the polling is done (see DispatchEvents)
+		m_Window->SetEventQueue(&m_EventQueue);
+
+		m_EventHandlers.Subscribe<WindowCloseEvent>(AK_BIND_EVENT_FN(Application::OnWindowClose));
+		m_EventHandlers.Subscribe<WindowResizeEvent>(AK_BIND_EVENT_FN(Application::OnWindowResize));
 
 		Renderer::Init();
+		FramePacer::Init(m_Specification.FramePacing);
+		TextureLoader::Init(m_Specification.TextureLoading);
+
+		if (m_Specification.ShaderHotReload)
+		{
+			ShaderHotReload::Init(m_Specification.ShaderDirectory);
+		}
+
+		if (m_Specification.InputSamplingRate > 0)
+		{
+			m_InputSamplingPeriod = 1000000000ll / m_Specification.InputSamplingRate;
+			FramePacer::SetWaitCallback([this](int64_t duration)
+																	{ SampleInput(duration); });
+		}
 
 		/*
 			Creates a new ImGuiLayer object and assigns it to the m_ImGuiLayer pointer variable of the current object.
 			Then, it calls the PushOverlay function of the current object, passing the m_ImGuiLayer pointer as an argument.
 		*/
-		m_ImGuiLayer = new ImGuiLayer();
+		{
+			AK_MEMORY_TAG(ImGui);
+			m_ImGuiLayer = new ImGuiLayer();
+		}
 
 		/*
 			The PushOverlay function is used to add the m_ImGuiLayer as an overlay to the rendering pipeline.
@@ -48,7 +129,20 @@ namespace Arklumos
 	{
 		// AK_PROFILE_FUNCTION();
 
+		ShaderHotReload::Shutdown();
+		TextureLoader::Shutdown();
+		FramePacer::Shutdown();
 		Renderer::Shutdown();
+		JobSystem::Shutdown();
+	}
+
+	void Application::UpdateShaderHotReload()
+	{
+		// Records the reloads in the commands of the frame, and keeps drawing frames while idle until the new programs are in use
+		if (ShaderHotReload::Update())
+		{
+			RequestRedraw(s_ShaderReloadRedrawFrameCount);
+		}
 	}
 
 	void Application::PushLayer(Layer *layer)
@@ -57,6 +151,7 @@ namespace Arklumos
 
 		m_LayerStack.PushLayer(layer);
 		layer->OnAttach();
+		m_EventSubscribersGeneration = 0;
 	}
 
 	void Application::PushOverlay(Layer *layer)
@@ -65,6 +160,7 @@ namespace Arklumos
 
 		m_LayerStack.PushOverlay(layer);
 		layer->OnAttach();
+		m_EventSubscribersGeneration = 0;
 	}
 
 	void Application::Close()
@@ -76,44 +172,144 @@ namespace Arklumos
 	{
 		// AK_PROFILE_FUNCTION();
 
-		/*
-			The EventDispatcher object is constructed with the Event object and provides a Dispatch function that is used to invoke a callback function for the specific event type.
-			In this case, the WindowCloseEvent type is checked and if it matches the event type, the OnWindowClose function is invoked using a macro called BIND_EVENT_FN.
-		*/
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<WindowCloseEvent>(AK_BIND_EVENT_FN(Application::OnWindowClose));
-		dispatcher.Dispatch<WindowResizeEvent>(AK_BIND_EVENT_FN(Application::OnWindowResize));
+		AK_MEMORY_TAG(Events);
+
+		// Anything happening to the window or the input may change what is drawn
+		RequestRedraw(s_EventRedrawFrameCount);
+
+		// The handlers of the application itself (WindowCloseEvent, WindowResizeEvent) run first
+		m_EventHandlers.Dispatch(e);
 
 		/*
-			The function then iterates through the m_LayerStack vector from back to front, calling the OnEvent function of each layer in turn.
-			The OnEvent function of each layer is responsible for handling the event if it is applicable.
-			If the event is marked as "handled" by one of the layers, the iteration is stopped using the break keyword.
+			Then the layers interested in the event, from the top of the stack (the overlays) to the bottom.
+			If the event is marked as "handled" by one of the layers, the iteration is stopped.
 		*/
-		for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it)
+		for (Layer *layer : GetEventSubscribers(e))
 		{
 			if (e.Handled)
 			{
 				break;
 			}
-			(*it)->OnEvent(e);
+			layer->DispatchEvent(e);
 		}
 	}
 
+	const std::vector<Layer *> &Application::GetEventSubscribers(const Event &e)
+	{
+		// Generation 0 is never current: PushLayer resets it to invalidate the lists
+		uint32_t generation = EventHandlerTable::GetGeneration() + 1;
+		if (m_EventSubscribersGeneration != generation)
+		{
+			for (EventSubscriberList &list : m_EventSubscribers)
+			{
+				list.Valid = false;
+			}
+			m_EventSubscribersGeneration = generation;
+		}
+
+		EventSubscriberList &list = m_EventSubscribers[(size_t)e.GetEventType()];
+		if (!list.Valid)
+		{
+			int categoryFlags = e.GetCategoryFlags();
+
+			list.Layers.clear();
+			for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it)
+			{
+				if ((*it)->IsSubscribedTo(e.GetEventType(), categoryFlags))
+				{
+					list.Layers.push_back(*it);
+				}
+			}
+			list.Valid = true;
+		}
+		return list.Layers;
+	}
+
 	void Application::Run()
 	{
 		// AK_PROFILE_FUNCTION();
 
+		Shader::CacheStatistics shaderStats = Shader::GetCacheStats();
+		AK_CORE_INFO("Startup took {0:.1f} ms, shaders: {1} loaded from the program cache ({2:.1f} ms), {3} compiled ({4:.1f} ms)",
+								 m_Clock.ElapsedMillis(), shaderStats.Hits, shaderStats.LoadTime, shaderStats.Misses, shaderStats.CompileTime);
+
+		// Started once the layers are attached, so that everything they created during their initialization was created with the context on the main thread
+		if (m_Specification.UseRenderThread)
+		{
+			RenderThread::Start(m_Window->GetGraphicsContext());
+		}
+
+		// A first snapshot, so the first frame doesn't see the whole input as pressed edges and the cursor jumping from the origin
+		int64_t initialFrameTime = 0;
+		if (BeginInputFrame(initialFrameTime))
+		{
+			DispatchEvents();
+		}
+		bool firstFrame = true;
+
 		while (m_Running)
 		{
 			// AK_PROFILE_SCOPE("RunLoop");
 
-			float time = (float)glfwGetTime();
-			Timestep timestep = time - m_LastFrameTime;
+			if (m_IdleRendering && !ConsumeRedraw())
+			{
+				// Nothing changed, sleeps until an event or a redraw request instead of drawing the same frame again
+				m_Window->WaitEvents(m_Specification.IdleTimeout);
+				DispatchEvents();
+				JobSystem::ProcessMainThreadJobs();
+				UpdateShaderHotReload();
+
+				if (!ConsumeRedraw())
+				{
+					// The time spent idle isn't part of the next frame
+					m_LastFrameTime = m_Clock.ElapsedNanoseconds();
+					continue;
+				}
+			}
+
+			// Waits here when the frame rate is capped, so the wait is part of the frame time
+			FramePacer::BeginFrame();
+			m_FrameTimestamp = Timer::Now();
+
+			// Frees the transient allocations of the previous frame
+			FrameAllocator::BeginFrame();
+			MemoryTracker::Update();
+
+			// The frame time is computed in nanoseconds, only the difference is converted to float seconds
+			int64_t time = m_Clock.ElapsedNanoseconds();
+			int64_t frameTime = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
+			// The real duration of the previous frame (the first one also counts the initialization of the layers)
+			if (m_InputPlayer && !firstFrame)
+			{
+				m_InputPlayer->OnFrameCompleted(frameTime);
+			}
+			firstFrame = false;
+
+			// When replaying, the recorded frame time replaces the measured one
+			if (!BeginInputFrame(frameTime))
+			{
+				OnReplayEnded();
+				break;
+			}
+			Timestep timestep = (float)(frameTime * 1e-9);
+
+			// Jobs submitted from other threads that need the main thread (window calls, the GPU work goes through Renderer::Submit)
+			JobSystem::ProcessMainThreadJobs();
+			UpdateShaderHotReload();
+
+			// Uploads the decoded textures within the budget of the frame, the frames keep coming while textures are loading
+			if (TextureLoader::Update())
+			{
+				RequestRedraw();
+			}
+
 			// Update for each layer
 			if (!m_Minimized)
 			{
+				RunFixedUpdates(frameTime);
+
 				{
 					// AK_PROFILE_SCOPE("LayerStack OnUpdate");
 
@@ -121,8 +317,15 @@ namespace Arklumos
 						layer->OnUpdate(timestep);
 				}
 
+				// The events are only queued, they are dispatched at the end of the frame with the time they were received at (before ImGui starts its frame, its backend reads the input in the callbacks)
+				if (m_InputSamplingPeriod > 0)
+				{
+					m_Window->PollEvents();
+				}
+
 				// Starts the ImGui rendering process
 				// Begin() is a method provided by the ImGuiLayer class that initializes the rendering context
+				AK_MEMORY_TAG(ImGui);
 				m_ImGuiLayer->Begin();
 				{
 					// AK_PROFILE_SCOPE("LayerStack OnImGuiRender");
@@ -139,7 +342,190 @@ namespace Arklumos
 
 			// Updates the application window with the rendered ImGui elements and performs any other necessary updates
 			m_Window->OnUpdate();
+			DispatchEvents();
+
+			// The rendering resources released during the frame are deleted after its commands
+			ResourceRegistry::EndFrame();
+
+			// Fence of the frame, waits for the GPU when too many frames are queued
+			FramePacer::EndFrame();
+
+			// Hands the commands of this frame to the render thread, once it is done with the previous one
+			if (RenderThread::IsRunning())
+			{
+				// The main thread samples the input while the render thread completes the previous frame
+				if (m_InputSamplingPeriod > 0)
+				{
+					while (!RenderThread::WaitForFrame(m_InputSamplingPeriod))
+					{
+						m_Window->PollEvents();
+					}
+				}
+				RenderThread::NextFrame();
+			}
+		}
+
+		// The layers and the renderer are destroyed with the context back on the main thread
+		RenderThread::Stop();
+	}
+
+	void Application::DispatchEvents()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (m_InputPlayer)
+		{
+			// The live input is ignored, the recorded snapshot and events replace it
+			m_EventQueue.Dispatch([](Event &) {});
+			Input::SetSnapshot(m_InputPlayer->GetSnapshot());
+			m_InputPlayer->DispatchEvents(AK_BIND_EVENT_FN(Application::OnEvent));
+			return;
+		}
+
+		// The input is snapshotted at the same point, so the handlers and the next frame see the state matching the events
+		Input::Update();
+
+		if (m_InputRecorder)
+		{
+			m_InputRecorder->RecordSnapshot(Input::GetSnapshot());
+			m_EventQueue.Dispatch([this](Event &e)
+														{
+				m_InputRecorder->RecordEvent(e);
+				OnEvent(e); });
+			return;
+		}
+
+		m_EventQueue.Dispatch(AK_BIND_EVENT_FN(Application::OnEvent));
+	}
+
+	void Application::SampleInput(int64_t duration)
+	{
+		int64_t end = Timer::Now() + duration;
+		while (true)
+		{
+			m_Window->PollEvents();
+
+			int64_t remaining = end - Timer::Now();
+			if (remaining <= 0)
+			{
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(remaining, m_InputSamplingPeriod)));
+		}
+	}
+
+	bool Application::BeginInputFrame(int64_t &frameTime)
+	{
+		if (m_InputPlayer)
+		{
+			if (!m_InputPlayer->NextFrame())
+			{
+				return false;
+			}
+			frameTime = m_InputPlayer->GetFrameTime();
+		}
+		else if (m_InputRecorder)
+		{
+			m_InputRecorder->BeginFrame(frameTime);
+		}
+		return true;
+	}
+
+	void Application::OnReplayEnded()
+	{
+		auto stats = m_InputPlayer->GetStats();
+		AK_CORE_INFO("Replay: {0} frames in {1:.2f} ms, {2:.3f} ms per frame on average, {3:.3f} ms at most", stats.FrameCount, stats.TotalTime, stats.AverageFrameTime, stats.MaxFrameTime);
+
+		m_Running = false;
+	}
+
+	void Application::ApplyCommandLineArgs()
+	{
+		for (int i = 1; i < s_CommandLineArgs.Count; i++)
+		{
+			std::string_view arg = s_CommandLineArgs.Args[i];
+			bool hasValue = i + 1 < s_CommandLineArgs.Count;
+
+			if (arg == "--headless")
+			{
+				m_Specification.Headless = true;
+			}
+			else if (arg == "--record" && hasValue)
+			{
+				m_Specification.InputRecordPath = s_CommandLineArgs.Args[++i];
+			}
+			else if (arg == "--replay" && hasValue)
+			{
+				m_Specification.InputReplayPath = s_CommandLineArgs.Args[++i];
+			}
+		}
+	}
+
+	void Application::RunFixedUpdates(int64_t frameTime)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (m_FixedTimestep == 0)
+		{
+			return;
+		}
+
+		m_FixedUpdateAccumulator += frameTime;
+
+		Timestep fixedTimestep = GetFixedTimestep();
+		uint32_t tickCount = 0;
+		while (m_FixedUpdateAccumulator >= m_FixedTimestep)
+		{
+			if (tickCount == m_Specification.MaxFixedUpdatesPerFrame)
+			{
+				// Too far behind, the time that couldn't be simulated is dropped
+				m_FixedUpdateAccumulator %= m_FixedTimestep;
+				break;
+			}
+
+			for (Layer *layer : m_LayerStack)
+			{
+				layer->OnFixedUpdate(fixedTimestep);
+			}
+
+			m_FixedUpdateAccumulator -= m_FixedTimestep;
+			tickCount++;
+		}
+
+		m_FixedUpdateAlpha = (float)((double)m_FixedUpdateAccumulator / (double)m_FixedTimestep);
+	}
+
+	void Application::SetIdleRendering(bool enabled)
+	{
+		m_IdleRendering = enabled && !m_InputRecorder && !m_InputPlayer;
+		RequestRedraw(s_EventRedrawFrameCount);
+	}
+
+	void Application::RequestRedraw(uint32_t frameCount)
+	{
+		uint32_t current = m_RedrawFrameCount.load(std::memory_order_relaxed);
+		while (current < frameCount && !m_RedrawFrameCount.compare_exchange_weak(current, frameCount, std::memory_order_relaxed))
+		{
 		}
+
+		// The main thread may be waiting for events
+		if (m_IdleRendering && m_Window && !JobSystem::IsMainThread())
+		{
+			m_Window->PostEmptyEvent();
+		}
+	}
+
+	bool Application::ConsumeRedraw()
+	{
+		uint32_t current = m_RedrawFrameCount.load(std::memory_order_relaxed);
+		while (current > 0)
+		{
+			if (m_RedrawFrameCount.compare_exchange_weak(current, current - 1, std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+		return false;
 	}
 
 	bool Application::OnWindowClose(WindowCloseEvent &e)
@@ -3,26 +3,120 @@
 #include "Arklumos/Core/Base.h"
 #include "Arklumos/Core/Window.h"
 #include "Arklumos/Core/LayerStack.h"
+#include "Arklumos/Core/JobSystem.h"
 #include "Arklumos/Events/Event.h"
 #include "Arklumos/Events/ApplicationEvent.h"
+#include "Arklumos/Events/EventQueue.h"
+#include "Arklumos/Events/EventHandlerTable.h"
 
 #include "Arklumos/Core/Timestep.h"
+#include "Arklumos/Core/Timer.h"
+#include "Arklumos/Core/FrameAllocator.h"
+#include "Arklumos/Core/InputRecording.h"
 
 #include "Arklumos/ImGui/ImGuiLayer.h"
 
+#include "Arklumos/Renderer/FramePacer.h"
+#include "Arklumos/Renderer/TextureLoader.h"
+
 int main(int argc, char **argv);
 
 namespace Arklumos
 {
 
+	struct ApplicationSpecification
+	{
+		std::string Name = "Arklumos App";
+		JobSystemSpecification JobSystem;
+
+		// Executes the render commands on a dedicated thread owning the graphics context, one frame behind the main thread (see RenderThread)
+		bool UseRenderThread = false;
+
+		// Frames in flight and frame rate cap (see FramePacer)
+		FramePacerSpecification FramePacing;
+
+		// Upload budget of the textures loaded asynchronously (see TextureLoader)
+		TextureLoaderSpecification TextureLoading;
+
+		// Ticks per second of the fixed updates (Layer::OnFixedUpdate), 0 disables them
+		uint32_t FixedUpdateRate = 60;
+
+		/*
+			Maximum number of fixed updates run in one frame to catch up with the real time.
+			When a tick costs more than its duration, catching up would make the next frame longer and require even more ticks (spiral of death),
+			past this count the remaining time is dropped and the simulation runs slower than the real time instead.
+		*/
+		uint32_t MaxFixedUpdatesPerFrame = 5;
+
+		/*
+			On demand rendering: frames are only run after an event or a redraw request (see Application::RequestRedraw), in between the main thread sleeps waiting for events.
+			IdleTimeout (in seconds) bounds the sleep, so the jobs queued for the main thread still run regularly.
+		*/
+		bool IdleRendering = false;
+		double IdleTimeout = 0.5;
+
+		// Runs with a hidden window and without vertical sync, for the benchmarks (the frames are still rendered, offscreen)
+		bool Headless = false;
+
+		/*
+			Records the session (frame times, input snapshots, window events) to InputRecordPath, or replays InputReplayPath in place of the live input
+			and closes the application at its end, logging the real frame times (see InputRecorder). Both disable the idle rendering.
+			Also set from the command line: --record <file>, --replay <file>, --headless.
+		*/
+		std::string InputRecordPath;
+		std::string InputReplayPath;
+
+		/*
+			Times per second the events are polled, 0 polls them once per frame.
+			GLFW only processes the events on the main thread, so the main thread samples them when it would otherwise wait (the frame rate cap, the render thread)
+			and once between the updates and the ImGui frame. The events are queued with the time they were received at (Event::Timestamp)
+			and dispatched at the end of the frame: less latency and precise timestamps, without dispatching in the middle of the updates.
+		*/
+		uint32_t InputSamplingRate = 0;
+
+		// Reloads the shaders of ShaderDirectory when their files are written (see ShaderHotReload)
+#ifdef AK_DIST
+		bool ShaderHotReload = false;
+#else
+		bool ShaderHotReload = true;
+#endif
+		std::string ShaderDirectory = "assets/shaders";
+	};
+
+	struct ApplicationCommandLineArgs
+	{
+		int Count = 0;
+		char **Args = nullptr;
+	};
+
 	class Application
 	{
 	public:
+		Application(const ApplicationSpecification &specification);
 		Application(const std::string &name = "Arklumos App");
 		virtual ~Application();
 
+		// Dispatches the event to the application and the layers right away
 		void OnEvent(Event &e);
 
+		/*
+			Queues an event, dispatched with the events of the window at the end of the frame (see EventQueue).
+			Can be called from any thread.
+		*/
+		template <typename T>
+		void PostEvent(const T &event)
+		{
+			m_EventQueue.Post(event);
+
+			// The main thread may be waiting for events
+			if (!JobSystem::IsMainThread())
+			{
+				RequestRedraw();
+			}
+		}
+
+		EventQueue &GetEventQueue() { return m_EventQueue; }
+
 		void PushLayer(Layer *layer);
 		void PushOverlay(Layer *layer);
 
@@ -32,22 +126,93 @@ namespace Arklumos
 
 		ImGuiLayer *GetImGuiLayer() { return m_ImGuiLayer; }
 
+		const ApplicationSpecification &GetSpecification() const { return m_Specification; }
+
+		// Seconds since the application started, from a monotonic clock
+		double GetTime() const { return m_Clock.Elapsed(); }
+
+		Timestep GetFixedTimestep() const { return Timestep((float)(m_FixedTimestep * 1e-9)); }
+
+		/*
+			Fraction of a tick elapsed since the last fixed update, in [0, 1).
+			The frame shows the state between the last two ticks: rendering lerp(previous, current, alpha) keeps the motion smooth when the frame rate and the tick rate differ
+			(Scene::OnUpdateRuntime takes it for the entities with an InterpolatedTransformComponent).
+		*/
+		float GetFixedUpdateAlpha() const { return m_FixedUpdateAlpha; }
+
+		// Timer::Now() at the beginning of the current frame, to place the timestamps of the events within the frames
+		int64_t GetFrameTimestamp() const { return m_FrameTimestamp; }
+
+		void SetIdleRendering(bool enabled);
+		bool IsIdleRendering() const { return m_IdleRendering; }
+
+		/*
+			Runs at least the given number of frames, when idle rendering is enabled (the call does nothing otherwise).
+			To be called when something changes without an event: an animation or a simulation in progress, a resource loaded in the background, ...
+			Can be called from any thread.
+		*/
+		void RequestRedraw(uint32_t frameCount = 1);
+
 		static Application &Get() { return *s_Instance; }
 
 	private:
 		void Run();
 		bool OnWindowClose(WindowCloseEvent &e);
 		bool OnWindowResize(WindowResizeEvent &e);
-
+		void RunFixedUpdates(int64_t frameTime);
+		// Whether the next frame has to be run, consumes one of the requested frames
+		bool ConsumeRedraw();
+		void DispatchEvents();
+		void UpdateShaderHotReload();
+		void ApplyCommandLineArgs();
+		// Polls the events for the given duration (in nanoseconds), at the sampling rate
+		void SampleInput(int64_t duration);
+		// Replaces the frame time by the recorded one when replaying, false at the end of the recording
+		bool BeginInputFrame(int64_t &frameTime);
+		void OnReplayEnded();
+		// Layers interested in the event, from the top of the stack
+		const std::vector<Layer *> &GetEventSubscribers(const Event &e);
+
+		ApplicationSpecification m_Specification;
+		// Declared before the window, which posts to it until it is destroyed
+		EventQueue m_EventQueue;
 		Scope<Window> m_Window;
 		ImGuiLayer *m_ImGuiLayer;
 		bool m_Running = true;
 		bool m_Minimized = false;
 		LayerStack m_LayerStack;
 
-		float m_LastFrameTime = 0.0f;
+		EventHandlerTable m_EventHandlers;
+		/*
+			Per event type, built the first time an event of the type is dispatched (the categories of a type are only known from an event).
+			Rebuilt when the layer stack or a subscription changes.
+		*/
+		struct EventSubscriberList
+		{
+			std::vector<Layer *> Layers;
+			bool Valid = false;
+		};
+		std::array<EventSubscriberList, EventTypeCount> m_EventSubscribers;
+		uint32_t m_EventSubscribersGeneration = 0;
+
+		// Times in nanoseconds
+		Timer m_Clock;
+		int64_t m_LastFrameTime = 0;
+		int64_t m_FixedTimestep = 0;
+		int64_t m_FixedUpdateAccumulator = 0;
+		float m_FixedUpdateAlpha = 0.0f;
+		int64_t m_FrameTimestamp = 0;
+		int64_t m_InputSamplingPeriod = 0;
+
+		bool m_IdleRendering = false;
+		std::atomic<uint32_t> m_RedrawFrameCount{0};
+
+		Scope<InputRecorder> m_InputRecorder;
+		Scope<InputPlayer> m_InputPlayer;
 
 		static Application *s_Instance;
+		// Set by main before the application is created
+		static ApplicationCommandLineArgs s_CommandLineArgs;
 		friend int ::main(int argc, char **argv);
 	};
 
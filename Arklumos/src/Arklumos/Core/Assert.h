@@ -13,6 +13,7 @@
 		if (!(check))                                      \
 		{                                                  \
 			AK##type##ERROR(msg, __VA_ARGS__);               \
+			::Arklumos::Log::Flush();                        \
 			AK_DEBUGBREAK();                                 \
 		}                                                  \
 	}
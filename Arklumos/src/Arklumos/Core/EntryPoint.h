@@ -13,6 +13,8 @@ int main(int argc, char **argv)
 	Arklumos::Log::Init();
 	AK_CORE_WARN("Initialized Windows Log For engine!");
 
+	Arklumos::Application::s_CommandLineArgs = {argc, argv};
+
 	// AK_PROFILE_BEGIN_SESSION("Startup", "ArklumosProfile-Startup.json");
 	auto app = Arklumos::CreateApplication();
 	// AK_PROFILE_END_SESSION();
@@ -24,6 +26,8 @@ int main(int argc, char **argv)
 	// AK_PROFILE_BEGIN_SESSION("Shutdown", "ArklumosProfile-Shutdown.json");
 	delete app;
 	// AK_PROFILE_END_SESSION();
+
+	Arklumos::Log::Shutdown();
 }
 
 #elif defined(AK_PLATFORM_LINUX)
@@ -35,6 +39,8 @@ int main(int argc, char **argv)
 	Arklumos::Log::Init();
 	AK_CORE_WARN("Initialized GNU/Linux Log For engine!");
 
+	Arklumos::Application::s_CommandLineArgs = {argc, argv};
+
 	// AK_PROFILE_BEGIN_SESSION("Startup", "ArklumosProfile-Startup.json");
 	auto app = Arklumos::CreateApplication();
 	// AK_PROFILE_END_SESSION();
@@ -46,6 +52,8 @@ int main(int argc, char **argv)
 	// AK_PROFILE_BEGIN_SESSION("Shutdown", "ArklumosProfile-Shutdown.json");
 	delete app;
 	// AK_PROFILE_END_SESSION();
+
+	Arklumos::Log::Shutdown();
 }
 
 #endif
\ No newline at end of file
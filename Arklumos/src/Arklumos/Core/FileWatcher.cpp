@@ -0,0 +1,152 @@
+#include "akpch.h"
+#include "Arklumos/Core/FileWatcher.h"
+
+#ifdef AK_PLATFORM_LINUX
+#include <cstring>
+#include <sys/inotify.h>
+#endif
+
+namespace Arklumos
+{
+
+	static std::string NormalizePath(const std::filesystem::path &path)
+	{
+		return path.lexically_normal().generic_string();
+	}
+
+#ifdef AK_PLATFORM_LINUX
+
+	FileWatcher::FileWatcher(const std::string &directory)
+			: m_Directory(NormalizePath(directory))
+	{
+		m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_InotifyFd == -1)
+		{
+			AK_CORE_ERROR("FileWatcher: inotify_init1 failed ({0})", strerror(errno));
+			return;
+		}
+
+		// inotify doesn't watch the subdirectories, each one gets its own watch
+		std::vector<std::string> directories = {m_Directory};
+		std::error_code error;
+		for (auto &entry : std::filesystem::recursive_directory_iterator(m_Directory, error))
+		{
+			if (entry.is_directory(error))
+			{
+				directories.push_back(NormalizePath(entry.path()));
+			}
+		}
+
+		for (const std::string &watchedDirectory : directories)
+		{
+			int watch = inotify_add_watch(m_InotifyFd, watchedDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+			if (watch == -1)
+			{
+				AK_CORE_WARN("FileWatcher: could not watch '{0}' ({1})", watchedDirectory, strerror(errno));
+				continue;
+			}
+			m_WatchedDirectories[watch] = watchedDirectory;
+		}
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		if (m_InotifyFd != -1)
+		{
+			close(m_InotifyFd);
+		}
+	}
+
+	std::vector<std::string> FileWatcher::Poll()
+	{
+		std::vector<std::string> files;
+		if (m_InotifyFd == -1)
+		{
+			return files;
+		}
+
+		alignas(inotify_event) char buffer[4096];
+		while (true)
+		{
+			ssize_t length = read(m_InotifyFd, buffer, sizeof(buffer));
+			if (length <= 0)
+			{
+				// EAGAIN: no more events
+				break;
+			}
+
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const inotify_event *event = (const inotify_event *)(buffer + offset);
+				offset += sizeof(inotify_event) + event->len;
+
+				auto it = m_WatchedDirectories.find(event->wd);
+				if (it == m_WatchedDirectories.end() || event->len == 0 || (event->mask & IN_ISDIR))
+				{
+					continue;
+				}
+
+				std::string file = NormalizePath(std::filesystem::path(it->second) / event->name);
+				if (std::find(files.begin(), files.end(), file) == files.end())
+				{
+					files.push_back(file);
+				}
+			}
+		}
+		return files;
+	}
+
+#else
+
+	// Scanning the directory costs a system call per file, the edits don't need to be seen within a frame
+	static constexpr double s_ScanInterval = 250.0;
+
+	FileWatcher::FileWatcher(const std::string &directory)
+			: m_Directory(NormalizePath(directory))
+	{
+		std::error_code error;
+		for (auto &entry : std::filesystem::recursive_directory_iterator(m_Directory, error))
+		{
+			if (entry.is_regular_file(error))
+			{
+				m_WriteTimes[NormalizePath(entry.path())] = entry.last_write_time(error);
+			}
+		}
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+	}
+
+	std::vector<std::string> FileWatcher::Poll()
+	{
+		std::vector<std::string> files;
+		if (m_ScanTimer.ElapsedMillis() < s_ScanInterval)
+		{
+			return files;
+		}
+		m_ScanTimer.Reset();
+
+		std::error_code error;
+		for (auto &entry : std::filesystem::recursive_directory_iterator(m_Directory, error))
+		{
+			if (!entry.is_regular_file(error))
+			{
+				continue;
+			}
+
+			std::string file = NormalizePath(entry.path());
+			std::filesystem::file_time_type writeTime = entry.last_write_time(error);
+			auto [it, inserted] = m_WriteTimes.try_emplace(file, writeTime);
+			if (inserted || it->second != writeTime)
+			{
+				it->second = writeTime;
+				files.push_back(file);
+			}
+		}
+		return files;
+	}
+
+#endif
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+#include "Arklumos/Core/Timer.h"
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		Reports the files written in a directory and its subdirectories, without blocking: Poll returns the files completed since its last call.
+
+		On Linux the directories are watched with inotify, a file is reported once it is closed after a write or moved in place
+		(the editors saving to a temporary file and renaming it), so a file being written isn't reported half way.
+		On the other platforms the modification times are compared, at most a few times per second.
+	*/
+	class FileWatcher
+	{
+	public:
+		FileWatcher(const std::string &directory);
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher &) = delete;
+		FileWatcher &operator=(const FileWatcher &) = delete;
+
+		// The paths are the directory followed by the path of the file in it, normalized with lexically_normal and '/' separators
+		std::vector<std::string> Poll();
+
+		const std::string &GetDirectory() const { return m_Directory; }
+
+	private:
+		std::string m_Directory;
+
+#ifdef AK_PLATFORM_LINUX
+		int m_InotifyFd = -1;
+		// Watch descriptor -> watched directory
+		std::unordered_map<int, std::string> m_WatchedDirectories;
+#else
+		std::unordered_map<std::string, std::filesystem::file_time_type> m_WriteTimes;
+		Timer m_ScanTimer;
+#endif
+	};
+
+}
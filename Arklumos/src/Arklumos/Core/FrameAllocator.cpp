@@ -0,0 +1,138 @@
+#include "akpch.h"
+#include "Arklumos/Core/FrameAllocator.h"
+
+#include "Arklumos/Core/JobSystem.h"
+
+namespace Arklumos
+{
+
+	static size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	LinearAllocator::LinearAllocator(size_t blockSize)
+		: m_BlockSize(blockSize)
+	{
+	}
+
+	void LinearAllocator::AddBlock(size_t minimumSize)
+	{
+		AK_MEMORY_TAG(FrameAllocator);
+
+		Block block;
+		block.Size = std::max(m_BlockSize, minimumSize);
+		block.Data = Scope<uint8_t[]>(new uint8_t[block.Size]);
+		m_Blocks.push_back(std::move(block));
+	}
+
+	void *LinearAllocator::Allocate(size_t size, size_t alignment)
+	{
+		AK_CORE_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "The alignment must be a power of 2!");
+
+		// The blocks come from new[], aligned for any fundamental type, so the offsets only have to be aligned for the alignments above that
+		while (m_CurrentBlock < m_Blocks.size())
+		{
+			Block &block = m_Blocks[m_CurrentBlock];
+			uintptr_t base = (uintptr_t)block.Data.get();
+			size_t offset = AlignUp(base + m_Offset, alignment) - base;
+			if (offset + size <= block.Size)
+			{
+				m_Used += offset + size - m_Offset;
+				m_Offset = offset + size;
+				return block.Data.get() + offset;
+			}
+
+			m_CurrentBlock++;
+			m_Offset = 0;
+		}
+
+		AddBlock(size + alignment);
+		return Allocate(size, alignment);
+	}
+
+	void LinearAllocator::Reset()
+	{
+		if (m_Blocks.size() > 1)
+		{
+			size_t capacity = GetCapacity();
+			m_Blocks.clear();
+			AddBlock(capacity);
+		}
+
+		m_CurrentBlock = 0;
+		m_Offset = 0;
+		m_Used = 0;
+	}
+
+	size_t LinearAllocator::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (const Block &block : m_Blocks)
+		{
+			capacity += block.Size;
+		}
+		return capacity;
+	}
+
+	struct FrameAllocatorData
+	{
+		LinearAllocator Frame;
+		LinearAllocator DoubleBuffered[2];
+		uint32_t DoubleBufferedIndex = 0;
+
+		LinearMemoryResource FrameResource{Frame};
+		LinearMemoryResource DoubleBufferedResources[2] = {LinearMemoryResource(DoubleBuffered[0]), LinearMemoryResource(DoubleBuffered[1])};
+
+		FrameAllocator::Statistics Stats;
+	};
+
+	static FrameAllocatorData s_Data;
+
+	void FrameAllocator::BeginFrame()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_CORE_ASSERT(JobSystem::IsMainThread(), "The frame allocator belongs to the main thread!");
+
+		s_Data.Stats.UsedMemory = s_Data.Frame.GetUsedMemory();
+		s_Data.Stats.DoubleBufferedUsedMemory = s_Data.DoubleBuffered[s_Data.DoubleBufferedIndex].GetUsedMemory();
+
+		s_Data.Frame.Reset();
+
+		// The other allocator holds the data of the previous frame, this one the data of the frame before it
+		s_Data.DoubleBufferedIndex ^= 1;
+		s_Data.DoubleBuffered[s_Data.DoubleBufferedIndex].Reset();
+
+		s_Data.Stats.Capacity = s_Data.Frame.GetCapacity() + s_Data.DoubleBuffered[0].GetCapacity() + s_Data.DoubleBuffered[1].GetCapacity();
+	}
+
+	void *FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		AK_CORE_ASSERT(JobSystem::IsMainThread(), "The frame allocator belongs to the main thread!");
+		return s_Data.Frame.Allocate(size, alignment);
+	}
+
+	void *FrameAllocator::AllocateDoubleBuffered(size_t size, size_t alignment)
+	{
+		AK_CORE_ASSERT(JobSystem::IsMainThread(), "The frame allocator belongs to the main thread!");
+		return s_Data.DoubleBuffered[s_Data.DoubleBufferedIndex].Allocate(size, alignment);
+	}
+
+	std::pmr::memory_resource *FrameAllocator::GetResource()
+	{
+		return &s_Data.FrameResource;
+	}
+
+	std::pmr::memory_resource *FrameAllocator::GetDoubleBufferedResource()
+	{
+		// Changes every frame, a container must not keep it across frames
+		return &s_Data.DoubleBufferedResources[s_Data.DoubleBufferedIndex];
+	}
+
+	FrameAllocator::Statistics FrameAllocator::GetStats()
+	{
+		return s_Data.Stats;
+	}
+
+}
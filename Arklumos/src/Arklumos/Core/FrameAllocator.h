@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		Bump allocator: an allocation moves an offset forward in a block of memory, and everything is freed at once by Reset.
+		There is no per allocation bookkeeping and no deallocation, which suits data that all dies at the same time (the transient data of a frame).
+
+		When a block is full a new one is added. On Reset, the blocks are merged in a single block big enough for all of them,
+		so after a few frames a steady workload fits in one block and the allocator doesn't allocate anymore.
+
+		Not thread safe. Destructors are never called, only store trivially destructible data or objects whose destruction doesn't matter (see LinearMemoryResource).
+	*/
+	class LinearAllocator
+	{
+	public:
+		LinearAllocator(size_t blockSize = 1024 * 1024);
+		LinearAllocator(const LinearAllocator &) = delete;
+		LinearAllocator &operator=(const LinearAllocator &) = delete;
+
+		void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template <typename T, typename... Args>
+		T *New(Args &&...args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "The destructor would never be called!");
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		void Reset();
+
+		size_t GetUsedMemory() const { return m_Used; }
+		size_t GetCapacity() const;
+		uint32_t GetBlockCount() const { return (uint32_t)m_Blocks.size(); }
+
+	private:
+		struct Block
+		{
+			Scope<uint8_t[]> Data;
+			size_t Size = 0;
+		};
+
+		void AddBlock(size_t minimumSize);
+
+		std::vector<Block> m_Blocks;
+		size_t m_CurrentBlock = 0;
+		size_t m_Offset = 0;
+		size_t m_Used = 0;
+		size_t m_BlockSize;
+	};
+
+	/*
+		Adapter letting the std::pmr containers allocate from a LinearAllocator. Deallocations are ignored, the memory comes back when the allocator is reset,
+		so the containers using it must not outlive the reset (their destructor would then only run the destructors of their elements).
+	*/
+	class LinearMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		LinearMemoryResource(LinearAllocator &allocator)
+			: m_Allocator(allocator) {}
+
+	private:
+		virtual void *do_allocate(size_t bytes, size_t alignment) override { return m_Allocator.Allocate(bytes, alignment); }
+		virtual void do_deallocate(void *, size_t, size_t) override {}
+		virtual bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+		LinearAllocator &m_Allocator;
+	};
+
+	/*
+		Memory for the transient data of the main thread, freed all at once at the beginning of each frame (Application calls BeginFrame at the top of its loop).
+		A temporary container costs a few pointer bumps instead of heap allocations:
+
+			FrameVector<Entity> entities(FrameAllocator::GetResource());
+			scene->QueryAABB(bounds, entities);
+
+		The double buffered memory lives one frame longer: what is allocated during frame N is freed at the beginning of frame N + 2,
+		for the data the render thread reads while the main thread already works on the next frame.
+
+		Main thread only, the jobs allocate their own memory.
+	*/
+	class FrameAllocator
+	{
+	public:
+		struct Statistics
+		{
+			// Memory allocated during the last frame
+			size_t UsedMemory = 0;
+			size_t DoubleBufferedUsedMemory = 0;
+			// Memory owned by the allocators
+			size_t Capacity = 0;
+		};
+
+		static void BeginFrame();
+
+		static void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		static void *AllocateDoubleBuffered(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		static std::pmr::memory_resource *GetResource();
+		static std::pmr::memory_resource *GetDoubleBufferedResource();
+
+		static Statistics GetStats();
+	};
+
+	// Containers meant to be given FrameAllocator::GetResource() (default constructed, they use the heap like the std containers)
+	template <typename T>
+	using FrameVector = std::pmr::vector<T>;
+	using FrameString = std::pmr::string;
+
+}
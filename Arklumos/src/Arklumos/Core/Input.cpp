@@ -0,0 +1,116 @@
+#include "akpch.h"
+#include "Arklumos/Core/Input.h"
+
+#include "Arklumos/Core/JobSystem.h"
+
+namespace Arklumos
+{
+
+	struct InputFrame
+	{
+		InputSnapshot Current;
+		InputSnapshot Previous;
+	};
+
+	/*
+		SetSnapshot fills the frame that isn't published, then publishes it. The readers only ever see a complete frame,
+		as long as they don't keep reading one across two snapshots (the writer would then be filling the frame they read).
+	*/
+	struct InputData
+	{
+		InputFrame Frames[2];
+		std::atomic<uint32_t> PublishedFrame{0};
+	};
+
+	static InputData s_Data;
+
+	static const InputFrame &GetFrame()
+	{
+		return s_Data.Frames[s_Data.PublishedFrame.load(std::memory_order_acquire)];
+	}
+
+	static bool IsValidKey(KeyCode key)
+	{
+		return key < InputSnapshot::KeyCount;
+	}
+
+	static bool IsValidMouseButton(MouseCode button)
+	{
+		return button < InputSnapshot::MouseButtonCount;
+	}
+
+	bool Input::IsKeyPressed(const KeyCode key)
+	{
+		return IsValidKey(key) && GetFrame().Current.Keys[key];
+	}
+
+	bool Input::WasKeyPressed(const KeyCode key)
+	{
+		const InputFrame &frame = GetFrame();
+		return IsValidKey(key) && frame.Current.Keys[key] && !frame.Previous.Keys[key];
+	}
+
+	bool Input::WasKeyReleased(const KeyCode key)
+	{
+		const InputFrame &frame = GetFrame();
+		return IsValidKey(key) && !frame.Current.Keys[key] && frame.Previous.Keys[key];
+	}
+
+	bool Input::IsMouseButtonPressed(const MouseCode button)
+	{
+		return IsValidMouseButton(button) && GetFrame().Current.MouseButtons[button];
+	}
+
+	bool Input::WasMouseButtonPressed(const MouseCode button)
+	{
+		const InputFrame &frame = GetFrame();
+		return IsValidMouseButton(button) && frame.Current.MouseButtons[button] && !frame.Previous.MouseButtons[button];
+	}
+
+	bool Input::WasMouseButtonReleased(const MouseCode button)
+	{
+		const InputFrame &frame = GetFrame();
+		return IsValidMouseButton(button) && !frame.Current.MouseButtons[button] && frame.Previous.MouseButtons[button];
+	}
+
+	glm::vec2 Input::GetMousePosition()
+	{
+		return GetFrame().Current.MousePosition;
+	}
+
+	glm::vec2 Input::GetMouseDelta()
+	{
+		const InputFrame &frame = GetFrame();
+		return frame.Current.MousePosition - frame.Previous.MousePosition;
+	}
+
+	float Input::GetMouseX()
+	{
+		return GetMousePosition().x;
+	}
+
+	float Input::GetMouseY()
+	{
+		return GetMousePosition().y;
+	}
+
+	void Input::SetSnapshot(const InputSnapshot &snapshot)
+	{
+		AK_CORE_ASSERT(JobSystem::IsMainThread(), "The input is snapshotted on the main thread!");
+
+		uint32_t published = s_Data.PublishedFrame.load(std::memory_order_relaxed);
+		uint32_t next = published ^ 1;
+
+		InputFrame &frame = s_Data.Frames[next];
+		frame.Previous = s_Data.Frames[published].Current;
+		frame.Current = snapshot;
+
+		s_Data.PublishedFrame.store(next, std::memory_order_release);
+	}
+
+	InputSnapshot Input::GetSnapshot()
+	{
+		return GetFrame().Current;
+	}
+
+}
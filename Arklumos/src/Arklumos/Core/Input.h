@@ -4,18 +4,52 @@
 #include "Arklumos/Core/KeyCodes.h"
 #include "Arklumos/Core/MouseCodes.h"
 
+#include <bitset>
+
 namespace Arklumos
 {
 
+	// State of the keyboard and the mouse at one point in time
+	struct InputSnapshot
+	{
+		static constexpr uint32_t KeyCount = Key::Menu + 1;
+		static constexpr uint32_t MouseButtonCount = Mouse::ButtonLast + 1;
+
+		std::bitset<KeyCount> Keys;
+		std::bitset<MouseButtonCount> MouseButtons;
+		glm::vec2 MousePosition{0.0f, 0.0f};
+	};
+
+	/*
+		The input is read from a snapshot of the devices, taken once per frame by the application right after the window polled its events (see Update).
+		Every query of a frame sees the same state, and the pressed/released edges are the changes between the last two snapshots.
+
+		The snapshots are published by swapping an atomic index, so the queries are lock free reads that can be made from any thread:
+		the systems running in jobs read the input like the main thread does. A job must not outlive the frame it reads the input in.
+	*/
 	class Input
 	{
 	public:
 		static bool IsKeyPressed(KeyCode key);
+		// The key went down / up between the last two snapshots
+		static bool WasKeyPressed(KeyCode key);
+		static bool WasKeyReleased(KeyCode key);
 
 		static bool IsMouseButtonPressed(MouseCode button);
+		static bool WasMouseButtonPressed(MouseCode button);
+		static bool WasMouseButtonReleased(MouseCode button);
+
 		static glm::vec2 GetMousePosition();
+		// Movement of the cursor between the last two snapshots
+		static glm::vec2 GetMouseDelta();
 		static float GetMouseX();
 		static float GetMouseY();
+
+		// Snapshots the devices of the window of the application, main thread only (implemented by the platform)
+		static void Update();
+		// Publishes a snapshot built elsewhere (a recorded session, a test, ...), main thread only
+		static void SetSnapshot(const InputSnapshot &snapshot);
+		static InputSnapshot GetSnapshot();
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,392 @@
+#include "akpch.h"
+#include "Arklumos/Core/InputActionMap.h"
+
+#include <fstream>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Arklumos
+{
+
+	struct KeyName
+	{
+		KeyCode Key;
+		const char *Name;
+	};
+
+	// Names of the keys in the files, the names of KeyCodes.h
+	static constexpr KeyName s_KeyNames[] = {
+			{Key::Space, "Space"},
+			{Key::Apostrophe, "Apostrophe"},
+			{Key::Comma, "Comma"},
+			{Key::Minus, "Minus"},
+			{Key::Period, "Period"},
+			{Key::Slash, "Slash"},
+			{Key::D0, "D0"},
+			{Key::D1, "D1"},
+			{Key::D2, "D2"},
+			{Key::D3, "D3"},
+			{Key::D4, "D4"},
+			{Key::D5, "D5"},
+			{Key::D6, "D6"},
+			{Key::D7, "D7"},
+			{Key::D8, "D8"},
+			{Key::D9, "D9"},
+			{Key::Semicolon, "Semicolon"},
+			{Key::Equal, "Equal"},
+			{Key::A, "A"},
+			{Key::B, "B"},
+			{Key::C, "C"},
+			{Key::D, "D"},
+			{Key::E, "E"},
+			{Key::F, "F"},
+			{Key::G, "G"},
+			{Key::H, "H"},
+			{Key::I, "I"},
+			{Key::J, "J"},
+			{Key::K, "K"},
+			{Key::L, "L"},
+			{Key::M, "M"},
+			{Key::N, "N"},
+			{Key::O, "O"},
+			{Key::P, "P"},
+			{Key::Q, "Q"},
+			{Key::R, "R"},
+			{Key::S, "S"},
+			{Key::T, "T"},
+			{Key::U, "U"},
+			{Key::V, "V"},
+			{Key::W, "W"},
+			{Key::X, "X"},
+			{Key::Y, "Y"},
+			{Key::Z, "Z"},
+			{Key::LeftBracket, "LeftBracket"},
+			{Key::Backslash, "Backslash"},
+			{Key::RightBracket, "RightBracket"},
+			{Key::GraveAccent, "GraveAccent"},
+			{Key::World1, "World1"},
+			{Key::World2, "World2"},
+			{Key::Escape, "Escape"},
+			{Key::Enter, "Enter"},
+			{Key::Tab, "Tab"},
+			{Key::Backspace, "Backspace"},
+			{Key::Insert, "Insert"},
+			{Key::Delete, "Delete"},
+			{Key::Right, "Right"},
+			{Key::Left, "Left"},
+			{Key::Down, "Down"},
+			{Key::Up, "Up"},
+			{Key::PageUp, "PageUp"},
+			{Key::PageDown, "PageDown"},
+			{Key::Home, "Home"},
+			{Key::End, "End"},
+			{Key::CapsLock, "CapsLock"},
+			{Key::ScrollLock, "ScrollLock"},
+			{Key::NumLock, "NumLock"},
+			{Key::PrintScreen, "PrintScreen"},
+			{Key::Pause, "Pause"},
+			{Key::F1, "F1"},
+			{Key::F2, "F2"},
+			{Key::F3, "F3"},
+			{Key::F4, "F4"},
+			{Key::F5, "F5"},
+			{Key::F6, "F6"},
+			{Key::F7, "F7"},
+			{Key::F8, "F8"},
+			{Key::F9, "F9"},
+			{Key::F10, "F10"},
+			{Key::F11, "F11"},
+			{Key::F12, "F12"},
+			{Key::F13, "F13"},
+			{Key::F14, "F14"},
+			{Key::F15, "F15"},
+			{Key::F16, "F16"},
+			{Key::F17, "F17"},
+			{Key::F18, "F18"},
+			{Key::F19, "F19"},
+			{Key::F20, "F20"},
+			{Key::F21, "F21"},
+			{Key::F22, "F22"},
+			{Key::F23, "F23"},
+			{Key::F24, "F24"},
+			{Key::F25, "F25"},
+			{Key::KP0, "KP0"},
+			{Key::KP1, "KP1"},
+			{Key::KP2, "KP2"},
+			{Key::KP3, "KP3"},
+			{Key::KP4, "KP4"},
+			{Key::KP5, "KP5"},
+			{Key::KP6, "KP6"},
+			{Key::KP7, "KP7"},
+			{Key::KP8, "KP8"},
+			{Key::KP9, "KP9"},
+			{Key::KPDecimal, "KPDecimal"},
+			{Key::KPDivide, "KPDivide"},
+			{Key::KPMultiply, "KPMultiply"},
+			{Key::KPSubtract, "KPSubtract"},
+			{Key::KPAdd, "KPAdd"},
+			{Key::KPEnter, "KPEnter"},
+			{Key::KPEqual, "KPEqual"},
+			{Key::LeftShift, "LeftShift"},
+			{Key::LeftControl, "LeftControl"},
+			{Key::LeftAlt, "LeftAlt"},
+			{Key::LeftSuper, "LeftSuper"},
+			{Key::RightShift, "RightShift"},
+			{Key::RightControl, "RightControl"},
+			{Key::RightAlt, "RightAlt"},
+			{Key::RightSuper, "RightSuper"},
+			{Key::Menu, "Menu"}};
+
+	static const char *s_MouseButtonNames[] = {"Left", "Right", "Middle", "Button3", "Button4", "Button5", "Button6", "Button7"};
+	static_assert(sizeof(s_MouseButtonNames) / sizeof(s_MouseButtonNames[0]) == InputSnapshot::MouseButtonCount, "A mouse button has no name!");
+
+	static const char *KeyToString(KeyCode key)
+	{
+		for (const KeyName &keyName : s_KeyNames)
+		{
+			if (keyName.Key == key)
+			{
+				return keyName.Name;
+			}
+		}
+		return nullptr;
+	}
+
+	static bool KeyFromString(const std::string &name, KeyCode &outKey)
+	{
+		for (const KeyName &keyName : s_KeyNames)
+		{
+			if (name == keyName.Name)
+			{
+				outKey = keyName.Key;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool MouseButtonFromString(const std::string &name, MouseCode &outButton)
+	{
+		for (MouseCode button = 0; button < InputSnapshot::MouseButtonCount; button++)
+		{
+			if (name == s_MouseButtonNames[button])
+			{
+				outButton = button;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static const std::vector<InputBinding> s_NoBindings;
+
+	void InputActionMap::AddBinding(const std::string &action, const InputBinding &binding)
+	{
+		m_Actions[action].push_back(binding);
+	}
+
+	void InputActionMap::AddKeyBinding(const std::string &action, KeyCode key, float scale)
+	{
+		AddBinding(action, {InputBinding::DeviceType::Key, key, scale});
+	}
+
+	void InputActionMap::AddMouseButtonBinding(const std::string &action, MouseCode button, float scale)
+	{
+		AddBinding(action, {InputBinding::DeviceType::MouseButton, button, scale});
+	}
+
+	void InputActionMap::RemoveAction(const std::string &action)
+	{
+		m_Actions.erase(action);
+	}
+
+	void InputActionMap::Clear()
+	{
+		m_Actions.clear();
+	}
+
+	bool InputActionMap::HasAction(const std::string &action) const
+	{
+		return m_Actions.find(action) != m_Actions.end();
+	}
+
+	const std::vector<InputBinding> &InputActionMap::GetBindings(const std::string &action) const
+	{
+		auto it = m_Actions.find(action);
+		return it != m_Actions.end() ? it->second : s_NoBindings;
+	}
+
+	static bool IsBindingDown(const InputBinding &binding)
+	{
+		switch (binding.Device)
+		{
+		case InputBinding::DeviceType::Key:
+			return Input::IsKeyPressed(binding.Code);
+		case InputBinding::DeviceType::MouseButton:
+			return Input::IsMouseButtonPressed(binding.Code);
+		}
+		return false;
+	}
+
+	// The state in the previous snapshot, deduced from the current state and its edge
+	static bool WasBindingDown(const InputBinding &binding)
+	{
+		switch (binding.Device)
+		{
+		case InputBinding::DeviceType::Key:
+			return Input::IsKeyPressed(binding.Code) ? !Input::WasKeyPressed(binding.Code) : Input::WasKeyReleased(binding.Code);
+		case InputBinding::DeviceType::MouseButton:
+			return Input::IsMouseButtonPressed(binding.Code) ? !Input::WasMouseButtonPressed(binding.Code) : Input::WasMouseButtonReleased(binding.Code);
+		}
+		return false;
+	}
+
+	bool InputActionMap::IsDown(const std::string &action, bool previous) const
+	{
+		for (const InputBinding &binding : GetBindings(action))
+		{
+			if (previous ? WasBindingDown(binding) : IsBindingDown(binding))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool InputActionMap::IsActionDown(const std::string &action) const
+	{
+		return IsDown(action, false);
+	}
+
+	bool InputActionMap::WasActionPressed(const std::string &action) const
+	{
+		return IsDown(action, false) && !IsDown(action, true);
+	}
+
+	bool InputActionMap::WasActionReleased(const std::string &action) const
+	{
+		return !IsDown(action, false) && IsDown(action, true);
+	}
+
+	float InputActionMap::GetActionValue(const std::string &action) const
+	{
+		float value = 0.0f;
+		for (const InputBinding &binding : GetBindings(action))
+		{
+			if (IsBindingDown(binding))
+			{
+				value += binding.Scale;
+			}
+		}
+		return std::clamp(value, -1.0f, 1.0f);
+	}
+
+	void InputActionMap::Serialize(const std::string &filepath) const
+	{
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+		out << YAML::Key << "Actions" << YAML::Value << YAML::BeginSeq;
+		for (const auto &[name, bindings] : m_Actions)
+		{
+			out << YAML::BeginMap; // Action
+			out << YAML::Key << "Name" << YAML::Value << name;
+			out << YAML::Key << "Bindings" << YAML::Value << YAML::BeginSeq;
+			for (const InputBinding &binding : bindings)
+			{
+				out << YAML::BeginMap; // Binding
+				if (binding.Device == InputBinding::DeviceType::Key)
+				{
+					const char *keyName = KeyToString(binding.Code);
+					if (keyName)
+					{
+						out << YAML::Key << "Key" << YAML::Value << keyName;
+					}
+					else
+					{
+						out << YAML::Key << "Key" << YAML::Value << binding.Code;
+					}
+				}
+				else
+				{
+					out << YAML::Key << "MouseButton" << YAML::Value << s_MouseButtonNames[binding.Code];
+				}
+				if (binding.Scale != 1.0f)
+				{
+					out << YAML::Key << "Scale" << YAML::Value << binding.Scale;
+				}
+				out << YAML::EndMap; // Binding
+			}
+			out << YAML::EndSeq;
+			out << YAML::EndMap; // Action
+		}
+		out << YAML::EndSeq;
+		out << YAML::EndMap;
+
+		std::ofstream fout(filepath);
+		fout << out.c_str();
+	}
+
+	bool InputActionMap::Deserialize(const std::string &filepath)
+	{
+		YAML::Node data;
+		try
+		{
+			data = YAML::LoadFile(filepath);
+		}
+		catch (const YAML::Exception &e)
+		{
+			AK_CORE_WARN("Could not load the input actions '{0}': {1}", filepath, e.what());
+			return false;
+		}
+
+		auto actions = data["Actions"];
+		if (!actions)
+		{
+			return false;
+		}
+
+		m_Actions.clear();
+		for (auto action : actions)
+		{
+			std::string name = action["Name"].as<std::string>();
+			// An action without bindings still exists, HasAction reports it
+			std::vector<InputBinding> &bindings = m_Actions[name];
+
+			for (auto bindingNode : action["Bindings"])
+			{
+				InputBinding binding;
+				binding.Scale = bindingNode["Scale"] ? bindingNode["Scale"].as<float>() : 1.0f;
+
+				if (auto key = bindingNode["Key"])
+				{
+					binding.Device = InputBinding::DeviceType::Key;
+					// A key without a name can be written as its GLFW code
+					if (!KeyFromString(key.as<std::string>(), binding.Code))
+					{
+						binding.Code = key.as<uint16_t>(0);
+					}
+				}
+				else if (auto button = bindingNode["MouseButton"])
+				{
+					binding.Device = InputBinding::DeviceType::MouseButton;
+					if (!MouseButtonFromString(button.as<std::string>(), binding.Code))
+					{
+						binding.Code = button.as<uint16_t>(InputSnapshot::MouseButtonCount);
+					}
+				}
+
+				bool valid = binding.Device == InputBinding::DeviceType::Key ? binding.Code > 0 && binding.Code < InputSnapshot::KeyCount : binding.Code < InputSnapshot::MouseButtonCount;
+				if (!valid)
+				{
+					AK_CORE_WARN("Input action '{0}': ignoring an unknown binding", name);
+					continue;
+				}
+
+				bindings.push_back(binding);
+			}
+		}
+
+		return true;
+	}
+
+}
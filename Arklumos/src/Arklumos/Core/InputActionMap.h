@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Arklumos/Core/Input.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Arklumos
+{
+
+	struct InputBinding
+	{
+		enum class DeviceType : uint8_t
+		{
+			Key = 0,
+			MouseButton
+		};
+
+		DeviceType Device = DeviceType::Key;
+		uint16_t Code = 0;
+		// Contribution of the binding to the value of the action, -1 for the negative side of an axis
+		float Scale = 1.0f;
+	};
+
+	/*
+		Named actions bound to keys and mouse buttons, so the code asks for "MoveLeft" instead of a hardcoded key,
+		and the bindings can be changed in a file without recompiling:
+
+		Actions:
+		  - Name: MoveHorizontal
+		    Bindings:
+		      - Key: D
+		      - Key: A
+		        Scale: -1
+
+		The queries read the input snapshot (see Input), they can be made from any thread.
+		The bindings are changed on the main thread only, outside of the frames reading them.
+	*/
+	class InputActionMap
+	{
+	public:
+		void AddBinding(const std::string &action, const InputBinding &binding);
+		void AddKeyBinding(const std::string &action, KeyCode key, float scale = 1.0f);
+		void AddMouseButtonBinding(const std::string &action, MouseCode button, float scale = 1.0f);
+		void RemoveAction(const std::string &action);
+		void Clear();
+
+		bool HasAction(const std::string &action) const;
+		const std::vector<InputBinding> &GetBindings(const std::string &action) const;
+
+		// One of the bindings of the action is held
+		bool IsActionDown(const std::string &action) const;
+		// The action became down / up between the last two input snapshots
+		bool WasActionPressed(const std::string &action) const;
+		bool WasActionReleased(const std::string &action) const;
+		// Sum of the scales of the held bindings, clamped to [-1, 1]: the value of an axis made of two opposite keys
+		float GetActionValue(const std::string &action) const;
+
+		void Serialize(const std::string &filepath) const;
+		bool Deserialize(const std::string &filepath);
+
+	private:
+		// Whether one of the bindings is held, in the current snapshot or the previous one
+		bool IsDown(const std::string &action, bool previous) const;
+
+		std::unordered_map<std::string, std::vector<InputBinding>> m_Actions;
+	};
+
+}
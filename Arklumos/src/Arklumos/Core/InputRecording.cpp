@@ -0,0 +1,400 @@
+#include "akpch.h"
+#include "Arklumos/Core/InputRecording.h"
+
+#include "Arklumos/Core/Timer.h"
+
+#include "Arklumos/Events/ApplicationEvent.h"
+#include "Arklumos/Events/KeyEvent.h"
+#include "Arklumos/Events/MouseEvent.h"
+
+namespace Arklumos
+{
+
+	static constexpr char s_Magic[4] = {'A', 'K', 'I', 'R'};
+	static constexpr uint32_t s_Version = 1;
+
+	// Parts of the snapshot stored in a frame record
+	enum SnapshotChangeFlags : uint8_t
+	{
+		KeysChanged = BIT(0),
+		MouseButtonsChanged = BIT(1),
+		MousePositionChanged = BIT(2)
+	};
+
+	template <typename T>
+	static void WriteValue(std::vector<uint8_t> &buffer, const T &value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	template <typename T>
+	static T ReadValue(const std::vector<uint8_t> &buffer, size_t &offset)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		T value{};
+		if (offset + sizeof(T) <= buffer.size())
+		{
+			std::memcpy(&value, buffer.data() + offset, sizeof(T));
+		}
+		offset += sizeof(T);
+		return value;
+	}
+
+	template <typename T>
+	static void WriteValue(std::ofstream &stream, const T &value)
+	{
+		stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	static bool ReadValue(std::ifstream &stream, T &value)
+	{
+		return (bool)stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+	}
+
+	// A bitset is stored as its bits packed in bytes
+	template <size_t N>
+	static void WriteBits(std::ofstream &stream, const std::bitset<N> &bits)
+	{
+		uint8_t bytes[(N + 7) / 8] = {};
+		for (size_t i = 0; i < N; i++)
+		{
+			bytes[i / 8] |= (uint8_t)bits[i] << (i % 8);
+		}
+		stream.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+	}
+
+	template <size_t N>
+	static bool ReadBits(std::ifstream &stream, std::bitset<N> &bits)
+	{
+		uint8_t bytes[(N + 7) / 8];
+		if (!stream.read(reinterpret_cast<char *>(bytes), sizeof(bytes)))
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < N; i++)
+		{
+			bits[i] = (bytes[i / 8] >> (i % 8)) & 1;
+		}
+		return true;
+	}
+
+	InputRecorder::~InputRecorder()
+	{
+		Close();
+	}
+
+	bool InputRecorder::Open(const std::string &filepath)
+	{
+		m_Stream.open(filepath, std::ios::binary | std::ios::trunc);
+		if (!m_Stream)
+		{
+			AK_CORE_ERROR("Could not open the input recording '{0}'", filepath);
+			return false;
+		}
+
+		m_Stream.write(s_Magic, sizeof(s_Magic));
+		WriteValue(m_Stream, s_Version);
+
+		m_FrameCount = 0;
+		m_FrameStarted = false;
+		m_PreviousSnapshot = InputSnapshot();
+		return true;
+	}
+
+	void InputRecorder::Close()
+	{
+		if (!m_Stream.is_open())
+		{
+			return;
+		}
+
+		WriteFrame();
+		m_Stream.close();
+
+		AK_CORE_INFO("Input recording: {0} frames written", m_FrameCount);
+	}
+
+	void InputRecorder::BeginFrame(int64_t frameTime)
+	{
+		WriteFrame();
+
+		m_FrameStarted = true;
+		m_FrameTime = frameTime;
+		m_Snapshot = m_PreviousSnapshot;
+	}
+
+	void InputRecorder::RecordSnapshot(const InputSnapshot &snapshot)
+	{
+		m_Snapshot = snapshot;
+	}
+
+	void InputRecorder::RecordEvent(const Event &event)
+	{
+		size_t eventStart = m_Events.size();
+		WriteValue(m_Events, (uint8_t)event.GetEventType());
+
+		switch (event.GetEventType())
+		{
+		case EventType::WindowClose:
+			break;
+		case EventType::WindowResize:
+		{
+			auto &e = static_cast<const WindowResizeEvent &>(event);
+			WriteValue(m_Events, (uint32_t)e.GetWidth());
+			WriteValue(m_Events, (uint32_t)e.GetHeight());
+			break;
+		}
+		case EventType::KeyPressed:
+		{
+			auto &e = static_cast<const KeyPressedEvent &>(event);
+			WriteValue(m_Events, (uint16_t)e.GetKeyCode());
+			WriteValue(m_Events, (uint16_t)e.GetRepeatCount());
+			break;
+		}
+		case EventType::KeyReleased:
+		case EventType::KeyTyped:
+			WriteValue(m_Events, (uint16_t) static_cast<const KeyEvent &>(event).GetKeyCode());
+			break;
+		case EventType::MouseButtonPressed:
+		case EventType::MouseButtonReleased:
+			WriteValue(m_Events, (uint16_t) static_cast<const MouseButtonEvent &>(event).GetMouseButton());
+			break;
+		case EventType::MouseMoved:
+		{
+			auto &e = static_cast<const MouseMovedEvent &>(event);
+			WriteValue(m_Events, e.GetX());
+			WriteValue(m_Events, e.GetY());
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			auto &e = static_cast<const MouseScrolledEvent &>(event);
+			WriteValue(m_Events, e.GetXOffset());
+			WriteValue(m_Events, e.GetYOffset());
+			break;
+		}
+		default:
+			m_Events.resize(eventStart);
+			return;
+		}
+
+		m_EventCount++;
+	}
+
+	void InputRecorder::WriteFrame()
+	{
+		if (!m_FrameStarted)
+		{
+			return;
+		}
+
+		uint8_t flags = 0;
+		if (m_Snapshot.Keys != m_PreviousSnapshot.Keys)
+		{
+			flags |= KeysChanged;
+		}
+		if (m_Snapshot.MouseButtons != m_PreviousSnapshot.MouseButtons)
+		{
+			flags |= MouseButtonsChanged;
+		}
+		if (m_Snapshot.MousePosition != m_PreviousSnapshot.MousePosition)
+		{
+			flags |= MousePositionChanged;
+		}
+
+		WriteValue(m_Stream, m_FrameTime);
+		WriteValue(m_Stream, flags);
+		if (flags & KeysChanged)
+		{
+			WriteBits(m_Stream, m_Snapshot.Keys);
+		}
+		if (flags & MouseButtonsChanged)
+		{
+			WriteBits(m_Stream, m_Snapshot.MouseButtons);
+		}
+		if (flags & MousePositionChanged)
+		{
+			WriteValue(m_Stream, m_Snapshot.MousePosition.x);
+			WriteValue(m_Stream, m_Snapshot.MousePosition.y);
+		}
+
+		WriteValue(m_Stream, m_EventCount);
+		WriteValue(m_Stream, (uint32_t)m_Events.size());
+		m_Stream.write(reinterpret_cast<const char *>(m_Events.data()), m_Events.size());
+
+		m_PreviousSnapshot = m_Snapshot;
+		m_Events.clear();
+		m_EventCount = 0;
+		m_FrameStarted = false;
+		m_FrameCount++;
+	}
+
+	bool InputPlayer::Open(const std::string &filepath)
+	{
+		m_Stream.open(filepath, std::ios::binary);
+		if (!m_Stream)
+		{
+			AK_CORE_ERROR("Could not open the input recording '{0}'", filepath);
+			return false;
+		}
+
+		char magic[4];
+		uint32_t version = 0;
+		if (!m_Stream.read(magic, sizeof(magic)) || std::memcmp(magic, s_Magic, sizeof(magic)) != 0 || !ReadValue(m_Stream, version) || version != s_Version)
+		{
+			AK_CORE_ERROR("'{0}' isn't an input recording, or was written by another version", filepath);
+			m_Stream.close();
+			return false;
+		}
+
+		m_Snapshot = InputSnapshot();
+		m_ReplayedFrameCount = 0;
+		m_TotalTime = 0;
+		m_MaxFrameTime = 0;
+		return true;
+	}
+
+	bool InputPlayer::NextFrame()
+	{
+		uint8_t flags = 0;
+		if (!ReadValue(m_Stream, m_FrameTime) || !ReadValue(m_Stream, flags))
+		{
+			return false;
+		}
+
+		bool valid = true;
+		if (flags & KeysChanged)
+		{
+			valid &= ReadBits(m_Stream, m_Snapshot.Keys);
+		}
+		if (flags & MouseButtonsChanged)
+		{
+			valid &= ReadBits(m_Stream, m_Snapshot.MouseButtons);
+		}
+		if (flags & MousePositionChanged)
+		{
+			valid &= ReadValue(m_Stream, m_Snapshot.MousePosition.x) && ReadValue(m_Stream, m_Snapshot.MousePosition.y);
+		}
+
+		uint32_t eventsSize = 0;
+		valid &= ReadValue(m_Stream, m_EventCount) && ReadValue(m_Stream, eventsSize);
+		if (valid)
+		{
+			m_Events.resize(eventsSize);
+			valid = (bool)m_Stream.read(reinterpret_cast<char *>(m_Events.data()), eventsSize);
+		}
+
+		if (!valid)
+		{
+			AK_CORE_WARN("The input recording ends with an incomplete frame");
+		}
+		return valid;
+	}
+
+	void InputPlayer::DispatchEvents(const std::function<void(Event &)> &eventCallback) const
+	{
+		// The replayed events are received now
+		auto callback = [&eventCallback](Event &e)
+		{
+			e.Timestamp = Timer::Now();
+			eventCallback(e);
+		};
+
+		size_t offset = 0;
+		for (uint16_t i = 0; i < m_EventCount; i++)
+		{
+			EventType type = (EventType)ReadValue<uint8_t>(m_Events, offset);
+			switch (type)
+			{
+			case EventType::WindowClose:
+			{
+				WindowCloseEvent e;
+				callback(e);
+				break;
+			}
+			case EventType::WindowResize:
+			{
+				uint32_t width = ReadValue<uint32_t>(m_Events, offset);
+				uint32_t height = ReadValue<uint32_t>(m_Events, offset);
+				WindowResizeEvent e(width, height);
+				callback(e);
+				break;
+			}
+			case EventType::KeyPressed:
+			{
+				KeyCode key = ReadValue<uint16_t>(m_Events, offset);
+				uint16_t repeatCount = ReadValue<uint16_t>(m_Events, offset);
+				KeyPressedEvent e(key, repeatCount);
+				callback(e);
+				break;
+			}
+			case EventType::KeyReleased:
+			{
+				KeyReleasedEvent e(ReadValue<uint16_t>(m_Events, offset));
+				callback(e);
+				break;
+			}
+			case EventType::KeyTyped:
+			{
+				KeyTypedEvent e(ReadValue<uint16_t>(m_Events, offset));
+				callback(e);
+				break;
+			}
+			case EventType::MouseButtonPressed:
+			{
+				MouseButtonPressedEvent e(ReadValue<uint16_t>(m_Events, offset));
+				callback(e);
+				break;
+			}
+			case EventType::MouseButtonReleased:
+			{
+				MouseButtonReleasedEvent e(ReadValue<uint16_t>(m_Events, offset));
+				callback(e);
+				break;
+			}
+			case EventType::MouseMoved:
+			{
+				float x = ReadValue<float>(m_Events, offset);
+				float y = ReadValue<float>(m_Events, offset);
+				MouseMovedEvent e(x, y);
+				callback(e);
+				break;
+			}
+			case EventType::MouseScrolled:
+			{
+				float xOffset = ReadValue<float>(m_Events, offset);
+				float yOffset = ReadValue<float>(m_Events, offset);
+				MouseScrolledEvent e(xOffset, yOffset);
+				callback(e);
+				break;
+			}
+			default:
+				// The size of an unknown event isn't known, the rest of the frame can't be read
+				AK_CORE_WARN("Unknown event in the input recording");
+				return;
+			}
+		}
+	}
+
+	void InputPlayer::OnFrameCompleted(int64_t frameTime)
+	{
+		m_ReplayedFrameCount++;
+		m_TotalTime += frameTime;
+		m_MaxFrameTime = std::max(m_MaxFrameTime, frameTime);
+	}
+
+	InputPlayer::Statistics InputPlayer::GetStats() const
+	{
+		Statistics stats;
+		stats.FrameCount = m_ReplayedFrameCount;
+		stats.TotalTime = m_TotalTime * 1e-6f;
+		stats.AverageFrameTime = m_ReplayedFrameCount > 0 ? stats.TotalTime / m_ReplayedFrameCount : 0.0f;
+		stats.MaxFrameTime = m_MaxFrameTime * 1e-6f;
+		return stats;
+	}
+
+}
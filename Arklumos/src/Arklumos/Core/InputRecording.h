@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Arklumos/Core/Input.h"
+#include "Arklumos/Events/Event.h"
+
+#include <fstream>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		Records what drives a session frame by frame, to replay it identically (see InputPlayer): the frame time, the input snapshot and the events of the window.
+		Given the same scene, a replay then runs the same updates with the same timesteps, which makes an interactive session usable as a benchmark.
+
+		Binary file: a header, then one record per frame. A record only stores the parts of the snapshot that changed since the previous frame.
+	*/
+	class InputRecorder
+	{
+	public:
+		~InputRecorder();
+
+		bool Open(const std::string &filepath);
+		// Writes the last frame and closes the file
+		void Close();
+
+		// Starts the record of a frame, which ends with the next call
+		void BeginFrame(int64_t frameTime);
+		void RecordSnapshot(const InputSnapshot &snapshot);
+		// The events that can't be recorded (the application events) are ignored
+		void RecordEvent(const Event &event);
+
+		uint32_t GetFrameCount() const { return m_FrameCount; }
+
+	private:
+		void WriteFrame();
+
+		std::ofstream m_Stream;
+		uint32_t m_FrameCount = 0;
+
+		// Frame being recorded
+		bool m_FrameStarted = false;
+		int64_t m_FrameTime = 0;
+		InputSnapshot m_Snapshot;
+		InputSnapshot m_PreviousSnapshot;
+		std::vector<uint8_t> m_Events;
+		uint16_t m_EventCount = 0;
+	};
+
+	/*
+		Replays a file written by InputRecorder. Each frame gives back the recorded frame time and snapshot, and the recorded events are dispatched in place of the events of the window.
+		Also measures the real duration of the frames it replays, for the benchmarks.
+	*/
+	class InputPlayer
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t FrameCount = 0;
+			// Real durations, in milliseconds
+			float TotalTime = 0.0f;
+			float AverageFrameTime = 0.0f;
+			float MaxFrameTime = 0.0f;
+		};
+
+		bool Open(const std::string &filepath);
+
+		// Reads the next frame, false at the end of the recording
+		bool NextFrame();
+
+		int64_t GetFrameTime() const { return m_FrameTime; }
+		const InputSnapshot &GetSnapshot() const { return m_Snapshot; }
+		void DispatchEvents(const std::function<void(Event &)> &callback) const;
+
+		// Real duration of the last frame, in nanoseconds
+		void OnFrameCompleted(int64_t frameTime);
+		Statistics GetStats() const;
+
+	private:
+		std::ifstream m_Stream;
+
+		int64_t m_FrameTime = 0;
+		InputSnapshot m_Snapshot;
+		std::vector<uint8_t> m_Events;
+		uint16_t m_EventCount = 0;
+
+		uint32_t m_ReplayedFrameCount = 0;
+		int64_t m_TotalTime = 0;
+		int64_t m_MaxFrameTime = 0;
+	};
+
+}
@@ -0,0 +1,409 @@
+#include "akpch.h"
+#include "Arklumos/Core/JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Arklumos
+{
+
+	struct Job
+	{
+		const char *Name = "Job";
+		std::function<void()> Function;
+
+		// ParallelFor ranges share the function of the loop instead of each holding a copy of it
+		const std::function<void(size_t, size_t)> *RangeFunction = nullptr;
+		size_t Begin = 0;
+		size_t End = 0;
+
+		JobCounter *Counter = nullptr;
+
+#if AK_TRACK_MEMORY
+		// The allocations of the job are attributed to the subsystem that submitted it
+		MemoryTag Tag = MemoryTracker::GetCurrentTag();
+#endif
+	};
+
+	// The deque of one thread of the pool, the owner works at the back and the thieves take from the front
+	struct JobQueue
+	{
+		std::mutex Mutex;
+		std::deque<Job> Jobs;
+	};
+
+	struct JobSystemData
+	{
+		// Until Init is called, every job runs right away on the calling thread
+		bool Initialized = false;
+		bool SingleThreaded = true;
+		std::thread::id MainThreadID;
+
+		std::vector<std::thread> Workers;
+		// Queues[0] is the main thread, Queues[i] the worker i - 1
+		std::vector<Scope<JobQueue>> Queues;
+
+		std::mutex MainThreadMutex;
+		std::deque<Job> MainThreadJobs;
+		std::atomic<uint32_t> MainThreadJobCount{0};
+
+		// Sleeping workers are woken up when jobs are queued, QueuedJobs counts the jobs in the deques (main thread jobs excluded)
+		std::mutex WakeMutex;
+		std::condition_variable WakeCondition;
+		std::atomic<uint32_t> QueuedJobs{0};
+		std::atomic<bool> Running{false};
+
+		// Threads that are not part of the pool spread their jobs over the deques
+		std::atomic<uint32_t> NextQueue{0};
+	};
+
+	static JobSystemData s_Data;
+
+	// Index of the deque of the calling thread, -1 for the threads that are not part of the pool
+	static thread_local int32_t s_ThreadIndex = -1;
+
+	static void ExecuteJob(Job &job)
+	{
+		{
+#if AK_PROFILE
+			InstrumentationTimer timer(job.Name);
+#endif
+#if AK_TRACK_MEMORY
+			MemoryTagScope memoryTagScope(job.Tag);
+#endif
+
+			if (job.RangeFunction)
+			{
+				(*job.RangeFunction)(job.Begin, job.End);
+			}
+			else
+			{
+				job.Function();
+			}
+		}
+
+		if (job.Counter)
+		{
+			job.Counter->Decrement();
+		}
+	}
+
+	static void PushJob(Job &&job)
+	{
+		uint32_t queueIndex = s_ThreadIndex >= 0 ? (uint32_t)s_ThreadIndex : s_Data.NextQueue.fetch_add(1, std::memory_order_relaxed) % (uint32_t)s_Data.Queues.size();
+
+		JobQueue &queue = *s_Data.Queues[queueIndex];
+		{
+			std::lock_guard lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(job));
+		}
+
+		/*
+			The counter is incremented before taking the wake mutex: a worker checks it under that mutex before sleeping,
+			so either it sees the new job or it is already waiting when notify_one is called.
+		*/
+		s_Data.QueuedJobs.fetch_add(1, std::memory_order_release);
+		{
+			std::lock_guard lock(s_Data.WakeMutex);
+		}
+		s_Data.WakeCondition.notify_one();
+	}
+
+	static void PushMainThreadJob(Job &&job)
+	{
+		std::lock_guard lock(s_Data.MainThreadMutex);
+		s_Data.MainThreadJobs.push_back(std::move(job));
+		s_Data.MainThreadJobCount.fetch_add(1, std::memory_order_release);
+	}
+
+	static bool PopMainThreadJob(Job &outJob)
+	{
+		if (s_Data.MainThreadJobCount.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		std::lock_guard lock(s_Data.MainThreadMutex);
+		if (s_Data.MainThreadJobs.empty())
+		{
+			return false;
+		}
+
+		outJob = std::move(s_Data.MainThreadJobs.front());
+		s_Data.MainThreadJobs.pop_front();
+		s_Data.MainThreadJobCount.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	static bool PopJob(JobQueue &queue, bool fromBack, Job &outJob)
+	{
+		std::lock_guard lock(queue.Mutex);
+		if (queue.Jobs.empty())
+		{
+			return false;
+		}
+
+		if (fromBack)
+		{
+			outJob = std::move(queue.Jobs.back());
+			queue.Jobs.pop_back();
+		}
+		else
+		{
+			outJob = std::move(queue.Jobs.front());
+			queue.Jobs.pop_front();
+		}
+
+		s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/*
+		Executes one pending job if there is one: the own deque of the thread first, then steals from the others.
+		The main thread jobs aren't executed here, only by ProcessMainThreadJobs: a main thread waiting in the middle of a pass (a ParallelFor of the scene)
+		must not run unrelated window work it never asked for.
+	*/
+	static bool TryExecuteJob()
+	{
+		Job job;
+
+		if (s_Data.QueuedJobs.load(std::memory_order_acquire) == 0)
+		{
+			return false;
+		}
+
+		uint32_t queueCount = (uint32_t)s_Data.Queues.size();
+		uint32_t start = s_ThreadIndex >= 0 ? (uint32_t)s_ThreadIndex : 0;
+		for (uint32_t i = 0; i < queueCount; i++)
+		{
+			uint32_t queueIndex = (start + i) % queueCount;
+			bool own = (int32_t)queueIndex == s_ThreadIndex;
+			if (PopJob(*s_Data.Queues[queueIndex], own, job))
+			{
+				ExecuteJob(job);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static void WorkerThread(uint32_t threadIndex)
+	{
+		s_ThreadIndex = (int32_t)threadIndex;
+
+		while (s_Data.Running.load(std::memory_order_acquire))
+		{
+			if (TryExecuteJob())
+			{
+				continue;
+			}
+
+			std::unique_lock lock(s_Data.WakeMutex);
+			s_Data.WakeCondition.wait(lock, []()
+																{ return !s_Data.Running.load(std::memory_order_acquire) || s_Data.QueuedJobs.load(std::memory_order_acquire) > 0; });
+		}
+	}
+
+	void JobSystem::Init(const JobSystemSpecification &specification)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_CORE_ASSERT(!s_Data.Initialized, "JobSystem already initialized!");
+
+		s_Data.MainThreadID = std::this_thread::get_id();
+		s_ThreadIndex = 0;
+
+		uint32_t workerCount = specification.WorkerCount;
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		// Without any worker there would be nobody to execute the jobs the main thread doesn't wait on
+		s_Data.SingleThreaded = specification.SingleThreaded || workerCount == 0;
+		s_Data.Initialized = true;
+
+		if (s_Data.SingleThreaded)
+		{
+			AK_CORE_INFO("JobSystem: single threaded");
+			return;
+		}
+
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+		{
+			s_Data.Queues.push_back(CreateScope<JobQueue>());
+		}
+
+		s_Data.Running = true;
+		for (uint32_t i = 1; i <= workerCount; i++)
+		{
+			s_Data.Workers.emplace_back(WorkerThread, i);
+		}
+
+		AK_CORE_INFO("JobSystem: {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (!s_Data.SingleThreaded)
+		{
+			{
+				std::lock_guard lock(s_Data.WakeMutex);
+				s_Data.Running = false;
+			}
+			s_Data.WakeCondition.notify_all();
+
+			for (auto &worker : s_Data.Workers)
+			{
+				worker.join();
+			}
+			s_Data.Workers.clear();
+		}
+
+		// Jobs that were submitted but never waited on are still executed, someone may own a counter on them
+		while (TryExecuteJob())
+		{
+		}
+		ProcessMainThreadJobs();
+
+		s_Data.Queues.clear();
+		s_Data.Initialized = false;
+		s_Data.SingleThreaded = true;
+	}
+
+	void JobSystem::Run(const char *name, std::function<void()> job, JobCounter *counter, JobAffinity affinity)
+	{
+		if (counter)
+		{
+			counter->Increment();
+		}
+
+		Job newJob;
+		newJob.Name = name;
+		newJob.Function = std::move(job);
+		newJob.Counter = counter;
+
+		if (affinity == JobAffinity::MainThread)
+		{
+			if (IsMainThread())
+			{
+				ExecuteJob(newJob);
+			}
+			else
+			{
+				PushMainThreadJob(std::move(newJob));
+			}
+			return;
+		}
+
+		if (s_Data.SingleThreaded)
+		{
+			ExecuteJob(newJob);
+			return;
+		}
+
+		PushJob(std::move(newJob));
+	}
+
+	void JobSystem::Wait(JobCounter &counter)
+	{
+		/*
+			A thread waiting on a counter whose jobs need the main thread (MainThread affinity) can only spin until ProcessMainThreadJobs executes them,
+			so the main thread itself must not wait on such a counter (see JobAffinity::MainThread).
+		*/
+		while (!counter.IsDone())
+		{
+			if (!TryExecuteJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::ParallelFor(const char *name, size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)> &function)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		grainSize = std::max<size_t>(grainSize, 1);
+
+		// The ranges are executed in order on the calling thread in single threaded mode, or when there is only one range
+		if (s_Data.SingleThreaded || count <= grainSize)
+		{
+			for (size_t begin = 0; begin < count; begin += grainSize)
+			{
+				Job job;
+				job.Name = name;
+				job.RangeFunction = &function;
+				job.Begin = begin;
+				job.End = std::min(begin + grainSize, count);
+				ExecuteJob(job);
+			}
+			return;
+		}
+
+		JobCounter counter;
+		size_t rangeCount = (count + grainSize - 1) / grainSize;
+		counter.Increment((uint32_t)rangeCount);
+
+		// The first range is kept for the calling thread, which would wait anyway
+		for (size_t begin = grainSize; begin < count; begin += grainSize)
+		{
+			Job job;
+			job.Name = name;
+			job.RangeFunction = &function;
+			job.Begin = begin;
+			job.End = std::min(begin + grainSize, count);
+			job.Counter = &counter;
+			PushJob(std::move(job));
+		}
+
+		Job first;
+		first.Name = name;
+		first.RangeFunction = &function;
+		first.Begin = 0;
+		first.End = grainSize;
+		first.Counter = &counter;
+		ExecuteJob(first);
+
+		Wait(counter);
+	}
+
+	void JobSystem::ProcessMainThreadJobs()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_CORE_ASSERT(IsMainThread(), "Main thread jobs can only be processed by the main thread!");
+
+		Job job;
+		while (PopMainThreadJob(job))
+		{
+			ExecuteJob(job);
+		}
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)s_Data.Workers.size();
+	}
+
+	bool JobSystem::IsSingleThreaded()
+	{
+		return s_Data.SingleThreaded;
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		// Before Init, the only thread using the JobSystem is considered to be the main thread
+		return !s_Data.Initialized || std::this_thread::get_id() == s_Data.MainThreadID;
+	}
+
+}
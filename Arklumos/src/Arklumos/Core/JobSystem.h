@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace Arklumos
+{
+
+	/*
+		Counts the jobs that are still pending for a group of jobs. It is incremented when a job is submitted with this counter and decremented when the job is done,
+		so waiting on it waits for every job that was attached to it. A job can depend on others simply by waiting on their counter.
+		The counter must outlive the jobs attached to it (in general, it lives on the stack of the function that waits on it).
+	*/
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter &) = delete;
+		JobCounter &operator=(const JobCounter &) = delete;
+
+		bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+		uint32_t GetPending() const { return m_Pending.load(std::memory_order_acquire); }
+
+		// Called by the JobSystem, can also be used to make a wait cover work that isn't a job (an upload done by another thread for example)
+		void Increment(uint32_t count = 1) { m_Pending.fetch_add(count, std::memory_order_relaxed); }
+		void Decrement() { m_Pending.fetch_sub(1, std::memory_order_acq_rel); }
+
+	private:
+		std::atomic<uint32_t> m_Pending{0};
+	};
+
+	enum class JobAffinity
+	{
+		// Any thread of the pool (including the main thread while it waits)
+		Any = 0,
+		/*
+			Only the main thread, for the jobs that touch the window or the other main thread APIs (GLFW, the file dialogs).
+			Not for graphics calls: with a render thread the context belongs to it, the jobs submit their GPU work with Renderer::Submit instead.
+		*/
+		MainThread
+	};
+
+	struct JobSystemSpecification
+	{
+		// Number of worker threads, 0 means one per hardware thread minus the main thread
+		uint32_t WorkerCount = 0;
+
+		// No worker thread at all, every job runs on the thread that submits it, right away and in submission order (for deterministic debugging)
+		bool SingleThreaded = false;
+	};
+
+	/*
+		Fixed pool of worker threads executing small jobs.
+
+		Each thread of the pool (the main thread is the thread 0) owns a deque of jobs: it pushes and pops its own jobs at the back (the most recent job, whose data is still in cache)
+		and when its deque is empty it steals the oldest job at the front of the deque of another thread, so the work spreads over the pool without a central queue.
+		Waiting on a counter doesn't block a thread: the waiting thread executes the pending jobs until the counter reaches 0, so jobs can submit jobs and wait on them.
+
+		Jobs with the MainThread affinity go in a separate queue that the main thread only executes when Application calls ProcessMainThreadJobs (once per frame),
+		never while it waits on a counter: the passes waiting on a ParallelFor don't run unrelated jobs in the middle of their work.
+
+		Each job is named, and measured with an InstrumentationTimer when profiling is enabled so it appears in the traces on the thread that executed it.
+	*/
+	class JobSystem
+	{
+	public:
+		static void Init(const JobSystemSpecification &specification = JobSystemSpecification());
+		static void Shutdown();
+
+		/*
+			Submits a job. The name must be a string that outlives the job (a string literal in general).
+			If a counter is given, it is incremented now and decremented once the job is done.
+		*/
+		static void Run(const char *name, std::function<void()> job, JobCounter *counter = nullptr, JobAffinity affinity = JobAffinity::Any);
+
+		// Executes pending jobs on the calling thread until the counter reaches 0 (the MainThread jobs aside)
+		static void Wait(JobCounter &counter);
+
+		/*
+			Calls function(begin, end) over [0, count) split in ranges of at most grainSize indices, in parallel, and returns once every range is done.
+			The ranges don't overlap, so the function can write to the elements of its range without synchronization.
+		*/
+		static void ParallelFor(const char *name, size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)> &function);
+
+		// Executes the jobs queued for the main thread, called by Application once per frame. The only place they run
+		static void ProcessMainThreadJobs();
+
+		static uint32_t GetWorkerCount();
+		static bool IsSingleThreaded();
+		static bool IsMainThread();
+	};
+
+}
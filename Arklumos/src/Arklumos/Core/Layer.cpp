@@ -13,4 +13,21 @@ namespace Arklumos
 	{
 	}
 
+	bool Layer::IsSubscribedTo(EventType type, int categoryFlags) const
+	{
+		return m_EventHandlers.IsEmpty() || m_EventHandlers.IsSubscribed(type, categoryFlags);
+	}
+
+	void Layer::DispatchEvent(Event &event)
+	{
+		if (m_EventHandlers.IsEmpty())
+		{
+			OnEvent(event);
+		}
+		else
+		{
+			m_EventHandlers.Dispatch(event);
+		}
+	}
+
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Arklumos/Core/Base.h"
 #include "Arklumos/Core/Timestep.h"
 #include "Arklumos/Events/Event.h"
+#include "Arklumos/Events/EventHandlerTable.h"
 
 namespace Arklumos
 {
@@ -16,13 +17,40 @@ namespace Arklumos
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 		virtual void OnUpdate(Timestep ts) {}
+		// Called at the fixed rate of the application (ApplicationSpecification::FixedUpdateRate), before OnUpdate, zero or more times per frame
+		virtual void OnFixedUpdate(Timestep ts) {}
 		virtual void OnImGuiRender() {}
+		// Receives every event, unless the layer subscribed handlers (see SubscribeEvent)
 		virtual void OnEvent(Event &event) {}
 
+		/*
+			Whether the events of this type reach the layer. The application only visits the layers interested in an event:
+			the ones that subscribed to its type or one of its categories, and the ones that didn't subscribe anything (they receive everything in OnEvent).
+		*/
+		bool IsSubscribedTo(EventType type, int categoryFlags) const;
+		// Runs the handlers subscribed to the event, or OnEvent when there are none
+		void DispatchEvent(Event &event);
+
 		const std::string &GetName() const { return m_DebugName; }
 
+	protected:
+		// Once a layer subscribed a handler, it only receives the events it subscribed to and OnEvent isn't called anymore
+		template <typename T, typename F>
+		void SubscribeEvent(const F &handler)
+		{
+			m_EventHandlers.Subscribe<T>(handler);
+		}
+
+		void SubscribeEventCategory(int categories, const EventHandlerTable::EventHandlerFn &handler)
+		{
+			m_EventHandlers.SubscribeCategory(categories, handler);
+		}
+
 	protected:
 		std::string m_DebugName;
+
+	private:
+		EventHandlerTable m_EventHandlers;
 	};
 
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #include "akpch.h"
 #include "Arklumos/Core/Log.h"
 
+#include <spdlog/async.h>
+#include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
+#include <condition_variable>
+#include <mutex>
+
 namespace Arklumos
 {
 
@@ -11,7 +16,62 @@ namespace Arklumos
 	Ref<spdlog::logger> Log::s_CoreLogger;
 	Ref<spdlog::logger> Log::s_ClientLogger;
 
-	void Log::Init()
+	/*
+		Queue and background thread of the async loggers. Owned here rather than by the spdlog registry, so Shutdown controls when the thread stops.
+		The queue is a ring buffer of QueueSize messages allocated once, logging a message copies it into a slot.
+	*/
+	static Ref<spdlog::details::thread_pool> s_ThreadPool;
+
+	/*
+		Sink of the flush markers (see Log::Flush), counts the markers written by the background thread.
+		The thread processes the queue in order, so once a marker is written, everything queued before it (the flush requests of the loggers included) is done.
+	*/
+	class FlushMarkerSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex>
+	{
+	public:
+		// Blocks until count markers were written
+		void Wait(uint64_t count)
+		{
+			std::unique_lock lock(m_Mutex);
+			m_Condition.wait(lock, [this, count]()
+											 { return m_Written >= count; });
+		}
+
+	protected:
+		virtual void sink_it_(const spdlog::details::log_msg &) override
+		{
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Written++;
+			}
+			m_Condition.notify_all();
+		}
+
+		virtual void flush_() override {}
+
+	private:
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		uint64_t m_Written = 0;
+	};
+
+	static Ref<FlushMarkerSink> s_FlushMarkerSink;
+	// Not registered with spdlog: only logs the markers, always waiting for room in the queue so a marker is never dropped
+	static Ref<spdlog::async_logger> s_FlushMarkerLogger;
+	static std::atomic<uint64_t> s_FlushMarkerCount = 0;
+
+	static Ref<spdlog::logger> CreateLogger(const std::string &name, const std::vector<spdlog::sink_ptr> &sinks, const LogSpecification &specification)
+	{
+		if (!s_ThreadPool)
+		{
+			return std::make_shared<spdlog::logger>(name, begin(sinks), end(sinks));
+		}
+
+		spdlog::async_overflow_policy policy = specification.Overflow == LogSpecification::OverflowPolicy::DropOldest ? spdlog::async_overflow_policy::overrun_oldest : spdlog::async_overflow_policy::block;
+		return std::make_shared<spdlog::async_logger>(name, begin(sinks), end(sinks), s_ThreadPool, policy);
+	}
+
+	void Log::Init(const LogSpecification &specification)
 	{
 		// Declares a vector of shared pointers to spdlog sinks
 		std::vector<spdlog::sink_ptr> logSinks;
@@ -39,9 +99,19 @@ namespace Arklumos
 		*/
 		logSinks[1]->set_pattern("[%T] [%l] %n: %v");
 
+		// A single background thread: the messages are written in the order they were queued
+		if (specification.Async)
+		{
+			s_ThreadPool = std::make_shared<spdlog::details::thread_pool>(specification.QueueSize, 1);
+
+			s_FlushMarkerSink = std::make_shared<FlushMarkerSink>();
+			s_FlushMarkerLogger = std::make_shared<spdlog::async_logger>("LogFlush", s_FlushMarkerSink, s_ThreadPool, spdlog::async_overflow_policy::block);
+			s_FlushMarkerLogger->set_level(spdlog::level::trace);
+		}
+
 		///
-		// Creates a new spdlog logger with the name "ARKLUMOS" and a range of sinks specified by begin(logSinks) and end(logSinks). The std::make_shared function is used to create a shared pointer to the logger
-		s_CoreLogger = std::make_shared<spdlog::logger>("ARKLUMOS", begin(logSinks), end(logSinks));
+		// Creates a new spdlog logger with the name "ARKLUMOS" writing to the sinks of logSinks, either directly or through the background thread (see CreateLogger)
+		s_CoreLogger = CreateLogger("ARKLUMOS", logSinks, specification);
 
 		// Registers the s_CoreLogger with spdlog, making it available for use in the program
 		spdlog::register_logger(s_CoreLogger);
@@ -49,12 +119,15 @@ namespace Arklumos
 		// Sets the logging level for the s_CoreLogger to trace, which is the lowest and most verbose logging level. This means that all log messages with a severity level of trace, debug, info, warn, error, and critical will be logged by the s_CoreLogger
 		s_CoreLogger->set_level(spdlog::level::trace);
 
-		// Sets the s_CoreLogger to flush the log buffer to the sinks immediately after logging messages with a severity level of trace. This ensures that log messages are immediately written to the console and log file, rather than being buffered and potentially lost in the event of a crash or unexpected program termination
-		s_CoreLogger->flush_on(spdlog::level::trace);
+		/*
+			Sets the s_CoreLogger to flush the sinks after the messages of FlushLevel and above.
+			Flushing after every message would write each trace to the file immediately, the less severe messages are written when the buffers of the sinks fill up or by the periodic flush below.
+		*/
+		s_CoreLogger->flush_on(specification.FlushLevel);
 
 		///
-		// Creates a new spdlog logger with the name "APP" and a range of sinks specified by begin(logSinks) and end(logSinks). The std::make_shared function is used to create a shared pointer to the logger
-		s_ClientLogger = std::make_shared<spdlog::logger>("APP", begin(logSinks), end(logSinks));
+		// Creates a new spdlog logger with the name "APP" writing to the same sinks
+		s_ClientLogger = CreateLogger("APP", logSinks, specification);
 
 		// Registers the s_ClientLogger with spdlog, making it available for use in the program
 		spdlog::register_logger(s_ClientLogger);
@@ -62,8 +135,60 @@ namespace Arklumos
 		// Sets the logging level for the s_ClientLogger to trace, which is the lowest and most verbose logging level. This means that all log messages with a severity level of trace, debug, info, warn, error, and critical will be logged by the s_ClientLogger
 		s_ClientLogger->set_level(spdlog::level::trace);
 
-		// Sets the s_ClientLogger to flush the log buffer to the sinks immediately after logging messages with a severity level of trace. This ensures that log messages are immediately written to the console and log file, rather than being buffered and potentially lost in the event of a crash or unexpected program termination
-		s_ClientLogger->flush_on(spdlog::level::trace);
+		// Sets the s_ClientLogger to flush the sinks after the messages of FlushLevel and above
+		s_ClientLogger->flush_on(specification.FlushLevel);
+
+		// Flushes the registered loggers periodically from a spdlog thread (for an async logger, the flush is queued after its messages)
+		if (specification.FlushInterval > 0)
+		{
+			spdlog::flush_every(std::chrono::seconds(specification.FlushInterval));
+		}
+	}
+
+	void Log::Shutdown()
+	{
+		if (s_ThreadPool && s_ThreadPool->overrun_counter() > 0)
+		{
+			AK_CORE_WARN("Log: {0} messages were dropped, the queue was full", s_ThreadPool->overrun_counter());
+		}
+
+		Flush();
+
+		// Stops the periodic flush and unregisters the loggers, then the thread pool joins its thread once the remaining messages are written
+		spdlog::shutdown();
+		s_FlushMarkerLogger.reset();
+		s_FlushMarkerSink.reset();
+		s_ThreadPool.reset();
+	}
+
+	void Log::Flush()
+	{
+		if (!s_CoreLogger)
+		{
+			return;
+		}
+
+		// Synchronous loggers flush their sinks right away. An async logger only queues the flush behind its pending messages
+		s_CoreLogger->flush();
+		s_ClientLogger->flush();
+
+		if (!s_ThreadPool)
+		{
+			return;
+		}
+
+		/*
+			A marker queued after the flush requests is written once they are done. The markers are counted rather than identified:
+			when as many markers as this one's number are written, one of them was queued after it was numbered, so after the flush requests above.
+		*/
+		uint64_t marker = ++s_FlushMarkerCount;
+		s_FlushMarkerLogger->info("");
+		s_FlushMarkerSink->Wait(marker);
+	}
+
+	size_t Log::GetDroppedMessageCount()
+	{
+		return s_ThreadPool ? s_ThreadPool->overrun_counter() : 0;
 	}
 
 }
\ No newline at end of file
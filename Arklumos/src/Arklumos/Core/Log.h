@@ -9,13 +9,63 @@
 
 #include <spdlog/fmt/ostr.h>
 
+/*
+	Compile time log level: the macros of the levels below it expand to nothing, their arguments aren't even evaluated.
+	The Dist builds strip the trace messages, define AK_LOG_ACTIVE_LEVEL to one of the levels below (in the build configuration) to strip more or less.
+*/
+#define AK_LOG_LEVEL_TRACE 0
+#define AK_LOG_LEVEL_INFO 2
+#define AK_LOG_LEVEL_WARN 3
+#define AK_LOG_LEVEL_ERROR 4
+
+#ifndef AK_LOG_ACTIVE_LEVEL
+#ifdef AK_DIST
+#define AK_LOG_ACTIVE_LEVEL AK_LOG_LEVEL_INFO
+#else
+#define AK_LOG_ACTIVE_LEVEL AK_LOG_LEVEL_TRACE
+#endif
+#endif
+
 namespace Arklumos
 {
 
+	struct LogSpecification
+	{
+		/*
+			The messages are formatted on the calling thread, then queued and written to the sinks by a background thread,
+			so logging doesn't wait for the console or the file. Disable it to write the messages immediately (when debugging a crash for example).
+		*/
+		bool Async = true;
+
+		// Messages the queue holds, preallocated at Init
+		size_t QueueSize = 8192;
+
+		// When the queue is full: Block waits for the background thread to make room, DropOldest overwrites the oldest queued message
+		enum class OverflowPolicy
+		{
+			Block = 0,
+			DropOldest
+		};
+		OverflowPolicy Overflow = OverflowPolicy::Block;
+
+		// The sinks are flushed after each message of this level or above, and every FlushInterval seconds (0 disables the timer)
+		spdlog::level::level_enum FlushLevel = spdlog::level::warn;
+		uint32_t FlushInterval = 1;
+	};
+
 	class Log
 	{
 	public:
-		static void Init();
+		static void Init(const LogSpecification &specification = LogSpecification());
+
+		// Writes the queued messages and stops the background thread, nothing must be logged after it
+		static void Shutdown();
+
+		// Waits for the queued messages to be written and flushes the sinks (before a debug break for example)
+		static void Flush();
+
+		// Messages overwritten because the queue was full (OverflowPolicy::DropOldest)
+		static size_t GetDroppedMessageCount();
 
 		/*
 			The functions GetCoreLogger() and GetClientLogger() are defined inline and return references to the static s_CoreLogger and s_ClientLogger shared pointers, respectively.
@@ -31,16 +81,40 @@ namespace Arklumos
 
 }
 
-// Core log macros
-#define AK_CORE_TRACE(...) ::Arklumos::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define AK_CORE_INFO(...) ::Arklumos::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define AK_CORE_WARN(...) ::Arklumos::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define AK_CORE_ERROR(...) ::Arklumos::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define AK_CORE_CRITICAL(...) ::Arklumos::Log::GetCoreLogger()->critical(__VA_ARGS__)
+// Core (AK_CORE_*) and client (AK_*) log macros, the critical messages are never stripped
+#define AK_LOG_DISCARD(...) ((void)0)
 
-// Client log macros
+#if AK_LOG_ACTIVE_LEVEL <= AK_LOG_LEVEL_TRACE
+#define AK_CORE_TRACE(...) ::Arklumos::Log::GetCoreLogger()->trace(__VA_ARGS__)
 #define AK_TRACE(...) ::Arklumos::Log::GetClientLogger()->trace(__VA_ARGS__)
+#else
+#define AK_CORE_TRACE(...) AK_LOG_DISCARD(__VA_ARGS__)
+#define AK_TRACE(...) AK_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AK_LOG_ACTIVE_LEVEL <= AK_LOG_LEVEL_INFO
+#define AK_CORE_INFO(...) ::Arklumos::Log::GetCoreLogger()->info(__VA_ARGS__)
 #define AK_INFO(...) ::Arklumos::Log::GetClientLogger()->info(__VA_ARGS__)
+#else
+#define AK_CORE_INFO(...) AK_LOG_DISCARD(__VA_ARGS__)
+#define AK_INFO(...) AK_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AK_LOG_ACTIVE_LEVEL <= AK_LOG_LEVEL_WARN
+#define AK_CORE_WARN(...) ::Arklumos::Log::GetCoreLogger()->warn(__VA_ARGS__)
 #define AK_WARN(...) ::Arklumos::Log::GetClientLogger()->warn(__VA_ARGS__)
+#else
+#define AK_CORE_WARN(...) AK_LOG_DISCARD(__VA_ARGS__)
+#define AK_WARN(...) AK_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if AK_LOG_ACTIVE_LEVEL <= AK_LOG_LEVEL_ERROR
+#define AK_CORE_ERROR(...) ::Arklumos::Log::GetCoreLogger()->error(__VA_ARGS__)
 #define AK_ERROR(...) ::Arklumos::Log::GetClientLogger()->error(__VA_ARGS__)
+#else
+#define AK_CORE_ERROR(...) AK_LOG_DISCARD(__VA_ARGS__)
+#define AK_ERROR(...) AK_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#define AK_CORE_CRITICAL(...) ::Arklumos::Log::GetCoreLogger()->critical(__VA_ARGS__)
 #define AK_CRITICAL(...) ::Arklumos::Log::GetClientLogger()->critical(__VA_ARGS__)
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "akpch.h"
+#include "Arklumos/Core/StringId.h"
+
+#include <mutex>
+
+namespace Arklumos
+{
+
+	struct StringIdData
+	{
+		std::mutex Mutex;
+		std::unordered_map<uint64_t, std::string> Strings;
+	};
+
+	// Constructed on first use: identifiers can be interned during the static initialization
+	static StringIdData &GetData()
+	{
+		static StringIdData data;
+		return data;
+	}
+
+#ifdef AK_DEBUG
+	StringId::StringId(const std::string &string)
+		: m_Hash(Register(string))
+	{
+	}
+
+	StringId::StringId(std::string_view string)
+		: m_Hash(Register(string))
+	{
+	}
+#else
+	StringId::StringId(const std::string &string)
+		: m_Hash(Hash(string.data(), string.size()))
+	{
+	}
+
+	StringId::StringId(std::string_view string)
+		: m_Hash(Hash(string.data(), string.size()))
+	{
+	}
+#endif
+
+	StringId StringId::Intern(std::string_view string)
+	{
+		StringId id;
+		id.m_Hash = Register(string);
+		return id;
+	}
+
+	uint64_t StringId::Register(std::string_view string)
+	{
+		uint64_t hash = Hash(string.data(), string.size());
+
+		StringIdData &data = GetData();
+		std::lock_guard lock(data.Mutex);
+		auto [it, inserted] = data.Strings.try_emplace(hash, string);
+		if (!inserted && it->second != string)
+		{
+			AK_CORE_ERROR("StringId: '{0}' and '{1}' have the same hash", it->second, string);
+			AK_CORE_ASSERT(false, "StringId collision!");
+		}
+		return hash;
+	}
+
+	const char *StringId::GetString() const
+	{
+		StringIdData &data = GetData();
+		std::lock_guard lock(data.Mutex);
+		auto it = data.Strings.find(m_Hash);
+		return it != data.Strings.end() ? it->second.c_str() : "<unknown>";
+	}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace Arklumos
+{
+
+	/*
+		Identifier made of the 64 bit FNV-1a hash of a string, compared and hashed as an integer.
+
+		A string literal is hashed at compile time (in a constexpr context, or by the optimizer otherwise):
+
+			static constexpr StringId s_ViewProjection = "u_ViewProjection";
+			shader->SetMat4("u_Transform", transform);
+
+		A runtime string is only hashed, building an identifier from a std::string doesn't lock or allocate anything.
+		StringId::Intern also keeps the string in a global table, so GetString can give it back (for the logs and the tools) and a collision between two different strings is detected:
+		it is meant for the names registered once (the shaders intern the names of their uniforms for example), not for the lookups.
+		The debug builds intern every runtime string, to detect the collisions. The literals aren't interned, GetString only knows them once the same string was interned.
+	*/
+	class StringId
+	{
+	public:
+		constexpr StringId() = default;
+
+		template <size_t N>
+		constexpr StringId(const char (&literal)[N])
+			: m_Hash(Hash(literal, Length(literal, N)))
+		{
+		}
+
+		StringId(const std::string &string);
+		explicit StringId(std::string_view string);
+
+		// Hashes the string and keeps it for GetString
+		static StringId Intern(std::string_view string);
+
+		static constexpr uint64_t Hash(const char *data, size_t size)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= (uint8_t)data[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		constexpr uint64_t GetHash() const { return m_Hash; }
+		constexpr bool IsValid() const { return m_Hash != 0; }
+
+		// The interned string, or "<unknown>" for an identifier whose string was never interned
+		const char *GetString() const;
+
+		constexpr bool operator==(const StringId &other) const { return m_Hash == other.m_Hash; }
+		constexpr bool operator!=(const StringId &other) const { return m_Hash != other.m_Hash; }
+		constexpr bool operator<(const StringId &other) const { return m_Hash < other.m_Hash; }
+
+	private:
+		// A char buffer can be bigger than the string it holds
+		static constexpr size_t Length(const char *data, size_t capacity)
+		{
+			size_t length = 0;
+			while (length < capacity && data[length] != '\0')
+			{
+				length++;
+			}
+			return length;
+		}
+
+		static uint64_t Register(std::string_view string);
+
+		uint64_t m_Hash = 0;
+	};
+
+}
+
+namespace std
+{
+
+	template <>
+	struct hash<Arklumos::StringId>
+	{
+		size_t operator()(const Arklumos::StringId &id) const
+		{
+			return (size_t)id.GetHash();
+		}
+	};
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Arklumos
+{
+
+	/*
+		Monotonic clock counting in nanoseconds (std::chrono::steady_clock is not affected by changes of the system time).
+		The elapsed time is an integer, so it doesn't lose precision however long the application runs, unlike a float holding the time since the start.
+	*/
+	class Timer
+	{
+	public:
+		Timer()
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			m_Start = std::chrono::steady_clock::now();
+		}
+
+		// Nanoseconds since the construction or the last Reset
+		int64_t ElapsedNanoseconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start).count();
+		}
+
+		// Seconds since the construction or the last Reset
+		double Elapsed() const
+		{
+			return ElapsedNanoseconds() * 1e-9;
+		}
+
+		double ElapsedMillis() const
+		{
+			return ElapsedNanoseconds() * 1e-6;
+		}
+
+		// Nanoseconds of the monotonic clock, from an unspecified origin: only the differences between two values are meaningful
+		static int64_t Now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+	private:
+		std::chrono::steady_clock::time_point m_Start;
+	};
+
+}
@@ -8,16 +8,22 @@
 namespace Arklumos
 {
 
+	class GraphicsContext;
+	class EventQueue;
+
 	struct WindowProps
 	{
 		std::string Title;
 		uint32_t Width;
 		uint32_t Height;
+		// A hidden window still has its graphics context, the frames are rendered but never shown
+		bool Visible;
 
 		WindowProps(const std::string &title = "Arklumos Game Engine",
 								uint32_t width = 1920,
-								uint32_t height = 1080)
-				: Title(title), Width(width), Height(height)
+								uint32_t height = 1080,
+								bool visible = true)
+				: Title(title), Width(width), Height(height), Visible(visible)
 		{
 		}
 	};
@@ -30,17 +36,29 @@ namespace Arklumos
 
 		virtual ~Window() {}
 
+		// Processes the pending events, then presents the frame
 		virtual void OnUpdate() = 0;
 
+		// Processes the pending events only, main thread only (as all the event processing)
+		virtual void PollEvents() = 0;
+
+		// Blocks until an event arrives or the timeout (in seconds) expires, then dispatches the events like OnUpdate does
+		virtual void WaitEvents(double timeout) = 0;
+		// Wakes up a thread blocked in WaitEvents, can be called from any thread
+		virtual void PostEmptyEvent() = 0;
+
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 
 		// Window attributes
 		virtual void SetEventCallback(const EventCallbackFn &callback) = 0;
+		// When set, the events are posted to the queue instead of being passed to the callback
+		virtual void SetEventQueue(EventQueue *queue) = 0;
 		virtual void SetVSync(bool enabled) = 0;
 		virtual bool IsVSync() const = 0;
 
 		virtual void *GetNativeWindow() const = 0;
+		virtual GraphicsContext *GetGraphicsContext() const = 0;
 
 		static Scope<Window> Create(const WindowProps &props = WindowProps());
 	};
@@ -18,7 +18,8 @@ namespace Arklumos
 
 	struct ProfileResult
 	{
-		std::string Name;
+		// Written to the session before the scope ends, so the name doesn't have to be copied
+		const char *Name;
 
 		FloatingPointMicroseconds Start;
 		std::chrono::microseconds ElapsedTime;
@@ -96,6 +97,30 @@ namespace Arklumos
 			}
 		}
 
+		// Counter event, shown as a graph over time by the trace viewers
+		void WriteCounter(const char *name, int64_t value)
+		{
+			auto timestamp = FloatingPointMicroseconds{std::chrono::steady_clock::now().time_since_epoch()};
+
+			std::stringstream json;
+			json << std::setprecision(3) << std::fixed;
+			json << ",{";
+			json << "\"cat\":\"counter\",";
+			json << "\"name\":\"" << name << "\",";
+			json << "\"ph\":\"C\",";
+			json << "\"pid\":0,";
+			json << "\"ts\":" << timestamp.count() << ",";
+			json << "\"args\":{\"value\":" << value << "}";
+			json << "}";
+
+			std::lock_guard lock(m_Mutex);
+			if (m_CurrentSession)
+			{
+				m_OutputStream << json.str();
+				m_OutputStream.flush();
+			}
+		}
+
 		static Instrumentor &Get()
 		{
 			static Instrumentor instance;
@@ -270,9 +295,11 @@ namespace Arklumos
 #define AK_PROFILE_SCOPE_LINE(name, line) AK_PROFILE_SCOPE_LINE2(name, line)
 #define AK_PROFILE_SCOPE(name) AK_PROFILE_SCOPE_LINE(name, __LINE__)
 #define AK_PROFILE_FUNCTION() AK_PROFILE_SCOPE(AK_FUNC_SIG)
+#define AK_PROFILE_COUNTER(name, value) ::Arklumos::Instrumentor::Get().WriteCounter(name, value)
 #else
 #define AK_PROFILE_BEGIN_SESSION(name, filepath)
 #define AK_PROFILE_END_SESSION()
 #define AK_PROFILE_SCOPE(name)
 #define AK_PROFILE_FUNCTION()
+#define AK_PROFILE_COUNTER(name, value)
 #endif
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "akpch.h"
+#include "Arklumos/Debug/MemoryTracker.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+namespace Arklumos
+{
+
+	/*
+		Everything here is constant initialized: operator new can be called during the static initialization, before any constructor of this file would have run.
+		For the same reason, nothing here allocates.
+	*/
+	struct TagCounters
+	{
+		std::atomic<int64_t> LiveBytes{0};
+		std::atomic<int64_t> PeakBytes{0};
+		std::atomic<uint64_t> AllocationCount{0};
+	};
+
+	static TagCounters s_TagCounters[(size_t)MemoryTag::Count];
+	static std::atomic<int64_t> s_GPUMemory[(size_t)GPUMemoryType::Count];
+	static thread_local MemoryTag t_CurrentTag = MemoryTag::Unknown;
+
+	// Main thread, see Update
+	static uint64_t s_PreviousAllocationCounts[(size_t)MemoryTag::Count];
+	static float s_AllocationRates[(size_t)MemoryTag::Count];
+	static std::chrono::steady_clock::time_point s_PreviousUpdateTime;
+
+	static const char *s_TagNames[] = {"Unknown", "Core", "Renderer", "Scene", "ImGui", "Events", "FrameAllocator"};
+	static const char *s_TagCounterNames[] = {"Memory Unknown", "Memory Core", "Memory Renderer", "Memory Scene", "Memory ImGui", "Memory Events", "Memory FrameAllocator"};
+	static const char *s_GPUMemoryTypeNames[] = {"Buffers", "Textures", "Framebuffers"};
+	static const char *s_GPUCounterNames[] = {"GPU Memory Buffers", "GPU Memory Textures", "GPU Memory Framebuffers"};
+	static_assert(sizeof(s_TagNames) / sizeof(s_TagNames[0]) == (size_t)MemoryTag::Count, "A memory tag has no name!");
+	static_assert(sizeof(s_GPUMemoryTypeNames) / sizeof(s_GPUMemoryTypeNames[0]) == (size_t)GPUMemoryType::Count, "A GPU memory type has no name!");
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return t_CurrentTag;
+	}
+
+	void MemoryTracker::SetCurrentTag(MemoryTag tag)
+	{
+		t_CurrentTag = tag;
+	}
+
+	const char *MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		return s_TagNames[(size_t)tag];
+	}
+
+	void MemoryTracker::OnAllocation(MemoryTag tag, size_t size)
+	{
+		TagCounters &counters = s_TagCounters[(size_t)tag];
+		int64_t live = counters.LiveBytes.fetch_add((int64_t)size, std::memory_order_relaxed) + (int64_t)size;
+		counters.AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+		int64_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !counters.PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void MemoryTracker::OnDeallocation(MemoryTag tag, size_t size)
+	{
+		s_TagCounters[(size_t)tag].LiveBytes.fetch_sub((int64_t)size, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::OnGPUAllocation(GPUMemoryType type, int64_t bytes)
+	{
+		s_GPUMemory[(size_t)type].fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	int64_t MemoryTracker::GetGPUMemory(GPUMemoryType type)
+	{
+		return s_GPUMemory[(size_t)type].load(std::memory_order_relaxed);
+	}
+
+	const char *MemoryTracker::GetGPUMemoryTypeName(GPUMemoryType type)
+	{
+		return s_GPUMemoryTypeNames[(size_t)type];
+	}
+
+	void MemoryTracker::Update()
+	{
+		for (size_t i = 0; i < (size_t)GPUMemoryType::Count; i++)
+		{
+			AK_PROFILE_COUNTER(s_GPUCounterNames[i], s_GPUMemory[i].load(std::memory_order_relaxed));
+		}
+
+		if constexpr (!IsEnabled())
+		{
+			return;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		float elapsed = std::chrono::duration<float>(now - s_PreviousUpdateTime).count();
+		s_PreviousUpdateTime = now;
+
+		for (size_t i = 0; i < (size_t)MemoryTag::Count; i++)
+		{
+			uint64_t count = s_TagCounters[i].AllocationCount.load(std::memory_order_relaxed);
+			s_AllocationRates[i] = elapsed > 0.0f ? (count - s_PreviousAllocationCounts[i]) / elapsed : 0.0f;
+			s_PreviousAllocationCounts[i] = count;
+
+			AK_PROFILE_COUNTER(s_TagCounterNames[i], s_TagCounters[i].LiveBytes.load(std::memory_order_relaxed));
+		}
+	}
+
+	MemoryTracker::TagStatistics MemoryTracker::GetTagStats(MemoryTag tag)
+	{
+		const TagCounters &counters = s_TagCounters[(size_t)tag];
+
+		TagStatistics stats;
+		stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+		stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+		stats.AllocationCount = counters.AllocationCount.load(std::memory_order_relaxed);
+		stats.AllocationRate = s_AllocationRates[(size_t)tag];
+		return stats;
+	}
+
+}
+
+#if AK_TRACK_MEMORY
+
+namespace
+{
+
+	/*
+		Stored right before the memory returned to the caller. Offset is the distance from the block returned by malloc, which differs from the header size for the over aligned allocations.
+		The header is 16 bytes, so the memory after it keeps the alignment of malloc.
+	*/
+	struct AllocationHeader
+	{
+		size_t Size;
+		uint32_t Offset;
+		Arklumos::MemoryTag Tag;
+	};
+	static_assert(sizeof(AllocationHeader) <= 16, "The header must keep the alignment of malloc!");
+
+	constexpr size_t s_HeaderSize = 16;
+	constexpr size_t s_DefaultAlignment = alignof(std::max_align_t);
+
+	void *TrackedAllocate(size_t size, size_t alignment, Arklumos::MemoryTag tag = Arklumos::MemoryTracker::GetCurrentTag())
+	{
+		alignment = alignment > s_DefaultAlignment ? alignment : s_DefaultAlignment;
+		size_t padding = alignment > s_DefaultAlignment ? alignment : 0;
+
+		uint8_t *block = static_cast<uint8_t *>(std::malloc(size + s_HeaderSize + padding));
+		if (!block)
+		{
+			return nullptr;
+		}
+
+		uintptr_t address = ((uintptr_t)block + s_HeaderSize + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		uint8_t *memory = reinterpret_cast<uint8_t *>(address);
+
+		AllocationHeader *header = reinterpret_cast<AllocationHeader *>(memory - s_HeaderSize);
+		header->Size = size;
+		header->Offset = (uint32_t)(memory - block);
+		header->Tag = tag;
+
+		Arklumos::MemoryTracker::OnAllocation(header->Tag, size);
+		return memory;
+	}
+
+	void *TrackedAllocateOrThrow(size_t size, size_t alignment)
+	{
+		void *memory = TrackedAllocate(size, alignment);
+		if (!memory)
+		{
+			throw std::bad_alloc();
+		}
+		return memory;
+	}
+
+	void TrackedFree(void *memory)
+	{
+		if (!memory)
+		{
+			return;
+		}
+
+		AllocationHeader *header = reinterpret_cast<AllocationHeader *>(static_cast<uint8_t *>(memory) - s_HeaderSize);
+		Arklumos::MemoryTracker::OnDeallocation(header->Tag, header->Size);
+		std::free(static_cast<uint8_t *>(memory) - header->Offset);
+	}
+
+}
+
+namespace Arklumos
+{
+
+	void *MemoryTracker::Allocate(MemoryTag tag, size_t size)
+	{
+		return TrackedAllocate(size, s_DefaultAlignment, tag);
+	}
+
+	void MemoryTracker::Free(void *memory)
+	{
+		TrackedFree(memory);
+	}
+
+}
+
+void *operator new(size_t size) { return TrackedAllocateOrThrow(size, s_DefaultAlignment); }
+void *operator new[](size_t size) { return TrackedAllocateOrThrow(size, s_DefaultAlignment); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return TrackedAllocate(size, s_DefaultAlignment); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return TrackedAllocate(size, s_DefaultAlignment); }
+void *operator new(size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, (size_t)alignment); }
+void *operator new[](size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, (size_t)alignment); }
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return TrackedAllocate(size, (size_t)alignment); }
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return TrackedAllocate(size, (size_t)alignment); }
+
+void operator delete(void *memory) noexcept { TrackedFree(memory); }
+void operator delete[](void *memory) noexcept { TrackedFree(memory); }
+void operator delete(void *memory, size_t) noexcept { TrackedFree(memory); }
+void operator delete[](void *memory, size_t) noexcept { TrackedFree(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept { TrackedFree(memory); }
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { TrackedFree(memory); }
+void operator delete(void *memory, std::align_val_t) noexcept { TrackedFree(memory); }
+void operator delete[](void *memory, std::align_val_t) noexcept { TrackedFree(memory); }
+void operator delete(void *memory, size_t, std::align_val_t) noexcept { TrackedFree(memory); }
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept { TrackedFree(memory); }
+void operator delete(void *memory, std::align_val_t, const std::nothrow_t &) noexcept { TrackedFree(memory); }
+void operator delete[](void *memory, std::align_val_t, const std::nothrow_t &) noexcept { TrackedFree(memory); }
+
+#else
+
+namespace Arklumos
+{
+
+	void *MemoryTracker::Allocate(MemoryTag, size_t size)
+	{
+		return std::malloc(size);
+	}
+
+	void MemoryTracker::Free(void *memory)
+	{
+		std::free(memory);
+	}
+
+}
+
+#endif
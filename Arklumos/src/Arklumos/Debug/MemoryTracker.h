@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+	Memory tracking, disabled by default: replacing the global operator new adds a header and a few atomic operations to every allocation.
+	Define AK_TRACK_MEMORY to 1 (in the build configuration, or here) to enable it.
+*/
+#ifndef AK_TRACK_MEMORY
+#define AK_TRACK_MEMORY 0
+#endif
+
+namespace Arklumos
+{
+
+	// Subsystem an allocation is attributed to
+	enum class MemoryTag : uint8_t
+	{
+		// Allocations made outside of any tagged scope (the application code, the static initialization, ...)
+		Unknown = 0,
+		Core,
+		Renderer,
+		Scene,
+		ImGui,
+		Events,
+		FrameAllocator,
+		Count
+	};
+
+	// Memory owned by the GPU driver, declared by the rendering resources when they are created and destroyed
+	enum class GPUMemoryType : uint8_t
+	{
+		Buffers = 0,
+		Textures,
+		Framebuffers,
+		Count
+	};
+
+	/*
+		Accounts for the memory of the engine per subsystem.
+
+		When AK_TRACK_MEMORY is enabled, the global operator new and delete are replaced: each allocation stores its size and its tag in a small header,
+		and the live bytes, peak and number of allocations of its tag are updated. The tag is the innermost MemoryTagScope of the thread
+		(the jobs inherit the tag of the thread that submitted them), so a subsystem only has to tag its entry points.
+
+		The GPU memory isn't allocated with new, the resources report their size themselves (AK_TRACK_GPU_MEMORY), whether AK_TRACK_MEMORY is enabled or not.
+	*/
+	class MemoryTracker
+	{
+	public:
+		struct TagStatistics
+		{
+			int64_t LiveBytes = 0;
+			int64_t PeakBytes = 0;
+			uint64_t AllocationCount = 0;
+			// Allocations per second, measured between the last two calls to Update
+			float AllocationRate = 0.0f;
+		};
+
+		static constexpr bool IsEnabled() { return AK_TRACK_MEMORY != 0; }
+
+		static MemoryTag GetCurrentTag();
+		static void SetCurrentTag(MemoryTag tag);
+		static const char *GetTagName(MemoryTag tag);
+
+		static void OnAllocation(MemoryTag tag, size_t size);
+		static void OnDeallocation(MemoryTag tag, size_t size);
+
+		/*
+			malloc/free for the libraries that don't allocate with operator new (ImGui, see ImGuiLayer::OnAttach): the memory is attributed to the given tag.
+			Memory from Allocate must be released with Free. Without AK_TRACK_MEMORY, they are malloc and free.
+		*/
+		static void *Allocate(MemoryTag tag, size_t size);
+		static void Free(void *memory);
+
+		// bytes is negative when a resource is released
+		static void OnGPUAllocation(GPUMemoryType type, int64_t bytes);
+		static int64_t GetGPUMemory(GPUMemoryType type);
+		static const char *GetGPUMemoryTypeName(GPUMemoryType type);
+
+		// Called once per frame by Application: computes the allocation rates and writes the counters to the profiling session
+		static void Update();
+
+		static TagStatistics GetTagStats(MemoryTag tag);
+	};
+
+	// Attributes the allocations of the calling thread to a tag until the end of the scope
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag tag)
+			: m_PreviousTag(MemoryTracker::GetCurrentTag())
+		{
+			MemoryTracker::SetCurrentTag(tag);
+		}
+
+		~MemoryTagScope()
+		{
+			MemoryTracker::SetCurrentTag(m_PreviousTag);
+		}
+
+		MemoryTagScope(const MemoryTagScope &) = delete;
+		MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+
+	private:
+		MemoryTag m_PreviousTag;
+	};
+
+}
+
+#if AK_TRACK_MEMORY
+#define AK_MEMORY_TAG_LINE2(tag, line) ::Arklumos::MemoryTagScope memoryTagScope##line(::Arklumos::MemoryTag::tag)
+#define AK_MEMORY_TAG_LINE(tag, line) AK_MEMORY_TAG_LINE2(tag, line)
+#define AK_MEMORY_TAG(tag) AK_MEMORY_TAG_LINE(tag, __LINE__)
+#else
+#define AK_MEMORY_TAG(tag)
+#endif
+
+// Always tracked: the resources are created rarely enough for the cost not to matter
+#define AK_TRACK_GPU_MEMORY(type, bytes) ::Arklumos::MemoryTracker::OnGPUAllocation(::Arklumos::GPUMemoryType::type, (int64_t)(bytes))
@@ -8,8 +8,8 @@
 namespace Arklumos
 {
 
-	// The events in Arklumos are currently blocking, meaning when an event occurs it
-	// immediately gets dispatched and must be dealt with right then an there.
+	// The events of the window are queued when they occur (see EventQueue), and the application dispatches them
+	// all at once, at a fixed point of its frame. A dispatched event must be dealt with right then and there.
 
 	// Enum to store all event type we will need (1 -> 14)
 	enum class EventType
@@ -32,6 +32,9 @@ namespace Arklumos
 		MouseScrolled
 	};
 
+	// Number of event types, for the tables indexed by EventType
+	constexpr size_t EventTypeCount = (size_t)EventType::MouseScrolled + 1;
+
 	enum EventCategory
 	{
 		None = 0,
@@ -71,6 +74,8 @@ namespace Arklumos
 		virtual ~Event() = default;
 
 		bool Handled = false;
+		// When the event was received, in nanoseconds of Timer::Now() (0 for an event that wasn't stamped)
+		int64_t Timestamp = 0;
 
 		// When it's virtual, require implementation later ;)
 		virtual EventType GetEventType() const = 0;
@@ -0,0 +1,74 @@
+#include "akpch.h"
+#include "Arklumos/Events/EventHandlerTable.h"
+
+namespace Arklumos
+{
+
+	uint32_t EventHandlerTable::s_Generation = 0;
+
+	void EventHandlerTable::SubscribeCategory(int categories, const EventHandlerFn &handler)
+	{
+		m_CategoryHandlers.push_back({categories, handler});
+		m_HandlerCount++;
+		s_Generation++;
+	}
+
+	void EventHandlerTable::Clear()
+	{
+		for (auto &handlers : m_TypeHandlers)
+		{
+			handlers.clear();
+		}
+		m_CategoryHandlers.clear();
+		m_HandlerCount = 0;
+		s_Generation++;
+	}
+
+	bool EventHandlerTable::IsSubscribed(EventType type, int categoryFlags) const
+	{
+		if (!m_TypeHandlers[(size_t)type].empty())
+		{
+			return true;
+		}
+
+		for (const CategoryHandler &categoryHandler : m_CategoryHandlers)
+		{
+			if (categoryHandler.Categories & categoryFlags)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void EventHandlerTable::Dispatch(Event &e) const
+	{
+		for (const EventHandlerFn &handler : m_TypeHandlers[(size_t)e.GetEventType()])
+		{
+			if (e.Handled)
+			{
+				return;
+			}
+			e.Handled |= handler(e);
+		}
+
+		if (m_CategoryHandlers.empty())
+		{
+			return;
+		}
+
+		int categoryFlags = e.GetCategoryFlags();
+		for (const CategoryHandler &categoryHandler : m_CategoryHandlers)
+		{
+			if (e.Handled)
+			{
+				return;
+			}
+			if (categoryHandler.Categories & categoryFlags)
+			{
+				e.Handled |= categoryHandler.Handler(e);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Arklumos/Events/Event.h"
+
+#include <array>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		Handlers registered per event type, in a flat table indexed by EventType.
+		Dispatching an event only runs the handlers of its type (and of its categories), in registration order, until one of them handles it.
+		The handler of a type receives the event already cast to its class: the table replaces the chain of EventDispatcher::Dispatch calls,
+		each comparing the type of the event through a virtual call.
+
+			table.Subscribe<KeyPressedEvent>(AK_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
+			table.SubscribeCategory(EventCategoryMouse, [](Event &e) { ... });
+	*/
+	class EventHandlerTable
+	{
+	public:
+		using EventHandlerFn = std::function<bool(Event &)>;
+
+		// F is called with a T & and returns whether it handled the event
+		template <typename T, typename F>
+		void Subscribe(const F &handler)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "Subscribe needs the class of an event!");
+
+			// The table is indexed by the type, every event reaching this handler is a T
+			m_TypeHandlers[(size_t)T::GetStaticType()].push_back([handler](Event &e)
+																													{ return handler(static_cast<T &>(e)); });
+			m_HandlerCount++;
+			s_Generation++;
+		}
+
+		// handler receives every event in one of the categories (a combination of EventCategory flags)
+		void SubscribeCategory(int categories, const EventHandlerFn &handler);
+
+		void Clear();
+
+		bool IsEmpty() const { return m_HandlerCount == 0; }
+		bool IsSubscribed(EventType type, int categoryFlags) const;
+
+		void Dispatch(Event &e) const;
+
+		// Incremented by every change of any table, for the lists of subscribers built from the tables (see Application)
+		static uint32_t GetGeneration() { return s_Generation; }
+
+	private:
+		struct CategoryHandler
+		{
+			int Categories;
+			EventHandlerFn Handler;
+		};
+
+		std::array<std::vector<EventHandlerFn>, EventTypeCount> m_TypeHandlers;
+		std::vector<CategoryHandler> m_CategoryHandlers;
+		size_t m_HandlerCount = 0;
+
+		static uint32_t s_Generation;
+	};
+
+}
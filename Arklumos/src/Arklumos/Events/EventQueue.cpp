@@ -0,0 +1,83 @@
+#include "akpch.h"
+#include "Arklumos/Events/EventQueue.h"
+
+namespace Arklumos
+{
+
+	static constexpr size_t AlignSize(size_t size)
+	{
+		return (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+	}
+
+	EventQueue::~EventQueue()
+	{
+		Clear(m_Buffers[0]);
+		Clear(m_Buffers[1]);
+	}
+
+	void *EventQueue::Allocate(Buffer &buffer, size_t size)
+	{
+		size = AlignSize(size);
+
+		while (buffer.CurrentPage < buffer.Pages.size() && buffer.Pages[buffer.CurrentPage].Used + size > buffer.Pages[buffer.CurrentPage].Capacity)
+		{
+			buffer.CurrentPage++;
+		}
+
+		if (buffer.CurrentPage == buffer.Pages.size())
+		{
+			AK_MEMORY_TAG(Events);
+
+			Page page;
+			page.Capacity = std::max(PageSize, size);
+			page.Data = Scope<uint8_t[]>(new uint8_t[page.Capacity]);
+			buffer.Pages.push_back(std::move(page));
+		}
+
+		Page &page = buffer.Pages[buffer.CurrentPage];
+		void *memory = page.Data.get() + page.Used;
+		page.Used += size;
+		return memory;
+	}
+
+	void EventQueue::Clear(Buffer &buffer)
+	{
+		for (Event *event : buffer.Events)
+		{
+			event->~Event();
+		}
+		buffer.Events.clear();
+
+		for (Page &page : buffer.Pages)
+		{
+			page.Used = 0;
+		}
+		buffer.CurrentPage = 0;
+	}
+
+	void EventQueue::Dispatch(const EventCallbackFn &callback)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		Buffer *buffer;
+		{
+			std::lock_guard lock(m_Mutex);
+			buffer = &m_Buffers[m_PendingBuffer];
+			m_PendingBuffer ^= 1;
+		}
+
+		for (Event *event : buffer->Events)
+		{
+			callback(*event);
+		}
+
+		Clear(*buffer);
+	}
+
+	size_t EventQueue::GetPendingCount()
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Buffers[m_PendingBuffer].Events.size();
+	}
+
+}
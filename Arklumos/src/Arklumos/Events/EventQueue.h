@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Arklumos/Events/Event.h"
+#include "Arklumos/Events/ApplicationEvent.h"
+#include "Arklumos/Events/MouseEvent.h"
+
+#include <mutex>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		How a queued event absorbs the next one of the same type, when nothing was queued in between.
+		Only the events describing a state (a position, a size) or an accumulated amount can be merged this way:
+		merging two key presses would lose one, and merging across another event would change the order the layers see them in.
+	*/
+	template <typename T>
+	struct EventCoalescing
+	{
+		static constexpr bool Enabled = false;
+		static void Merge(T &queued, const T &event) {}
+	};
+
+	// Only the last position of the cursor matters
+	template <>
+	struct EventCoalescing<MouseMovedEvent>
+	{
+		static constexpr bool Enabled = true;
+		static void Merge(MouseMovedEvent &queued, const MouseMovedEvent &event) { queued = event; }
+	};
+
+	// The offsets add up
+	template <>
+	struct EventCoalescing<MouseScrolledEvent>
+	{
+		static constexpr bool Enabled = true;
+		static void Merge(MouseScrolledEvent &queued, const MouseScrolledEvent &event)
+		{
+			queued = MouseScrolledEvent(queued.GetXOffset() + event.GetXOffset(), queued.GetYOffset() + event.GetYOffset());
+		}
+	};
+
+	// Resizing the framebuffers for every intermediate size of a drag is wasted work, only the final size matters
+	template <>
+	struct EventCoalescing<WindowResizeEvent>
+	{
+		static constexpr bool Enabled = true;
+		static void Merge(WindowResizeEvent &queued, const WindowResizeEvent &event) { queued = event; }
+	};
+
+	/*
+		Events waiting to be dispatched, in the order they were posted.
+
+		Copies of the events are stored back to back in pages that are kept from one dispatch to the next, so posting an event doesn't allocate once the queue is warm.
+		An event of a coalescing type (see EventCoalescing) is merged into the last queued event when they have the same type:
+		the hundreds of cursor moves a high polling rate mouse reports in a frame end up as a single dispatch.
+
+		Post can be called from any thread. Dispatch belongs to the main thread: it takes the events queued so far and passes them to the callback,
+		the events posted meanwhile (by the callback itself or by other threads) wait for the next Dispatch.
+	*/
+	class EventQueue
+	{
+	public:
+		using EventCallbackFn = std::function<void(Event &)>;
+
+		static constexpr size_t PageSize = 64 * 1024;
+
+		EventQueue() = default;
+		~EventQueue();
+		EventQueue(const EventQueue &) = delete;
+		EventQueue &operator=(const EventQueue &) = delete;
+
+		template <typename T>
+		void Post(const T &event)
+		{
+			static_assert(std::is_base_of_v<Event, T> && !std::is_same_v<T, Event>, "Post needs the concrete type of the event!");
+			static_assert(alignof(T) <= alignof(std::max_align_t), "Over aligned events aren't supported!");
+
+			std::lock_guard lock(m_Mutex);
+			Buffer &buffer = m_Buffers[m_PendingBuffer];
+
+			if constexpr (EventCoalescing<T>::Enabled)
+			{
+				if (!buffer.Events.empty() && buffer.Events.back()->GetEventType() == T::GetStaticType())
+				{
+					EventCoalescing<T>::Merge(static_cast<T &>(*buffer.Events.back()), event);
+					// The merged event happened when the last one did
+					buffer.Events.back()->Timestamp = event.Timestamp;
+					return;
+				}
+			}
+
+			buffer.Events.push_back(new (Allocate(buffer, sizeof(T))) T(event));
+		}
+
+		// Passes the queued events to the callback, in order, then destroys them
+		void Dispatch(const EventCallbackFn &callback);
+
+		size_t GetPendingCount();
+
+	private:
+		struct Page
+		{
+			Scope<uint8_t[]> Data;
+			size_t Capacity = 0;
+			size_t Used = 0;
+		};
+
+		struct Buffer
+		{
+			std::vector<Page> Pages;
+			size_t CurrentPage = 0;
+			// Point into the pages, which never move
+			std::vector<Event *> Events;
+		};
+
+		static void *Allocate(Buffer &buffer, size_t size);
+		static void Clear(Buffer &buffer);
+
+		// Protects the pending buffer and the index, the other buffer belongs to Dispatch
+		std::mutex m_Mutex;
+		Buffer m_Buffers[2];
+		uint32_t m_PendingBuffer = 0;
+	};
+
+}
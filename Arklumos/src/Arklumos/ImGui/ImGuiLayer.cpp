@@ -6,6 +6,7 @@
 #include <backends/imgui_impl_opengl3.cpp>
 
 #include "Arklumos/Core/Application.h"
+#include "Arklumos/Renderer/Renderer.h"
 
 // TODO: Temp ?
 #include <GLFW/glfw3.h>
@@ -14,9 +15,53 @@
 namespace Arklumos
 {
 
+	/*
+		Copy of the draw data of a frame, for the render thread.
+		ImGui::GetDrawData() points to buffers that the next ImGui::NewFrame reuses, and the main thread starts the next frame before the render thread draws this one,
+		so the draw lists are cloned and the copy is rendered instead.
+	*/
+	struct ImGuiDrawDataSnapshot
+	{
+		ImDrawData DrawData;
+		ImVector<ImDrawList *> DrawLists;
+
+		ImGuiDrawDataSnapshot(const ImDrawData *source)
+				: DrawData(*source)
+		{
+			DrawLists.resize(source->CmdListsCount);
+			for (int i = 0; i < source->CmdListsCount; i++)
+			{
+				DrawLists[i] = source->CmdLists[i]->CloneOutput();
+			}
+
+#if IMGUI_VERSION_NUM >= 18973
+			// CmdLists is an ImVector since 1.89.8
+			DrawData.CmdLists = DrawLists;
+#else
+			DrawData.CmdLists = DrawLists.Data;
+#endif
+		}
+
+		~ImGuiDrawDataSnapshot()
+		{
+			for (ImDrawList *drawList : DrawLists)
+			{
+				IM_DELETE(drawList);
+			}
+		}
+
+		ImGuiDrawDataSnapshot(const ImGuiDrawDataSnapshot &) = delete;
+		ImGuiDrawDataSnapshot &operator=(const ImGuiDrawDataSnapshot &) = delete;
+	};
+
 	ImGuiLayer::ImGuiLayer()
 			: Layer("ImGuiLayer")
 	{
+		// Only the input can be captured by ImGui, the other events don't reach the layer
+		SubscribeEventCategory(EventCategoryMouse | EventCategoryKeyboard, [this](Event &e)
+													 {
+			OnEvent(e);
+			return false; });
 	}
 
 	ImGuiLayer::~ImGuiLayer()
@@ -27,6 +72,12 @@ namespace Arklumos
 	{
 		// AK_PROFILE_FUNCTION();
 
+		// ImGui allocates with malloc, its allocations are routed to the memory tracker (set before the context, which is allocated with them too)
+		ImGui::SetAllocatorFunctions([](size_t size, void *)
+																 { return MemoryTracker::Allocate(MemoryTag::ImGui, size); },
+																 [](void *memory, void *)
+																 { MemoryTracker::Free(memory); });
+
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
 		ImGui::CreateContext();
@@ -40,7 +91,11 @@ namespace Arklumos
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard; // Enable Keyboard Controls
 		// io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;		// Enable Docking
-		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable; // Enable Multi-Viewport / Platform Windows
+		// The platform windows are created by the main thread (GLFW) and rendered with their own context, which doesn't work with the render thread owning the context
+		if (!Application::Get().GetSpecification().UseRenderThread)
+		{
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable; // Enable Multi-Viewport / Platform Windows
+		}
 		// io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoTaskBarIcons;
 		// io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoMerge;
 
@@ -88,6 +143,13 @@ namespace Arklumos
 		*/
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init("#version 410");
+
+		/*
+			The backend creates its device objects (and builds the font atlas) on its first NewFrame otherwise.
+			They are created now, while the main thread still owns the context: with the render thread, that first NewFrame would only run a frame later,
+			after ImGui::NewFrame already needed the font atlas.
+		*/
+		ImGui_ImplOpenGL3_CreateDeviceObjects();
 	}
 
 	/*
@@ -141,7 +203,9 @@ namespace Arklumos
 	{
 		// AK_PROFILE_FUNCTION();
 
-		ImGui_ImplOpenGL3_NewFrame();
+		// Nothing to do for the backend once the device objects exist, but it is a graphics API call so it goes to the thread owning the context
+		Renderer::Submit([]()
+										 { ImGui_ImplOpenGL3_NewFrame(); });
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
 		ImGuizmo::BeginFrame();
@@ -165,6 +229,16 @@ namespace Arklumos
 
 		// Rendering
 		ImGui::Render();
+
+		if (RenderThread::IsRunning())
+		{
+			// The render thread draws a copy of the draw data, the main thread is already building the next frame by then
+			Ref<ImGuiDrawDataSnapshot> snapshot = CreateRef<ImGuiDrawDataSnapshot>(ImGui::GetDrawData());
+			Renderer::Submit([snapshot]()
+											 { ImGui_ImplOpenGL3_RenderDrawData(&snapshot->DrawData); });
+			return;
+		}
+
 		// Render the ImGui draw data using the OpenGL3 renderer
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
@@ -0,0 +1,151 @@
+#include "akpch.h"
+#include "Arklumos/Math/TransformBatch.h"
+
+#include "Arklumos/Math/TransformBatchKernels.h"
+
+#if AK_TRANSFORM_BATCH_SSE2 && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Arklumos::Math
+{
+
+	// The kernels read and write the glm types as plain float arrays
+	static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "glm::mat4 is expected to be 16 contiguous floats");
+	static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "glm::vec3 is expected to be 3 contiguous floats");
+
+#if AK_TRANSFORM_BATCH_SSE2
+	// Defined in TransformBatchAVX2.cpp, the only file compiled with AVX2 enabled
+	void ComposeTransformsAVX2(const float *const *components, size_t count, float *outMatrices);
+	void DecomposeTransformsAVX2(const float *matrices, size_t count, float *outTranslation, float *outRotation, float *outScale);
+
+	static bool HasAVX2()
+	{
+		// Checked once, the instruction set can't change while running
+		static const bool s_HasAVX2 = []()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 1);
+			// The OS has to save the AVX registers on context switches (OSXSAVE and the YMM state enabled in XCR0)
+			bool osSupport = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+			__cpuidex(info, 7, 0);
+			return osSupport && (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		}();
+		return s_HasAVX2;
+	}
+#endif
+
+	void TransformSoA::Clear()
+	{
+		TranslationX.clear();
+		TranslationY.clear();
+		TranslationZ.clear();
+		RotationX.clear();
+		RotationY.clear();
+		RotationZ.clear();
+		ScaleX.clear();
+		ScaleY.clear();
+		ScaleZ.clear();
+	}
+
+	void TransformSoA::Reserve(size_t count)
+	{
+		TranslationX.reserve(count);
+		TranslationY.reserve(count);
+		TranslationZ.reserve(count);
+		RotationX.reserve(count);
+		RotationY.reserve(count);
+		RotationZ.reserve(count);
+		ScaleX.reserve(count);
+		ScaleY.reserve(count);
+		ScaleZ.reserve(count);
+	}
+
+	void TransformSoA::Push(const glm::vec3 &translation, const glm::vec3 &rotation, const glm::vec3 &scale)
+	{
+		TranslationX.push_back(translation.x);
+		TranslationY.push_back(translation.y);
+		TranslationZ.push_back(translation.z);
+		RotationX.push_back(rotation.x);
+		RotationY.push_back(rotation.y);
+		RotationZ.push_back(rotation.z);
+		ScaleX.push_back(scale.x);
+		ScaleY.push_back(scale.y);
+		ScaleZ.push_back(scale.z);
+	}
+
+	void ComposeTransforms(const TransformSoA &transforms, glm::mat4 *outTransforms)
+	{
+		ComposeTransforms(transforms, 0, transforms.Size(), outTransforms);
+	}
+
+	void ComposeTransforms(const TransformSoA &transforms, size_t begin, size_t end, glm::mat4 *outTransforms)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_CORE_ASSERT(begin <= end && end <= transforms.Size(), "Transform range out of bounds!");
+
+		const float *components[TransformComponentCount] = {
+				transforms.TranslationX.data() + begin, transforms.TranslationY.data() + begin, transforms.TranslationZ.data() + begin,
+				transforms.RotationX.data() + begin, transforms.RotationY.data() + begin, transforms.RotationZ.data() + begin,
+				transforms.ScaleX.data() + begin, transforms.ScaleY.data() + begin, transforms.ScaleZ.data() + begin};
+
+		size_t count = end - begin;
+		float *out = reinterpret_cast<float *>(outTransforms + begin);
+
+#if AK_TRANSFORM_BATCH_SSE2
+		if (HasAVX2())
+		{
+			ComposeTransformsAVX2(components, count, out);
+		}
+		else
+		{
+			ComposeTransformsRange<FloatSSE>(components, count, out);
+		}
+#else
+		ComposeTransformsRange<FloatScalar>(components, count, out);
+#endif
+	}
+
+	static void DecomposeMatrices(const glm::mat4 *transforms, size_t count, glm::vec3 *outTranslation, glm::vec3 *outRotation, glm::vec3 *outScale)
+	{
+		const float *matrices = reinterpret_cast<const float *>(transforms);
+		float *translation = reinterpret_cast<float *>(outTranslation);
+		float *rotation = reinterpret_cast<float *>(outRotation);
+		float *scale = reinterpret_cast<float *>(outScale);
+
+#if AK_TRANSFORM_BATCH_SSE2
+		if (HasAVX2())
+		{
+			DecomposeTransformsAVX2(matrices, count, translation, rotation, scale);
+		}
+		else
+		{
+			DecomposeTransformsRange<FloatSSE>(matrices, count, translation, rotation, scale);
+		}
+#else
+		DecomposeTransformsRange<FloatScalar>(matrices, count, translation, rotation, scale);
+#endif
+	}
+
+	void DecomposeTransforms(const glm::mat4 *transforms, size_t count, glm::vec3 *outTranslation, glm::vec3 *outRotation, glm::vec3 *outScale)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		DecomposeMatrices(transforms, count, outTranslation, outRotation, outScale);
+	}
+
+	const char *GetTransformBatchInstructionSet()
+	{
+#if AK_TRANSFORM_BATCH_SSE2
+		return HasAVX2() ? "AVX2" : "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Arklumos::Math
+{
+
+	/*
+		Translation/rotation/scale of many transforms stored as a structure of arrays: one array per component instead of one struct per transform.
+		This is the layout the SIMD kernels want, a block of 4 or 8 consecutive values of a component is loaded in a single register.
+
+		The rotation is in Euler angles (radians), with the same convention as TransformComponent (glm::quat(Rotation), so R = Rz * Ry * Rx).
+		The vectors are cleared but keep their capacity, so the same storage can be refilled every frame without allocating.
+	*/
+	struct TransformSoA
+	{
+		std::vector<float> TranslationX, TranslationY, TranslationZ;
+		std::vector<float> RotationX, RotationY, RotationZ;
+		std::vector<float> ScaleX, ScaleY, ScaleZ;
+
+		size_t Size() const { return TranslationX.size(); }
+		bool Empty() const { return TranslationX.empty(); }
+
+		void Clear();
+		void Reserve(size_t count);
+		void Push(const glm::vec3 &translation, const glm::vec3 &rotation, const glm::vec3 &scale);
+	};
+
+	/*
+		Computes translate * rotate * scale for every transform of the batch, writes the matrices in outTransforms (which must hold transforms.Size() matrices).
+		Equivalent to TransformComponent::GetTransform() but processes 8 (AVX2) or 4 (SSE2) transforms at a time, the instruction set is chosen at runtime.
+		Blocks where no transform has a rotation around X or Y (2D sprites) take a fast path that only evaluates the rotation around Z.
+	*/
+	void ComposeTransforms(const TransformSoA &transforms, glm::mat4 *outTransforms);
+
+	// Same as above for the transforms [begin, end) only, outTransforms[i] receives the transform i. Disjoint ranges can be computed from different threads
+	void ComposeTransforms(const TransformSoA &transforms, size_t begin, size_t end, glm::mat4 *outTransforms);
+
+	/*
+		Batch counterpart of DecomposeTransform. The matrices are expected to be affine (no perspective part, w = 1), like the ones built by ComposeTransforms.
+		Any output pointer can be null if that part is not needed.
+	*/
+	void DecomposeTransforms(const glm::mat4 *transforms, size_t count, glm::vec3 *outTranslation, glm::vec3 *outRotation, glm::vec3 *outScale);
+
+	// Name of the instruction set used by the batch functions ("AVX2", "SSE2" or "Scalar"), for the stats panels
+	const char *GetTransformBatchInstructionSet();
+
+}
@@ -0,0 +1,68 @@
+/*
+	AVX2 kernels of TransformBatch.cpp.
+
+	This file is compiled with AVX2 code generation enabled (see Arklumos/CMakeLists.txt and premake5.lua) and without the precompiled header,
+	which is built for the baseline instruction set. Its functions are only called after checking that the CPU supports AVX2,
+	so nothing else must be defined here: no engine header, no glm, only the kernels (which have internal linkage).
+*/
+
+#include "Arklumos/Math/TransformBatchKernels.h"
+
+#if AK_TRANSFORM_BATCH_SSE2
+#include <immintrin.h>
+
+namespace Arklumos::Math
+{
+
+	namespace
+	{
+
+		struct MaskAVX
+		{
+			__m256 V;
+		};
+
+		inline MaskAVX operator&(MaskAVX a, MaskAVX b) { return {_mm256_and_ps(a.V, b.V)}; }
+		inline MaskAVX operator|(MaskAVX a, MaskAVX b) { return {_mm256_or_ps(a.V, b.V)}; }
+		inline MaskAVX operator^(MaskAVX a, MaskAVX b) { return {_mm256_xor_ps(a.V, b.V)}; }
+		inline bool AllTrue(MaskAVX mask) { return _mm256_movemask_ps(mask.V) == 0xFF; }
+
+		struct FloatAVX
+		{
+			using Mask = MaskAVX;
+			static constexpr size_t Width = 8;
+
+			__m256 V;
+
+			static FloatAVX Set(float value) { return {_mm256_set1_ps(value)}; }
+			static FloatAVX Load(const float *p) { return {_mm256_loadu_ps(p)}; }
+			void Store(float *p) const { _mm256_storeu_ps(p, V); }
+		};
+
+		inline FloatAVX operator+(FloatAVX a, FloatAVX b) { return {_mm256_add_ps(a.V, b.V)}; }
+		inline FloatAVX operator-(FloatAVX a, FloatAVX b) { return {_mm256_sub_ps(a.V, b.V)}; }
+		inline FloatAVX operator*(FloatAVX a, FloatAVX b) { return {_mm256_mul_ps(a.V, b.V)}; }
+		inline FloatAVX operator/(FloatAVX a, FloatAVX b) { return {_mm256_div_ps(a.V, b.V)}; }
+		inline FloatAVX Abs(FloatAVX a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.V)}; }
+		inline FloatAVX Sqrt(FloatAVX a) { return {_mm256_sqrt_ps(a.V)}; }
+		inline FloatAVX Truncate(FloatAVX a) { return {_mm256_round_ps(a.V, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)}; }
+		inline MaskAVX CmpEQ(FloatAVX a, FloatAVX b) { return {_mm256_cmp_ps(a.V, b.V, _CMP_EQ_OQ)}; }
+		inline MaskAVX CmpLT(FloatAVX a, FloatAVX b) { return {_mm256_cmp_ps(a.V, b.V, _CMP_LT_OQ)}; }
+		inline MaskAVX CmpGT(FloatAVX a, FloatAVX b) { return {_mm256_cmp_ps(a.V, b.V, _CMP_GT_OQ)}; }
+		inline MaskAVX CmpGE(FloatAVX a, FloatAVX b) { return {_mm256_cmp_ps(a.V, b.V, _CMP_GE_OQ)}; }
+		inline FloatAVX Select(MaskAVX mask, FloatAVX a, FloatAVX b) { return {_mm256_blendv_ps(b.V, a.V, mask.V)}; }
+
+	}
+
+	void ComposeTransformsAVX2(const float *const *components, size_t count, float *outMatrices)
+	{
+		ComposeTransformsRange<FloatAVX>(components, count, outMatrices);
+	}
+
+	void DecomposeTransformsAVX2(const float *matrices, size_t count, float *outTranslation, float *outRotation, float *outScale)
+	{
+		DecomposeTransformsRange<FloatAVX>(matrices, count, outTranslation, outRotation, outScale);
+	}
+
+}
+#endif
@@ -0,0 +1,397 @@
+#pragma once
+
+/*
+	Internal header of TransformBatch.cpp and TransformBatchAVX2.cpp, don't include it anywhere else.
+
+	The kernels are written once as templates over a "float pack" type (Scalar, SSE, AVX2), each instruction set only has to provide the basic operations.
+	They work on raw float pointers (a glm::mat4 is 16 contiguous floats, column major) and everything lives in an anonymous namespace:
+	the AVX2 translation unit is compiled with different code generation flags, so no inline function can be shared with the other translation units
+	(the linker would be free to keep the AVX2 version of an inline function for everybody, which would crash on CPUs without AVX2).
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AK_TRANSFORM_BATCH_SSE2 1
+#include <emmintrin.h>
+#else
+#define AK_TRANSFORM_BATCH_SSE2 0
+#endif
+
+namespace Arklumos::Math
+{
+
+	namespace
+	{
+
+		// Indices of the component arrays passed to the kernels
+		enum TransformComponentIndex
+		{
+			TranslationX = 0, TranslationY, TranslationZ,
+			RotationX, RotationY, RotationZ,
+			ScaleX, ScaleY, ScaleZ,
+			TransformComponentCount
+		};
+
+		constexpr float s_Pi = 3.14159265358979323846f;
+
+		/*
+			Float packs
+		*/
+
+		struct FloatScalar
+		{
+			using Mask = bool;
+			static constexpr size_t Width = 1;
+
+			float V;
+
+			static FloatScalar Set(float value) { return {value}; }
+			static FloatScalar Load(const float *p) { return {*p}; }
+			void Store(float *p) const { *p = V; }
+		};
+
+		inline FloatScalar operator+(FloatScalar a, FloatScalar b) { return {a.V + b.V}; }
+		inline FloatScalar operator-(FloatScalar a, FloatScalar b) { return {a.V - b.V}; }
+		inline FloatScalar operator*(FloatScalar a, FloatScalar b) { return {a.V * b.V}; }
+		inline FloatScalar operator/(FloatScalar a, FloatScalar b) { return {a.V / b.V}; }
+		inline FloatScalar Abs(FloatScalar a) { return {std::fabs(a.V)}; }
+		inline FloatScalar Sqrt(FloatScalar a) { return {std::sqrt(a.V)}; }
+		inline FloatScalar Truncate(FloatScalar a) { return {std::trunc(a.V)}; }
+		inline bool CmpEQ(FloatScalar a, FloatScalar b) { return a.V == b.V; }
+		inline bool CmpLT(FloatScalar a, FloatScalar b) { return a.V < b.V; }
+		inline bool CmpGT(FloatScalar a, FloatScalar b) { return a.V > b.V; }
+		inline bool CmpGE(FloatScalar a, FloatScalar b) { return a.V >= b.V; }
+		inline FloatScalar Select(bool mask, FloatScalar a, FloatScalar b) { return mask ? a : b; }
+		inline bool AllTrue(bool mask) { return mask; }
+
+#if AK_TRANSFORM_BATCH_SSE2
+		struct MaskSSE
+		{
+			__m128 V;
+		};
+
+		inline MaskSSE operator&(MaskSSE a, MaskSSE b) { return {_mm_and_ps(a.V, b.V)}; }
+		inline MaskSSE operator|(MaskSSE a, MaskSSE b) { return {_mm_or_ps(a.V, b.V)}; }
+		inline MaskSSE operator^(MaskSSE a, MaskSSE b) { return {_mm_xor_ps(a.V, b.V)}; }
+		inline bool AllTrue(MaskSSE mask) { return _mm_movemask_ps(mask.V) == 0xF; }
+
+		struct FloatSSE
+		{
+			using Mask = MaskSSE;
+			static constexpr size_t Width = 4;
+
+			__m128 V;
+
+			static FloatSSE Set(float value) { return {_mm_set1_ps(value)}; }
+			static FloatSSE Load(const float *p) { return {_mm_loadu_ps(p)}; }
+			void Store(float *p) const { _mm_storeu_ps(p, V); }
+		};
+
+		inline FloatSSE operator+(FloatSSE a, FloatSSE b) { return {_mm_add_ps(a.V, b.V)}; }
+		inline FloatSSE operator-(FloatSSE a, FloatSSE b) { return {_mm_sub_ps(a.V, b.V)}; }
+		inline FloatSSE operator*(FloatSSE a, FloatSSE b) { return {_mm_mul_ps(a.V, b.V)}; }
+		inline FloatSSE operator/(FloatSSE a, FloatSSE b) { return {_mm_div_ps(a.V, b.V)}; }
+		inline FloatSSE Abs(FloatSSE a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.V)}; }
+		inline FloatSSE Sqrt(FloatSSE a) { return {_mm_sqrt_ps(a.V)}; }
+		// SSE2 has no round instruction, go through a conversion to int (the values stay far below 2^31 here)
+		inline FloatSSE Truncate(FloatSSE a) { return {_mm_cvtepi32_ps(_mm_cvttps_epi32(a.V))}; }
+		inline MaskSSE CmpEQ(FloatSSE a, FloatSSE b) { return {_mm_cmpeq_ps(a.V, b.V)}; }
+		inline MaskSSE CmpLT(FloatSSE a, FloatSSE b) { return {_mm_cmplt_ps(a.V, b.V)}; }
+		inline MaskSSE CmpGT(FloatSSE a, FloatSSE b) { return {_mm_cmpgt_ps(a.V, b.V)}; }
+		inline MaskSSE CmpGE(FloatSSE a, FloatSSE b) { return {_mm_cmpge_ps(a.V, b.V)}; }
+		inline FloatSSE Select(MaskSSE mask, FloatSSE a, FloatSSE b) { return {_mm_or_ps(_mm_and_ps(mask.V, a.V), _mm_andnot_ps(mask.V, b.V))}; }
+#endif
+
+		/*
+			Math functions, ported from the single precision functions of the Cephes library (sinf/cosf/atanf).
+			The integer parts of the range reductions are done with floats so the packs don't need integer operations.
+		*/
+
+		template <typename F>
+		inline void SinCos(F x, F &outSin, F &outCos)
+		{
+			using M = typename F::Mask;
+
+			const F zero = F::Set(0.0f);
+			M sinNegative = CmpLT(x, zero);
+			x = Abs(x);
+
+			// Octant of the angle, rounded up to an even number: j = (j + 1) & ~1
+			F j = Truncate(x * F::Set(4.0f / s_Pi));
+			j = j + (j - F::Set(2.0f) * Truncate(j * F::Set(0.5f)));
+			// j modulo 8, one of 0, 2, 4, 6
+			F octant = j - F::Set(8.0f) * Truncate(j * F::Set(0.125f));
+
+			// Extended precision modular arithmetic: x - j * Pi / 4, with Pi / 4 split in three parts
+			x = ((x - j * F::Set(0.78515625f)) - j * F::Set(2.4187564849853515625e-4f)) - j * F::Set(3.77489497744594108e-8f);
+
+			F z = x * x;
+			F cosPolynomial = ((F::Set(2.443315711809948e-5f) * z - F::Set(1.388731625493765e-3f)) * z + F::Set(4.166664568298827e-2f)) * z * z - F::Set(0.5f) * z + F::Set(1.0f);
+			F sinPolynomial = ((F::Set(-1.9515295891e-4f) * z + F::Set(8.3321608736e-3f)) * z - F::Set(1.6666654611e-1f)) * z * x + x;
+
+			M swap = CmpEQ(octant, F::Set(2.0f)) | CmpEQ(octant, F::Set(6.0f));
+			F sin = Select(swap, cosPolynomial, sinPolynomial);
+			F cos = Select(swap, sinPolynomial, cosPolynomial);
+
+			sinNegative = sinNegative ^ CmpGE(octant, F::Set(4.0f));
+			M cosNegative = CmpEQ(octant, F::Set(2.0f)) | CmpEQ(octant, F::Set(4.0f));
+
+			outSin = Select(sinNegative, zero - sin, sin);
+			outCos = Select(cosNegative, zero - cos, cos);
+		}
+
+		template <typename F>
+		inline F Atan(F x)
+		{
+			using M = typename F::Mask;
+
+			const F zero = F::Set(0.0f);
+			const F one = F::Set(1.0f);
+			M negative = CmpLT(x, zero);
+			x = Abs(x);
+
+			// Range reduction, tan(3 * Pi / 8) and tan(Pi / 8)
+			M large = CmpGT(x, F::Set(2.414213562373095f));
+			M medium = CmpGT(x, F::Set(0.4142135623730950f));
+
+			F y = Select(large, F::Set(s_Pi * 0.5f), Select(medium, F::Set(s_Pi * 0.25f), zero));
+			x = Select(large, zero - one / x, Select(medium, (x - one) / (x + one), x));
+
+			F z = x * x;
+			y = y + (((F::Set(8.05374449538e-2f) * z - F::Set(1.38776856032e-1f)) * z + F::Set(1.99777106478e-1f)) * z - F::Set(3.33329491539e-1f)) * z * x + x;
+
+			return Select(negative, zero - y, y);
+		}
+
+		template <typename F>
+		inline F Atan2(F y, F x)
+		{
+			const F zero = F::Set(0.0f);
+			const F halfPi = F::Set(s_Pi * 0.5f);
+
+			F result = Atan(y / x);
+			// Left half plane, move the angle to the right quadrant
+			result = Select(CmpLT(x, zero), result + Select(CmpGE(y, zero), F::Set(s_Pi), F::Set(-s_Pi)), result);
+			// On the Y axis the division is undefined
+			F onAxis = Select(CmpGT(y, zero), halfPi, Select(CmpLT(y, zero), zero - halfPi, zero));
+			return Select(CmpEQ(x, zero), onAxis, result);
+		}
+
+		template <typename F>
+		inline F Asin(F x)
+		{
+			const F one = F::Set(1.0f);
+			// Clamp, the rounding errors of the normalization can push the value slightly out of [-1, 1]
+			x = Select(CmpGT(x, one), one, Select(CmpLT(x, F::Set(-1.0f)), F::Set(-1.0f), x));
+			// (1 - x) * (1 + x) rather than 1 - x * x, more precise close to +/-1
+			return Atan2(x, Sqrt((one - x) * (one + x)));
+		}
+
+		/*
+			Compose: matrix = translate * Rz * Ry * Rx * scale, for F::Width transforms starting at index i
+		*/
+		template <typename F>
+		inline void ComposeTransformsBlock(const float *const *components, size_t i, float *outMatrices)
+		{
+			const F zero = F::Set(0.0f);
+
+			F rx = F::Load(components[RotationX] + i);
+			F ry = F::Load(components[RotationY] + i);
+			F rz = F::Load(components[RotationZ] + i);
+			F sx = F::Load(components[ScaleX] + i);
+			F sy = F::Load(components[ScaleY] + i);
+			F sz = F::Load(components[ScaleZ] + i);
+
+			F sinZ, cosZ;
+			SinCos(rz, sinZ, cosZ);
+
+			// Columns of the upper 3x3 part
+			F m00, m01, m02, m10, m11, m12, m20, m21, m22;
+
+			if (AllTrue(CmpEQ(rx, zero) & CmpEQ(ry, zero)))
+			{
+				// 2D fast path, rotation around Z only
+				m00 = cosZ * sx;
+				m01 = sinZ * sx;
+				m02 = zero;
+				m10 = (zero - sinZ) * sy;
+				m11 = cosZ * sy;
+				m12 = zero;
+				m20 = zero;
+				m21 = zero;
+				m22 = sz;
+			}
+			else
+			{
+				F sinX, cosX, sinY, cosY;
+				SinCos(rx, sinX, cosX);
+				SinCos(ry, sinY, cosY);
+
+				m00 = cosY * cosZ * sx;
+				m01 = cosY * sinZ * sx;
+				m02 = (zero - sinY) * sx;
+				m10 = (sinX * sinY * cosZ - cosX * sinZ) * sy;
+				m11 = (sinX * sinY * sinZ + cosX * cosZ) * sy;
+				m12 = sinX * cosY * sy;
+				m20 = (cosX * sinY * cosZ + sinX * sinZ) * sz;
+				m21 = (cosX * sinY * sinZ - sinX * cosZ) * sz;
+				m22 = cosX * cosY * sz;
+			}
+
+			// Back to one matrix per transform
+			alignas(32) float columns[9][F::Width];
+			m00.Store(columns[0]);
+			m01.Store(columns[1]);
+			m02.Store(columns[2]);
+			m10.Store(columns[3]);
+			m11.Store(columns[4]);
+			m12.Store(columns[5]);
+			m20.Store(columns[6]);
+			m21.Store(columns[7]);
+			m22.Store(columns[8]);
+
+			for (size_t lane = 0; lane < F::Width; lane++)
+			{
+				float *m = outMatrices + (i + lane) * 16;
+				m[0] = columns[0][lane];
+				m[1] = columns[1][lane];
+				m[2] = columns[2][lane];
+				m[3] = 0.0f;
+				m[4] = columns[3][lane];
+				m[5] = columns[4][lane];
+				m[6] = columns[5][lane];
+				m[7] = 0.0f;
+				m[8] = columns[6][lane];
+				m[9] = columns[7][lane];
+				m[10] = columns[8][lane];
+				m[11] = 0.0f;
+				m[12] = components[TranslationX][i + lane];
+				m[13] = components[TranslationY][i + lane];
+				m[14] = components[TranslationZ][i + lane];
+				m[15] = 1.0f;
+			}
+		}
+
+		/*
+			Decompose: same steps as DecomposeTransform (length of the columns for the scale, Euler angles from the normalized columns)
+		*/
+		template <typename F>
+		inline void DecomposeTransformsBlock(const float *matrices, size_t i, float *outTranslation, float *outRotation, float *outScale)
+		{
+			// Gather the upper 3x3 part as one pack per element
+			alignas(32) float elements[9][F::Width];
+			for (size_t lane = 0; lane < F::Width; lane++)
+			{
+				const float *m = matrices + (i + lane) * 16;
+				for (int column = 0; column < 3; column++)
+				{
+					for (int row = 0; row < 3; row++)
+					{
+						elements[column * 3 + row][lane] = m[column * 4 + row];
+					}
+				}
+
+				if (outTranslation)
+				{
+					outTranslation[(i + lane) * 3 + 0] = m[12];
+					outTranslation[(i + lane) * 3 + 1] = m[13];
+					outTranslation[(i + lane) * 3 + 2] = m[14];
+				}
+			}
+
+			F r[9];
+			for (int e = 0; e < 9; e++)
+			{
+				r[e] = F::Load(elements[e]);
+			}
+
+			F scale[3];
+			for (int column = 0; column < 3; column++)
+			{
+				F x = r[column * 3], y = r[column * 3 + 1], z = r[column * 3 + 2];
+				scale[column] = Sqrt(x * x + y * y + z * z);
+
+				F inverse = F::Set(1.0f) / scale[column];
+				r[column * 3] = x * inverse;
+				r[column * 3 + 1] = y * inverse;
+				r[column * 3 + 2] = z * inverse;
+			}
+
+			alignas(32) float results[6][F::Width];
+			if (outScale)
+			{
+				scale[0].Store(results[0]);
+				scale[1].Store(results[1]);
+				scale[2].Store(results[2]);
+			}
+
+			if (outRotation)
+			{
+				const F zero = F::Set(0.0f);
+
+				/*
+					cos(rotation.y) is zero (gimbal lock) when the first column is aligned with Z, within the rounding errors of the normalization.
+					Only X - Z (pitch +90 degrees) or X + Z (pitch -90 degrees) is known then: Z is 0 and X takes the whole angle,
+					read from the second column (sin(y) * sin(x), cos(x)) with sin(y) = -r[2].
+				*/
+				auto gimbalLock = CmpGE(Abs(r[2]), F::Set(1.0f - 1e-6f));
+				F rotationY = Asin(zero - r[2]);
+				F rotationX = Select(gimbalLock, Atan2((zero - r[2]) * r[3], r[4]), Atan2(r[5], r[8]));
+				F rotationZ = Select(gimbalLock, zero, Atan2(r[1], r[0]));
+
+				rotationX.Store(results[3]);
+				rotationY.Store(results[4]);
+				rotationZ.Store(results[5]);
+			}
+
+			for (size_t lane = 0; lane < F::Width; lane++)
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					if (outScale)
+					{
+						outScale[(i + lane) * 3 + axis] = results[axis][lane];
+					}
+					if (outRotation)
+					{
+						outRotation[(i + lane) * 3 + axis] = results[3 + axis][lane];
+					}
+				}
+			}
+		}
+
+		// Processes the whole range with the pack F, then the remaining transforms one by one
+		template <typename F>
+		inline void ComposeTransformsRange(const float *const *components, size_t count, float *outMatrices)
+		{
+			size_t i = 0;
+			for (; i + F::Width <= count; i += F::Width)
+			{
+				ComposeTransformsBlock<F>(components, i, outMatrices);
+			}
+			for (; i < count; i++)
+			{
+				ComposeTransformsBlock<FloatScalar>(components, i, outMatrices);
+			}
+		}
+
+		template <typename F>
+		inline void DecomposeTransformsRange(const float *matrices, size_t count, float *outTranslation, float *outRotation, float *outScale)
+		{
+			size_t i = 0;
+			for (; i + F::Width <= count; i += F::Width)
+			{
+				DecomposeTransformsBlock<F>(matrices, i, outTranslation, outRotation, outScale);
+			}
+			for (; i < count; i++)
+			{
+				DecomposeTransformsBlock<FloatScalar>(matrices, i, outTranslation, outRotation, outScale);
+			}
+		}
+
+	}
+
+}
@@ -13,7 +13,7 @@ namespace Arklumos
 
 		This switch statement checks which graphics API is currently being used by the renderer.
 		If the API is set to RendererAPI::API::None, the function will assert and return nullptr.
-		If the API is set to RendererAPI::API::OpenGL, it will create a new OpenGLVertexBuffer object using the CreateRef function and return it.
+		If the API is set to RendererAPI::API::OpenGL, it will create a new OpenGLVertexBuffer object using Renderer::CreateResource and return it.
 
 		If the API is not set to either RendererAPI::API::None or RendererAPI::API::OpenGL, the function will assert and return nullptr.
 		This ensures that the Create function is only called with a supported API.
@@ -27,7 +27,7 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLVertexBuffer>(size);
+			return Renderer::CreateResource<OpenGLVertexBuffer>(size);
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -53,7 +53,7 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLVertexBuffer>(vertices, size);
+			return Renderer::CreateResource<OpenGLVertexBuffer>(vertices, size);
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -77,7 +77,7 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLIndexBuffer>(indices, size);
+			return Renderer::CreateResource<OpenGLIndexBuffer>(indices, size);
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
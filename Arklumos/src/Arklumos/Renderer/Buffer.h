@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Arklumos/Renderer/RenderResource.h"
+
 namespace Arklumos
 {
 
@@ -174,11 +176,13 @@ namespace Arklumos
 		uint32_t m_Stride = 0;
 	};
 
-	class VertexBuffer
+	class VertexBuffer : public RenderResource
 	{
 	public:
 		virtual ~VertexBuffer() {}
 
+		ResourceHandle<VertexBuffer> GetHandle() const { return ResourceHandle<VertexBuffer>(GetHandleValue()); }
+
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
@@ -192,11 +196,13 @@ namespace Arklumos
 	};
 
 	// Currently Arklumos only supports 32-bit for index buffers
-	class IndexBuffer
+	class IndexBuffer : public RenderResource
 	{
 	public:
 		virtual ~IndexBuffer() {}
 
+		ResourceHandle<IndexBuffer> GetHandle() const { return ResourceHandle<IndexBuffer>(GetHandleValue()); }
+
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
@@ -0,0 +1,205 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/FramePacer.h"
+
+#include "Arklumos/Core/Timer.h"
+#include "Arklumos/Renderer/GPUFence.h"
+#include "Arklumos/Renderer/Renderer.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Arklumos
+{
+
+	struct InFlightFrame
+	{
+		Scope<GPUFence> Fence;
+		int64_t BeginTime = 0;
+		int64_t SubmitTime = 0;
+		int64_t PresentTime = 0;
+	};
+
+	struct FramePacerData
+	{
+		Timer Clock;
+
+		// Main thread
+		int64_t FramePeriod = 0;
+		float MaxFrameRate = 0.0f;
+		int64_t NextFrameTime = 0;
+		int64_t FrameBeginTime = 0;
+		std::function<void(int64_t)> WaitCallback;
+
+		// Thread owning the context (the render thread when it runs)
+		std::atomic<uint32_t> MaxFramesInFlight{2};
+		std::deque<InFlightFrame> Frames;
+
+		std::mutex StatsMutex;
+		FramePacer::Statistics Stats;
+	};
+
+	static FramePacerData s_Data;
+
+	// Below this, the remaining time is spun: a sleep can last a millisecond or more past the requested time, depending on the scheduler of the OS
+	static constexpr int64_t s_SpinThreshold = 2000000;
+
+	static void WaitUntil(int64_t time)
+	{
+		while (true)
+		{
+			int64_t remaining = time - s_Data.Clock.ElapsedNanoseconds();
+			if (remaining <= 0)
+			{
+				break;
+			}
+
+			if (remaining > s_SpinThreshold)
+			{
+				if (s_Data.WaitCallback)
+				{
+					s_Data.WaitCallback(remaining - s_SpinThreshold);
+				}
+				else
+				{
+					std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - s_SpinThreshold));
+				}
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	static void CompleteFrame(InFlightFrame &frame, float fenceWaitTime)
+	{
+		// The fence was inserted right after the frame was presented
+		int64_t gpuCompleteTime = frame.PresentTime + (int64_t)frame.Fence->GetGPUDuration();
+
+		std::lock_guard lock(s_Data.StatsMutex);
+		FramePacer::Statistics &stats = s_Data.Stats;
+		stats.FrameBeginTime = frame.BeginTime;
+		stats.CPUSubmitTime = frame.SubmitTime;
+		stats.PresentTime = frame.PresentTime;
+		stats.GPUCompleteTime = gpuCompleteTime;
+		stats.CPUTime = (frame.SubmitTime - frame.BeginTime) * 1e-6f;
+		stats.Latency = (gpuCompleteTime - frame.BeginTime) * 1e-6f;
+		stats.FenceWaitTime = fenceWaitTime;
+	}
+
+	// Executed after the SwapBuffers command of the frame, on the thread owning the context
+	static void OnFrameSubmitted(int64_t beginTime, int64_t submitTime)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		InFlightFrame frame;
+		frame.BeginTime = beginTime;
+		frame.SubmitTime = submitTime;
+		frame.PresentTime = s_Data.Clock.ElapsedNanoseconds();
+		frame.Fence = GPUFence::Create();
+		s_Data.Frames.push_back(std::move(frame));
+
+		// Frames the GPU already completed
+		while (!s_Data.Frames.empty() && s_Data.Frames.front().Fence->Wait(0))
+		{
+			CompleteFrame(s_Data.Frames.front(), 0.0f);
+			s_Data.Frames.pop_front();
+		}
+
+		// Too many frames queued, waits for the GPU to complete the oldest ones
+		uint32_t maxFramesInFlight = std::max(s_Data.MaxFramesInFlight.load(std::memory_order_relaxed), 1u);
+		while (s_Data.Frames.size() >= maxFramesInFlight)
+		{
+			int64_t waitStart = s_Data.Clock.ElapsedNanoseconds();
+			while (!s_Data.Frames.front().Fence->Wait(1000000000))
+			{
+				AK_CORE_WARN("FramePacer: the GPU didn't complete a frame in a second");
+			}
+			float fenceWaitTime = (s_Data.Clock.ElapsedNanoseconds() - waitStart) * 1e-6f;
+
+			CompleteFrame(s_Data.Frames.front(), fenceWaitTime);
+			s_Data.Frames.pop_front();
+		}
+
+		std::lock_guard lock(s_Data.StatsMutex);
+		s_Data.Stats.FramesInFlight = (uint32_t)s_Data.Frames.size();
+	}
+
+	void FramePacer::Init(const FramePacerSpecification &specification)
+	{
+		s_Data.Clock.Reset();
+		s_Data.NextFrameTime = 0;
+		s_Data.FrameBeginTime = 0;
+
+		SetMaxFramesInFlight(specification.MaxFramesInFlight);
+		SetMaxFrameRate(specification.MaxFrameRate);
+	}
+
+	void FramePacer::Shutdown()
+	{
+		// The fences are deleted with the context current on this thread
+		s_Data.Frames.clear();
+	}
+
+	void FramePacer::BeginFrame()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (s_Data.FramePeriod > 0)
+		{
+			WaitUntil(s_Data.NextFrameTime);
+
+			// After a hitch longer than a frame, the pacing starts over from now instead of running frames back to back to catch up
+			int64_t now = s_Data.Clock.ElapsedNanoseconds();
+			s_Data.NextFrameTime = std::max(s_Data.NextFrameTime, now - s_Data.FramePeriod) + s_Data.FramePeriod;
+		}
+
+		s_Data.FrameBeginTime = s_Data.Clock.ElapsedNanoseconds();
+	}
+
+	void FramePacer::EndFrame()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		int64_t beginTime = s_Data.FrameBeginTime;
+		int64_t submitTime = s_Data.Clock.ElapsedNanoseconds();
+		Renderer::Submit([beginTime, submitTime]()
+										 { OnFrameSubmitted(beginTime, submitTime); });
+	}
+
+	void FramePacer::SetMaxFramesInFlight(uint32_t count)
+	{
+		AK_CORE_ASSERT(count > 0, "At least one frame must be in flight!");
+		s_Data.MaxFramesInFlight.store(count, std::memory_order_relaxed);
+	}
+
+	uint32_t FramePacer::GetMaxFramesInFlight()
+	{
+		return s_Data.MaxFramesInFlight.load(std::memory_order_relaxed);
+	}
+
+	void FramePacer::SetMaxFrameRate(float framesPerSecond)
+	{
+		s_Data.MaxFrameRate = std::max(framesPerSecond, 0.0f);
+		s_Data.FramePeriod = s_Data.MaxFrameRate > 0.0f ? (int64_t)(1e9 / s_Data.MaxFrameRate) : 0;
+	}
+
+	float FramePacer::GetMaxFrameRate()
+	{
+		return s_Data.MaxFrameRate;
+	}
+
+	void FramePacer::SetWaitCallback(const std::function<void(int64_t)> &callback)
+	{
+		s_Data.WaitCallback = callback;
+	}
+
+	FramePacer::Statistics FramePacer::GetStats()
+	{
+		std::lock_guard lock(s_Data.StatsMutex);
+		return s_Data.Stats;
+	}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+
+#include <cstdint>
+
+namespace Arklumos
+{
+
+	struct FramePacerSpecification
+	{
+		/*
+			Frames the CPU may have submitted while the GPU hasn't finished them yet. Once reached, the end of a frame waits for the GPU to complete the oldest one.
+			1 gives the lowest latency (the CPU never runs ahead of the GPU), more frames give the GPU more work in advance to smooth out the spikes.
+		*/
+		uint32_t MaxFramesInFlight = 2;
+
+		// Frames per second, 0 doesn't limit the frame rate (the vertical sync may still do it)
+		float MaxFrameRate = 0.0f;
+	};
+
+	/*
+		Frame pacing: limits the number of frames queued for the GPU with fences, optionally caps the frame rate, and measures the timing of each frame.
+
+		Application calls BeginFrame at the beginning of each frame (where it waits for the frame rate cap) and EndFrame once the frame is recorded, after the buffers swap was submitted.
+		EndFrame submits a render command that inserts the fence of the frame and waits for the frames in flight when there are too many of them,
+		so with the render thread it is the render thread that waits (and the main thread waits for it at the next frame).
+
+		Every timestamp is in nanoseconds, on a steady clock started by Init.
+	*/
+	class FramePacer
+	{
+	public:
+		struct Statistics
+		{
+			// Timestamps of the last frame the GPU completed
+			int64_t FrameBeginTime = 0;
+			// The main thread finished recording the frame
+			int64_t CPUSubmitTime = 0;
+			// SwapBuffers returned on the thread owning the context
+			int64_t PresentTime = 0;
+			// The GPU executed the last command of the frame
+			int64_t GPUCompleteTime = 0;
+
+			// Milliseconds: main thread time of the frame (without the wait of the frame rate cap), from the beginning of the frame to its completion by the GPU
+			// (the delay between the input polled for the frame and its image being ready) and time waited on the fences at the end of the frame
+			float CPUTime = 0.0f;
+			float Latency = 0.0f;
+			float FenceWaitTime = 0.0f;
+
+			uint32_t FramesInFlight = 0;
+		};
+
+		static void Init(const FramePacerSpecification &specification = FramePacerSpecification());
+		// Called with the context current on the calling thread (after the render thread stopped)
+		static void Shutdown();
+
+		static void BeginFrame();
+		static void EndFrame();
+
+		static void SetMaxFramesInFlight(uint32_t count);
+		static uint32_t GetMaxFramesInFlight();
+		static void SetMaxFrameRate(float framesPerSecond);
+		static float GetMaxFrameRate();
+
+		/*
+			Called instead of sleeping while the frame rate cap makes the main thread wait, with the duration to wait at most (in nanoseconds).
+			Lets the application do something useful with the time, like sampling the input (see ApplicationSpecification::InputSamplingRate).
+		*/
+		static void SetWaitCallback(const std::function<void(int64_t)> &callback);
+
+		static Statistics GetStats();
+	};
+
+}
@@ -28,7 +28,7 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLFramebuffer>(spec);
+			return Renderer::CreateResource<OpenGLFramebuffer>(spec);
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Arklumos/Core/Base.h"
+#include "Arklumos/Renderer/RenderResource.h"
 
 namespace Arklumos
 {
@@ -48,18 +49,17 @@ namespace Arklumos
 		bool SwapChainTarget = false;
 	};
 
-	class Framebuffer
+	class Framebuffer : public RenderResource
 	{
 	public:
 		virtual ~Framebuffer() = default;
 
+		ResourceHandle<Framebuffer> GetHandle() const { return ResourceHandle<Framebuffer>(GetHandleValue()); }
+
 		virtual void Bind() = 0;
 		virtual void Unbind() = 0;
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
-		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
-
-		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
 
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
 
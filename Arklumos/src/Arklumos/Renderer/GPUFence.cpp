@@ -0,0 +1,26 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/GPUFence.h"
+
+#include "Arklumos/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLFence.h"
+
+namespace Arklumos
+{
+
+	Scope<GPUFence> GPUFence::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			AK_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+
+		case RendererAPI::API::OpenGL:
+			return CreateScope<OpenGLFence>();
+		}
+
+		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+
+#include <cstdint>
+
+namespace Arklumos
+{
+
+	/*
+		Marker inserted in the command stream of the GPU, signaled once the GPU has executed every command submitted before it.
+		Created and used from the thread that owns the graphics context (from render commands).
+	*/
+	class GPUFence
+	{
+	public:
+		virtual ~GPUFence() = default;
+
+		// Waits at most timeout nanoseconds for the fence to be signaled, returns whether it is. A timeout of 0 only polls the fence
+		virtual bool Wait(uint64_t timeout) = 0;
+
+		// Nanoseconds between the insertion of the fence and the moment the GPU reached it, valid once the fence is signaled
+		virtual uint64_t GetGPUDuration() = 0;
+
+		static Scope<GPUFence> Create();
+	};
+
+}
@@ -10,6 +10,10 @@ namespace Arklumos
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
 
+		// Makes the context current on the calling thread, or releases it so that another thread can make it current (see RenderThread)
+		virtual void MakeCurrent() = 0;
+		virtual void DetachCurrent() = 0;
+
 		static Scope<GraphicsContext> Create(void *window);
 	};
 
@@ -1,10 +1,41 @@
 #include "akpch.h"
 
 #include "Arklumos/Renderer/RenderCommand.h"
+#include "Arklumos/Renderer/Renderer.h"
 
 namespace Arklumos
 {
 
 	Scope<RendererAPI> RenderCommand::s_RendererAPI = RendererAPI::Create();
 
-}
\ No newline at end of file
+	void RenderCommand::Init()
+	{
+		Renderer::Submit([]()
+										 { s_RendererAPI->Init(); });
+	}
+
+	void RenderCommand::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		Renderer::Submit([x, y, width, height]()
+										 { s_RendererAPI->SetViewport(x, y, width, height); });
+	}
+
+	void RenderCommand::SetClearColor(const glm::vec4 &color)
+	{
+		Renderer::Submit([color]()
+										 { s_RendererAPI->SetClearColor(color); });
+	}
+
+	void RenderCommand::Clear()
+	{
+		Renderer::Submit([]()
+										 { s_RendererAPI->Clear(); });
+	}
+
+	void RenderCommand::DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t count)
+	{
+		Renderer::Submit([vertexArray, count]()
+										 { s_RendererAPI->DrawIndexed(vertexArray, count); });
+	}
+
+}
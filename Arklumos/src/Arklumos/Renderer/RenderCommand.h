@@ -5,36 +5,25 @@
 namespace Arklumos
 {
 
+	/*
+		Static front end of the RendererAPI. Every call is submitted as a render command (see Renderer::Submit):
+		executed right away, or recorded for the render thread when it runs.
+	*/
 	class RenderCommand
 	{
 	public:
-		static void Init()
-		{
-			s_RendererAPI->Init();
-		}
-
-		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
-		{
-			s_RendererAPI->SetViewport(x, y, width, height);
-		}
-
-		static void SetClearColor(const glm::vec4 &color)
-		{
-			s_RendererAPI->SetClearColor(color);
-		}
-
-		static void Clear()
-		{
-			s_RendererAPI->Clear();
-		}
-
-		static void DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t count = 0)
-		{
-			s_RendererAPI->DrawIndexed(vertexArray, count);
-		}
+		static void Init();
+
+		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+		static void SetClearColor(const glm::vec4 &color);
+
+		static void Clear();
+
+		static void DrawIndexed(const Ref<VertexArray> &vertexArray, uint32_t count = 0);
 
 	private:
 		static Scope<RendererAPI> s_RendererAPI;
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,100 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/RenderCommandQueue.h"
+
+namespace Arklumos
+{
+
+	/*
+		Each block starts with this header, the payload follows at the next aligned address.
+		Size is the size of the whole block (header included, rounded to the alignment), so the next header is at the address of this one plus Size.
+	*/
+	struct RenderCommandHeader
+	{
+		RenderCommandQueue::RenderCommandFn Function;
+		size_t Size;
+	};
+
+	static constexpr size_t AlignSize(size_t size)
+	{
+		return (size + RenderCommandQueue::Alignment - 1) & ~(RenderCommandQueue::Alignment - 1);
+	}
+
+	static constexpr size_t s_HeaderSize = AlignSize(sizeof(RenderCommandHeader));
+
+	uint8_t *RenderCommandQueue::AllocateBlock(RenderCommandFn function, uint32_t size)
+	{
+		size_t blockSize = s_HeaderSize + AlignSize(size);
+
+		// Moves to the next page when the block doesn't fit, a block bigger than a page gets a page of its own
+		while (m_CurrentPage < m_Pages.size() && m_Pages[m_CurrentPage].Used + blockSize > m_Pages[m_CurrentPage].Capacity)
+		{
+			m_CurrentPage++;
+		}
+
+		if (m_CurrentPage == m_Pages.size())
+		{
+			AK_MEMORY_TAG(Renderer);
+
+			Page page;
+			page.Capacity = std::max(PageSize, blockSize);
+			page.Data = Scope<uint8_t[]>(new uint8_t[page.Capacity]);
+			m_Pages.push_back(std::move(page));
+		}
+
+		Page &page = m_Pages[m_CurrentPage];
+		uint8_t *block = page.Data.get() + page.Used;
+		page.Used += blockSize;
+
+		RenderCommandHeader *header = reinterpret_cast<RenderCommandHeader *>(block);
+		header->Function = function;
+		header->Size = blockSize;
+
+		return block + s_HeaderSize;
+	}
+
+	void *RenderCommandQueue::Allocate(RenderCommandFn function, uint32_t size)
+	{
+		AK_CORE_ASSERT(function, "A render command needs a function!");
+
+		m_CommandCount++;
+		return AllocateBlock(function, size);
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		/*
+			Pages are filled in order, but a page can have unused space at its end when the next block didn't fit in it.
+			The pages after the current one are empty (they are left over from a bigger frame).
+		*/
+		for (size_t pageIndex = 0; pageIndex <= m_CurrentPage && pageIndex < m_Pages.size(); pageIndex++)
+		{
+			Page &page = m_Pages[pageIndex];
+
+			size_t offset = 0;
+			while (offset < page.Used)
+			{
+				RenderCommandHeader *header = reinterpret_cast<RenderCommandHeader *>(page.Data.get() + offset);
+				header->Function(page.Data.get() + offset + s_HeaderSize);
+				offset += header->Size;
+			}
+
+			page.Used = 0;
+		}
+
+		m_CurrentPage = 0;
+		m_CommandCount = 0;
+	}
+
+	size_t RenderCommandQueue::GetUsedMemory() const
+	{
+		size_t used = 0;
+		for (size_t pageIndex = 0; pageIndex <= m_CurrentPage && pageIndex < m_Pages.size(); pageIndex++)
+		{
+			used += m_Pages[pageIndex].Used;
+		}
+		return used;
+	}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		Stream of render commands recorded during a frame and executed later, by the render thread.
+
+		A command is a function pointer followed by its payload (in general a lambda moved into the queue by Renderer::Submit), stored back to back in large pages.
+		Recording a command is a bump allocation and executing the queue is a linear walk over the pages, nothing is allocated per command.
+		The pages are kept when the queue is executed, so once it reached the size of a frame, the queue doesn't allocate at all.
+
+		Payloads never move: a pointer returned by Allocate stays valid until the queue is executed.
+		The bulk data a command reads (the vertices of a batch for example) isn't stored here but in the frame memory, see Renderer::CopyForRenderThread.
+	*/
+	class RenderCommandQueue
+	{
+	public:
+		typedef void (*RenderCommandFn)(void *);
+
+		static constexpr size_t PageSize = 1024 * 1024;
+		static constexpr size_t Alignment = 16;
+
+		RenderCommandQueue() = default;
+		RenderCommandQueue(const RenderCommandQueue &) = delete;
+		RenderCommandQueue &operator=(const RenderCommandQueue &) = delete;
+
+		// Records a command and returns the memory of its payload (size bytes), the function receives this memory when the command is executed
+		void *Allocate(RenderCommandFn function, uint32_t size);
+
+		// Executes the commands in recording order, then resets the queue
+		void Execute();
+
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+		size_t GetUsedMemory() const;
+
+	private:
+		struct Page
+		{
+			Scope<uint8_t[]> Data;
+			size_t Capacity = 0;
+			size_t Used = 0;
+		};
+
+		uint8_t *AllocateBlock(RenderCommandFn function, uint32_t size);
+
+		std::vector<Page> m_Pages;
+		size_t m_CurrentPage = 0;
+		uint32_t m_CommandCount = 0;
+	};
+
+}
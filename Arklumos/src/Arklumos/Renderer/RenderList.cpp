@@ -0,0 +1,77 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/RenderList.h"
+
+namespace Arklumos
+{
+
+	void RenderList::Clear()
+	{
+		Transforms.clear();
+		Colors.clear();
+		TextureIndices.clear();
+		EntityIDs.clear();
+		SortKeys.clear();
+		DrawOrder.clear();
+
+		Textures.clear();
+		Textures.push_back(nullptr);
+		TextureIndexByHandle.clear();
+	}
+
+	void RenderList::Resize(size_t count)
+	{
+		Transforms.resize(count);
+		Colors.resize(count);
+		TextureIndices.resize(count);
+		EntityIDs.resize(count);
+		SortKeys.resize(count);
+	}
+
+	uint32_t RenderList::AddTexture(const Ref<Texture2D> &texture)
+	{
+		if (!texture)
+		{
+			return NoTexture;
+		}
+
+		/*
+			The handle index is unique among the live textures, and the table holds a Ref on each of its textures until the list is cleared,
+			so an index can't be reused by another texture while the list still maps it.
+		*/
+		uint32_t handleIndex = texture->GetHandle().GetIndex();
+		if (handleIndex >= TextureIndexByHandle.size())
+		{
+			TextureIndexByHandle.resize(handleIndex + 1, NoTexture);
+		}
+
+		uint32_t &textureIndex = TextureIndexByHandle[handleIndex];
+		if (textureIndex == NoTexture)
+		{
+			Textures.push_back(texture);
+			textureIndex = (uint32_t)Textures.size() - 1;
+		}
+
+		return textureIndex;
+	}
+
+	void RenderList::Sort()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		DrawOrder.resize(Size());
+		for (uint32_t i = 0; i < (uint32_t)DrawOrder.size(); i++)
+		{
+			DrawOrder[i] = i;
+		}
+
+		// Most frames only have untextured sprites, the keys are then already in submission order and there is nothing to sort
+		if (std::is_sorted(SortKeys.begin(), SortKeys.end()))
+		{
+			return;
+		}
+
+		std::sort(DrawOrder.begin(), DrawOrder.end(), [this](uint32_t a, uint32_t b)
+							{ return SortKeys[a] < SortKeys[b]; });
+	}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+#include "Arklumos/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+#include <memory_resource>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		Render data extracted from the scene for one frame, consumed by Renderer2D::DrawRenderList.
+
+		It is a structure of arrays: item i is made of Transforms[i], Colors[i], TextureIndices[i], EntityIDs[i] and SortKeys[i].
+		The extraction resizes the list once, then each chunk of entities fills its own range of indices, so several chunks can be written at the same time.
+
+		Textures are referenced by an index in the Textures table of the list (0 is "no texture", drawn with the white texture),
+		so an item is plain data and the extraction doesn't have to copy a Ref (and touch an atomic reference count) per sprite.
+
+		A list lives for one frame: the scene builds it on FrameAllocator::GetResource(), so filling it costs pointer bumps in the frame memory
+		and it must be destroyed within the frame (before FrameAllocator::BeginFrame). The memory resource is given explicitly so a list
+		can't end up on the heap by accident; a list kept across frames (a capture) has to ask for a heap resource.
+	*/
+	struct RenderList
+	{
+		static constexpr uint32_t NoTexture = 0;
+
+		explicit RenderList(std::pmr::memory_resource *resource)
+			: Transforms(resource), Colors(resource), TextureIndices(resource), EntityIDs(resource), SortKeys(resource), DrawOrder(resource), Textures(resource), TextureIndexByHandle(resource)
+		{
+		}
+
+		std::pmr::vector<glm::mat4> Transforms;
+		std::pmr::vector<glm::vec4> Colors;
+		std::pmr::vector<uint32_t> TextureIndices;
+		std::pmr::vector<int> EntityIDs;
+		std::pmr::vector<uint64_t> SortKeys;
+
+		// Order in which the items are drawn (indices in the arrays above), filled by Sort
+		std::pmr::vector<uint32_t> DrawOrder;
+
+		// Textures referenced by the items, Textures[0] is always null
+		std::pmr::vector<Ref<Texture2D>> Textures;
+
+		// Index in Textures of each texture of the table, indexed by the index of its handle (0 when the texture isn't in the table yet)
+		std::pmr::vector<uint32_t> TextureIndexByHandle;
+
+		size_t Size() const { return Transforms.size(); }
+		bool Empty() const { return Transforms.empty(); }
+
+		void Clear();
+		void Resize(size_t count);
+
+		/*
+			Returns the index of the texture in the table, adding it if needed. The lookup goes through TextureIndexByHandle, so it is constant time whatever the number of textures.
+			Not thread safe, register the textures before the parallel part of the extraction.
+		*/
+		uint32_t AddTexture(const Ref<Texture2D> &texture);
+
+		/*
+			The sort key puts the texture in the high bits and the submission order in the low bits:
+			items sharing a texture end up next to each other (fewer texture slot changes and batches), and within a texture the submission order is kept.
+		*/
+		static uint64_t MakeSortKey(uint32_t textureIndex, uint32_t submissionIndex)
+		{
+			return ((uint64_t)textureIndex << 32) | submissionIndex;
+		}
+
+		// Fills DrawOrder according to the sort keys
+		void Sort();
+	};
+
+}
@@ -0,0 +1,133 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/RenderResource.h"
+
+#include "Arklumos/Renderer/Renderer.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Arklumos
+{
+
+	using AnyHandle = ResourceHandle<RenderResource>;
+
+	static constexpr uint32_t s_MaxGeneration = (1u << (32 - AnyHandle::IndexBits)) - 1;
+
+	struct ResourceRegistryData
+	{
+		std::mutex Mutex;
+
+		// One entry per slot, Resources[i] is null when the slot is free
+		std::vector<RenderResource *> Resources;
+		std::vector<uint32_t> Generations;
+		std::vector<uint32_t> FreeSlots;
+		uint32_t LiveResources = 0;
+
+		// Released during the current frame, deleted by EndFrame
+		std::vector<RenderResource *> PendingReleases;
+		std::vector<RenderResource *> ReleasesToProcess;
+	};
+
+	static ResourceRegistryData s_Data;
+
+	// Trivially destructible, still readable when the resources held by static objects are released at exit
+	static std::atomic<bool> s_ShutDown{false};
+
+	static void DeleteResource(RenderResource *resource)
+	{
+		Renderer::Submit([resource]()
+										 { delete resource; });
+	}
+
+	void ResourceRegistry::Register(RenderResource *resource)
+	{
+		std::lock_guard lock(s_Data.Mutex);
+
+		uint32_t index;
+		if (!s_Data.FreeSlots.empty())
+		{
+			index = s_Data.FreeSlots.back();
+			s_Data.FreeSlots.pop_back();
+		}
+		else
+		{
+			index = (uint32_t)s_Data.Resources.size();
+			AK_CORE_ASSERT(index <= AnyHandle::IndexMask, "Too many rendering resources!");
+			s_Data.Resources.push_back(nullptr);
+			s_Data.Generations.push_back(1);
+		}
+
+		s_Data.Resources[index] = resource;
+		s_Data.LiveResources++;
+		resource->m_HandleValue = (s_Data.Generations[index] << AnyHandle::IndexBits) | index;
+	}
+
+	void ResourceRegistry::Release(RenderResource *resource)
+	{
+		if (s_ShutDown.load(std::memory_order_acquire))
+		{
+			DeleteResource(resource);
+			return;
+		}
+
+		std::lock_guard lock(s_Data.Mutex);
+		s_Data.PendingReleases.push_back(resource);
+	}
+
+	RenderResource *ResourceRegistry::Get(uint32_t handleValue)
+	{
+		AnyHandle handle(handleValue);
+		uint32_t index = handle.GetIndex();
+
+		std::lock_guard lock(s_Data.Mutex);
+		if (!handle.IsValid() || index >= s_Data.Resources.size() || s_Data.Generations[index] != handle.GetGeneration())
+		{
+			return nullptr;
+		}
+		return s_Data.Resources[index];
+	}
+
+	void ResourceRegistry::EndFrame()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		{
+			std::lock_guard lock(s_Data.Mutex);
+			std::swap(s_Data.PendingReleases, s_Data.ReleasesToProcess);
+
+			for (RenderResource *resource : s_Data.ReleasesToProcess)
+			{
+				uint32_t index = AnyHandle(resource->m_HandleValue).GetIndex();
+				s_Data.Resources[index] = nullptr;
+				s_Data.Generations[index] = s_Data.Generations[index] == s_MaxGeneration ? 1 : s_Data.Generations[index] + 1;
+				s_Data.FreeSlots.push_back(index);
+				s_Data.LiveResources--;
+			}
+		}
+
+		// Outside of the lock: without render thread the deletion runs right away, and a resource can release others (a framebuffer its textures)
+		for (RenderResource *resource : s_Data.ReleasesToProcess)
+		{
+			DeleteResource(resource);
+		}
+		s_Data.ReleasesToProcess.clear();
+	}
+
+	void ResourceRegistry::Shutdown()
+	{
+		EndFrame();
+		s_ShutDown.store(true, std::memory_order_release);
+	}
+
+	ResourceRegistry::Statistics ResourceRegistry::GetStats()
+	{
+		std::lock_guard lock(s_Data.Mutex);
+
+		Statistics stats;
+		stats.LiveResources = s_Data.LiveResources;
+		stats.PendingReleases = (uint32_t)s_Data.PendingReleases.size();
+		stats.Capacity = (uint32_t)s_Data.Resources.size();
+		return stats;
+	}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Arklumos
+{
+
+	/*
+		32 bit reference to a rendering resource: the index of its slot in the ResourceRegistry and the generation of that slot.
+		When a resource is destroyed, the generation of its slot is incremented, so the handles still pointing to it become stale instead of reaching the next resource stored there.
+		Comparing two handles compares two integers, and the index can be used to index tables directly (see Renderer2D).
+
+		The value 0 (generation 0) is never given out, a default constructed handle is invalid.
+	*/
+	template <typename T>
+	class ResourceHandle
+	{
+	public:
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+
+		constexpr ResourceHandle() = default;
+		constexpr explicit ResourceHandle(uint32_t value)
+			: m_Value(value) {}
+
+		constexpr uint32_t GetValue() const { return m_Value; }
+		constexpr uint32_t GetIndex() const { return m_Value & IndexMask; }
+		constexpr uint32_t GetGeneration() const { return m_Value >> IndexBits; }
+		constexpr bool IsValid() const { return m_Value != 0; }
+
+		constexpr bool operator==(const ResourceHandle &other) const { return m_Value == other.m_Value; }
+		constexpr bool operator!=(const ResourceHandle &other) const { return m_Value != other.m_Value; }
+
+	private:
+		uint32_t m_Value = 0;
+	};
+
+	// Base of the resources created by Renderer::CreateResource, which gives them a handle
+	class RenderResource
+	{
+	public:
+		virtual ~RenderResource() = default;
+
+		uint32_t GetHandleValue() const { return m_HandleValue; }
+
+	private:
+		friend class ResourceRegistry;
+
+		uint32_t m_HandleValue = 0;
+	};
+
+	/*
+		Table of the live rendering resources (textures, buffers, shaders, framebuffers), indexed by their handles.
+
+		The slots are stored contiguously and reused through a free list. When the last Ref to a resource is released, the resource isn't deleted right away:
+		it stays valid until the end of the frame, then EndFrame frees its slot and submits its deletion as a render command.
+		So during a frame, a resource that had a valid handle can be referenced by a raw pointer in the render commands, without holding a Ref:
+		its deletion is always executed after the commands recorded before.
+
+		Register and Release can be called from any thread, EndFrame is called by the main thread at the end of each frame (see Application).
+	*/
+	class ResourceRegistry
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t LiveResources = 0;
+			uint32_t PendingReleases = 0;
+			uint32_t Capacity = 0;
+		};
+
+		static void Register(RenderResource *resource);
+		static void Release(RenderResource *resource);
+
+		// Returns null for a stale or invalid handle
+		static RenderResource *Get(uint32_t handleValue);
+
+		template <typename T>
+		static T *Get(ResourceHandle<T> handle)
+		{
+			static_assert(std::is_base_of_v<RenderResource, T>, "Not a rendering resource!");
+			return static_cast<T *>(Get(handle.GetValue()));
+		}
+
+		static void EndFrame();
+
+		// Deletes the resources waiting for the end of the frame, the resources released afterwards are deleted right away
+		static void Shutdown();
+
+		static Statistics GetStats();
+	};
+
+}
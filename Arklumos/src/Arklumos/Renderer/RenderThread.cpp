@@ -0,0 +1,222 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/RenderThread.h"
+
+#include "Arklumos/Renderer/GraphicsContext.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Arklumos
+{
+
+	struct RenderThreadData
+	{
+		std::thread Thread;
+		std::thread::id RenderThreadID;
+		GraphicsContext *Context = nullptr;
+
+		RenderCommandQueue CommandQueues[2];
+		// Written by the main thread only, the render thread executes the other queue
+		uint32_t SubmissionQueueIndex = 0;
+
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		// A frame has been handed to the render thread and is not done yet
+		bool FrameInFlight = false;
+		bool Quit = false;
+
+		/*
+			Resources released while executing a frame are kept until the end of the next one.
+			Only touched by the render thread while it runs.
+		*/
+		std::vector<std::function<void()>> ResourceFreeQueues[2];
+		uint32_t ResourceFreeIndex = 0;
+
+		RenderThread::Statistics Stats;
+	};
+
+	// Kept outside of the data so that resources destroyed during the static destruction can still ask whether the render thread runs
+	static std::atomic<bool> s_Running{false};
+	static Scope<RenderThreadData> s_Data;
+
+	static void ReleaseResources(std::vector<std::function<void()>> &queue)
+	{
+		for (auto &function : queue)
+		{
+			function();
+		}
+		queue.clear();
+	}
+
+	static void RenderThreadLoop()
+	{
+		AK_MEMORY_TAG(Renderer);
+
+		s_Data->Context->MakeCurrent();
+
+		while (true)
+		{
+			uint32_t queueIndex;
+			{
+				std::unique_lock lock(s_Data->Mutex);
+				s_Data->Condition.wait(lock, []()
+															 { return s_Data->FrameInFlight || s_Data->Quit; });
+
+				if (!s_Data->FrameInFlight)
+				{
+					break;
+				}
+
+				// The main thread swapped the queues before handing the frame over
+				queueIndex = s_Data->SubmissionQueueIndex ^ 1;
+			}
+
+			auto start = std::chrono::steady_clock::now();
+
+			RenderCommandQueue &queue = s_Data->CommandQueues[queueIndex];
+			uint32_t commandCount = queue.GetCommandCount();
+			size_t commandMemory = queue.GetUsedMemory();
+			{
+				// AK_PROFILE_SCOPE("RenderThread Frame");
+
+				queue.Execute();
+
+				// The resources released during the previous frame are not referenced by this frame anymore
+				uint32_t previous = s_Data->ResourceFreeIndex ^ 1;
+				ReleaseResources(s_Data->ResourceFreeQueues[previous]);
+				s_Data->ResourceFreeIndex = previous;
+			}
+			float renderTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			{
+				std::lock_guard lock(s_Data->Mutex);
+				s_Data->Stats.RenderTime = renderTime;
+				s_Data->Stats.CommandCount = commandCount;
+				s_Data->Stats.CommandMemory = commandMemory;
+				s_Data->FrameInFlight = false;
+			}
+			s_Data->Condition.notify_all();
+		}
+
+		ReleaseResources(s_Data->ResourceFreeQueues[0]);
+		ReleaseResources(s_Data->ResourceFreeQueues[1]);
+
+		s_Data->Context->DetachCurrent();
+	}
+
+	void RenderThread::Start(GraphicsContext *context)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_CORE_ASSERT(!s_Running, "Render thread already running!");
+		AK_CORE_ASSERT(context, "The render thread needs a graphics context!");
+
+		s_Data = CreateScope<RenderThreadData>();
+		s_Data->Context = context;
+
+		// A context can only be current on one thread at a time
+		context->DetachCurrent();
+
+		s_Data->Thread = std::thread(RenderThreadLoop);
+		s_Data->RenderThreadID = s_Data->Thread.get_id();
+		s_Running = true;
+
+		AK_CORE_INFO("Render thread started");
+	}
+
+	void RenderThread::Stop()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (!s_Running)
+		{
+			return;
+		}
+
+		// Hands over what was recorded since the last frame, then waits for it
+		NextFrame();
+		{
+			std::unique_lock lock(s_Data->Mutex);
+			s_Data->Condition.wait(lock, []()
+														 { return !s_Data->FrameInFlight; });
+			s_Data->Quit = true;
+		}
+		s_Data->Condition.notify_all();
+		s_Data->Thread.join();
+
+		s_Running = false;
+		s_Data->Context->MakeCurrent();
+		s_Data.reset();
+
+		AK_CORE_INFO("Render thread stopped");
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return s_Running.load(std::memory_order_acquire);
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		if (!s_Running.load(std::memory_order_acquire))
+		{
+			return true;
+		}
+		return std::this_thread::get_id() == s_Data->RenderThreadID;
+	}
+
+	void RenderThread::NextFrame()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		auto start = std::chrono::steady_clock::now();
+		{
+			std::unique_lock lock(s_Data->Mutex);
+			s_Data->Condition.wait(lock, []()
+														 { return !s_Data->FrameInFlight; });
+
+			s_Data->Stats.WaitTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+			s_Data->SubmissionQueueIndex ^= 1;
+			s_Data->FrameInFlight = true;
+		}
+		s_Data->Condition.notify_all();
+	}
+
+	bool RenderThread::WaitForFrame(int64_t timeout)
+	{
+		std::unique_lock lock(s_Data->Mutex);
+		return s_Data->Condition.wait_for(lock, std::chrono::nanoseconds(timeout), []()
+																			{ return !s_Data->FrameInFlight; });
+	}
+
+	RenderCommandQueue &RenderThread::GetSubmissionQueue()
+	{
+		return s_Data->CommandQueues[s_Data->SubmissionQueueIndex];
+	}
+
+	void RenderThread::SubmitResourceFree(std::function<void()> function)
+	{
+		if (!s_Running)
+		{
+			function();
+			return;
+		}
+
+		AK_CORE_ASSERT(IsRenderThread(), "Resources are released from render commands!");
+		s_Data->ResourceFreeQueues[s_Data->ResourceFreeIndex].push_back(std::move(function));
+	}
+
+	RenderThread::Statistics RenderThread::GetStats()
+	{
+		if (!s_Running)
+		{
+			return {};
+		}
+
+		std::lock_guard lock(s_Data->Mutex);
+		return s_Data->Stats;
+	}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+#include "Arklumos/Renderer/RenderCommandQueue.h"
+
+#include <functional>
+
+namespace Arklumos
+{
+
+	class GraphicsContext;
+
+	/*
+		Optional thread that owns the graphics context and executes the render commands, one frame behind the main thread.
+
+		There are two command queues: while the render thread executes the commands of frame N, the main thread records the commands of frame N + 1 in the other one.
+		At the end of a frame, NextFrame waits for the render thread to be done with frame N, swaps the queues and lets it start on frame N + 1.
+		So the driver overhead and the wait for the vertical sync of a frame overlap with the simulation of the next one instead of adding to it.
+
+		When the render thread is not running, the main thread owns the context and the commands are executed right away (see Renderer::Submit).
+	*/
+	class RenderThread
+	{
+	public:
+		struct Statistics
+		{
+			// Time spent by the render thread executing the last frame
+			float RenderTime = 0.0f;
+			// Time the main thread waited for the render thread at the end of the last frame
+			float WaitTime = 0.0f;
+			uint32_t CommandCount = 0;
+			size_t CommandMemory = 0;
+		};
+
+		// Moves the graphics context, current on the calling thread, to a new render thread
+		static void Start(GraphicsContext *context);
+
+		// Executes the commands recorded so far, stops the render thread and makes the context current on the calling thread again
+		static void Stop();
+
+		static bool IsRunning();
+
+		// True on the thread that owns the graphics context: the render thread when it is running, the main thread otherwise
+		static bool IsRenderThread();
+
+		// Called by the main thread at the end of each frame
+		static void NextFrame();
+		// Waits at most timeout nanoseconds for the render thread to complete the previous frame, returns whether it did (NextFrame then doesn't wait)
+		static bool WaitForFrame(int64_t timeout);
+
+		// The queue the main thread records the commands of the current frame in
+		static RenderCommandQueue &GetSubmissionQueue();
+
+		/*
+			Deletes a resource once the commands of the next frame have been executed, for the resources the main thread may still reference while recording that frame
+			(a framebuffer texture shown by ImGui, recreated when the viewport is resized). Called from render commands, runs right away when the render thread is not running.
+		*/
+		static void SubmitResourceFree(std::function<void()> function);
+
+		static Statistics GetStats();
+	};
+
+}
@@ -1,24 +1,53 @@
 #include "akpch.h"
 
 #include "Arklumos/Renderer/Renderer.h"
+#include "Arklumos/Core/FrameAllocator.h"
 #include "Arklumos/Renderer/Renderer2D.h"
+#include "Arklumos/Renderer/UniformBuffer.h"
 
 namespace Arklumos
 {
 
 	Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<Renderer::SceneData>();
 
+	// Hashed at compile time
+	static constexpr StringId s_TransformUniform = "u_Transform";
+
+	// Mirrors the Camera block of the shaders
+	struct CameraData
+	{
+		glm::mat4 ViewProjection;
+	};
+
+	static constexpr uint32_t s_CameraDataSize = []()
+	{
+		Std140Layout layout;
+		layout.Add(ShaderDataType::Mat4);
+		return layout.GetSize();
+	}();
+	static_assert(sizeof(CameraData) == s_CameraDataSize, "CameraData doesn't match the std140 layout of the Camera block!");
+
+	static Ref<UniformBuffer> s_CameraUniformBuffer;
+
 	void Renderer::Init()
 	{
 		// AK_PROFILE_FUNCTION();
 
+		AK_MEMORY_TAG(Renderer);
+
 		RenderCommand::Init();
+
+		// Before any shader is linked, so the Camera blocks declared without binding are attached to it
+		s_CameraUniformBuffer = UniformBuffer::Create("Camera", sizeof(CameraData), CameraUniformBinding);
+
 		Renderer2D::Init();
 	}
 
 	void Renderer::Shutdown()
 	{
 		Renderer2D::Shutdown();
+		s_CameraUniformBuffer.reset();
+		ResourceRegistry::Shutdown();
 	}
 
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
@@ -29,22 +58,30 @@ namespace Arklumos
 	void Renderer::BeginScene(OrthographicCamera &camera)
 	{
 		s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
+		UploadCameraData(s_SceneData->ViewProjectionMatrix);
 	}
 
 	void Renderer::EndScene()
 	{
 	}
 
+	void Renderer::UploadCameraData(const glm::mat4 &viewProjection)
+	{
+		CameraData data;
+		data.ViewProjection = viewProjection;
+		Submit([data]()
+					 { s_CameraUniformBuffer->SetData(&data, sizeof(CameraData)); });
+	}
+
 	/*
 		Handle submitting a render command to the graphics card to draw a vertex array using a shader and a transformation matrix.
 		The function takes in a shared pointer to a shader, a shared pointer to a vertex array, and a 4x4 transformation matrix as arguments.
 
 		First, the shader is bound using its Bind method. This ensures that any subsequent draw calls will use this shader for rendering.
 
-		Next, the ViewProjectionMatrix member variable of the s_SceneData struct (which is a static member of the Renderer class) is passed to the shader using the SetMat4 method with the name "u_ViewProjection".
-		This is the combined view and projection matrix for the camera used to view the scene.
+		The combined view and projection matrix of the camera was uploaded to the camera uniform buffer by BeginScene, the shader reads it from its Camera block.
 
-		The transformation matrix passed to the function is also passed to the shader using the SetMat4 method with the name "u_Transform".
+		The transformation matrix passed to the function is passed to the shader using the SetMat4 method with the name "u_Transform".
 		This matrix is typically used to position and orient objects in the scene.
 
 		The vertex array is then bound using its Bind method.
@@ -54,11 +91,28 @@ namespace Arklumos
 	*/
 	void Renderer::Submit(const Ref<Shader> &shader, const Ref<VertexArray> &vertexArray, const glm::mat4 &transform)
 	{
-		shader->Bind();
-		shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
-		shader->SetMat4("u_Transform", transform);
+		Submit([shader, vertexArray, transform]()
+					 {
+			shader->Bind();
+			shader->SetMat4(s_TransformUniform, transform);
 
-		vertexArray->Bind();
-		RenderCommand::DrawIndexed(vertexArray);
+			vertexArray->Bind();
+			RenderCommand::DrawIndexed(vertexArray); });
+	}
+
+	const void *Renderer::CopyForRenderThread(const void *data, uint32_t size)
+	{
+		if (RenderThread::IsRenderThread())
+		{
+			return data;
+		}
+
+		/*
+			The commands of frame N are handed to the render thread at the end of the frame, and the main thread waits for them to be executed
+			before handing over the ones of frame N + 1 (RenderThread::NextFrame), so they are done before the double buffered memory of frame N is reset at the beginning of frame N + 2.
+		*/
+		void *copy = FrameAllocator::AllocateDoubleBuffered(size, RenderCommandQueue::Alignment);
+		memcpy(copy, data, size);
+		return copy;
 	}
 }
\ No newline at end of file
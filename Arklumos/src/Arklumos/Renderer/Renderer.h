@@ -1,9 +1,14 @@
 #pragma once
 
 #include "Arklumos/Renderer/RenderCommand.h"
+#include "Arklumos/Renderer/RenderThread.h"
+#include "Arklumos/Renderer/RenderResource.h"
 
 #include "Arklumos/Renderer/OrthographicCamera.h"
 #include "Arklumos/Renderer/Shader.h"
+
+#include "Arklumos/Core/JobSystem.h"
+
 namespace Arklumos
 {
 
@@ -19,6 +24,73 @@ namespace Arklumos
 
 		static void Submit(const Ref<Shader> &shader, const Ref<VertexArray> &vertexArray, const glm::mat4 &transform = glm::mat4(1.0f));
 
+		/*
+			The camera data is stored in a uniform buffer bound to CameraUniformBinding, which the shaders read through a block:
+
+				layout(std140, binding = 0) uniform Camera
+				{
+					mat4 u_ViewProjection;
+				};
+
+			So it is uploaded once per scene, whatever the number of shaders using it. Submits the upload as a render command.
+		*/
+		static constexpr uint32_t CameraUniformBinding = 0;
+		static void UploadCameraData(const glm::mat4 &viewProjection);
+
+		/*
+			Submits a render command, any function object calling the graphics API.
+			When the render thread runs, the function is moved into the command queue of the frame and executed later by the render thread, so it must capture by value
+			(or only reference data that outlives the frame). Otherwise, or when called from a render command, it is executed right away.
+			Commands are recorded by the main thread only.
+		*/
+		template <typename FuncT>
+		static void Submit(FuncT &&func)
+		{
+			if (RenderThread::IsRenderThread())
+			{
+				func();
+				return;
+			}
+
+			AK_CORE_ASSERT(JobSystem::IsMainThread(), "Render commands can only be submitted from the main thread!");
+
+			using Command = std::decay_t<FuncT>;
+			static_assert(alignof(Command) <= RenderCommandQueue::Alignment, "Render command is over aligned!");
+
+			auto renderCommand = [](void *payload)
+			{
+				Command *command = static_cast<Command *>(payload);
+				(*command)();
+				command->~Command();
+			};
+
+			void *storage = RenderThread::GetSubmissionQueue().Allocate(renderCommand, sizeof(Command));
+			new (storage) Command(std::forward<FuncT>(func));
+		}
+
+		/*
+			Returns a copy of the data that stays valid until the commands of the frame are executed, for the commands that need data the caller is about to overwrite.
+			The copy is made in the double buffered memory of the FrameAllocator, so it is main thread only.
+			Without render thread the commands run right away and the data is returned as is.
+		*/
+		static const void *CopyForRenderThread(const void *data, uint32_t size);
+
+		/*
+			Creates a rendering resource registered in the ResourceRegistry, which gives it a handle.
+			When the last reference is released, the resource stays valid until the end of the frame, then its deletion is submitted as a render command:
+			the commands recorded before still find it alive, and the graphics API is only called from the thread that owns the context.
+		*/
+		template <typename T, typename... Args>
+		static Ref<T> CreateResource(Args &&...args)
+		{
+			static_assert(std::is_base_of_v<RenderResource, T>, "Not a rendering resource!");
+
+			T *resource = new T(std::forward<Args>(args)...);
+			ResourceRegistry::Register(resource);
+			return Ref<T>(resource, [](T *resource)
+										{ ResourceRegistry::Release(resource); });
+		}
+
 		static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 
 	private:
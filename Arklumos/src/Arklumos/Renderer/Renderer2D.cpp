@@ -4,6 +4,7 @@
 #include "Arklumos/Renderer/VertexArray.h"
 #include "Arklumos/Renderer/Shader.h"
 #include "Arklumos/Renderer/RenderCommand.h"
+#include "Arklumos/Renderer/Renderer.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -44,13 +45,17 @@ namespace Arklumos
 			MaxTextureSlots: A constant that defines the maximum number of texture slots available for rendering.
 			QuadVertexArray: A smart pointer to a vertex array object that holds the vertex and index buffers for rendering quads.
 			QuadVertexBuffer: A smart pointer to a vertex buffer object that holds the quad vertex data.
-			TextureShader: A smart pointer to a shader object that is used to render textured quads.
+			TextureShaderVariants: The variants of the shader used to render textured quads, compiled when a batch first needs them.
+			TextureShaders: The variant used for each number of texture slots, with and without the entity ID output (see GetTextureShader).
+			EntityIDOutput: Whether the quads write their entity ID to a second, integer color attachment. Off by default, the editor picks on the CPU and its framebuffer has no such attachment.
 			WhiteTexture: A smart pointer to a texture object that is used as a fallback texture when no other texture is available.
 			QuadIndexCount: The number of quad indices currently used.
 			QuadVertexBufferBase: A pointer to the beginning of the quad vertex buffer.
 			QuadVertexBufferPtr: A pointer to the current position in the quad vertex buffer.
-			TextureSlots: An array of smart pointers to texture objects used for rendering textured quads.
+			TextureSlots: An array of pointers to the texture objects used by the current batch (see TextureSlotCache for their lifetime).
 			TextureSlotIndex: The index of the next available texture slot.
+			TextureSlotCache: The slot of each texture in the current batch, indexed by the index of the texture handle.
+			BatchIndex: Incremented by each batch, invalidates the entries of TextureSlotCache written by the previous ones.
 			QuadVertexPositions: An array that holds the positions of the vertices of a quad.
 			Stats: A struct that holds statistics about the renderer's performance.
 	*/
@@ -61,18 +66,35 @@ namespace Arklumos
 		static const uint32_t MaxIndices = MaxQuads * 6;
 		static const uint32_t MaxTextureSlots = 32; // TODO: RenderCaps
 
+		// A batch is drawn with the variant of the texture shader having the fewest texture slots it fits in
+		static constexpr std::array<uint32_t, 4> TextureSlotVariants = {1, 8, 16, MaxTextureSlots};
+
 		Ref<VertexArray> QuadVertexArray;
 		Ref<VertexBuffer> QuadVertexBuffer;
-		Ref<Shader> TextureShader;
+		ShaderVariantCache TextureShaderVariants;
+		std::array<std::array<Shader *, TextureSlotVariants.size()>, 2> TextureShaders = {};
+		bool EntityIDOutput = false;
 		Ref<Texture2D> WhiteTexture;
 
 		uint32_t QuadIndexCount = 0;
 		QuadVertex *QuadVertexBufferBase = nullptr;
 		QuadVertex *QuadVertexBufferPtr = nullptr;
 
-		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
+		/*
+			Raw pointers: a texture released during the frame is only deleted at its end (see ResourceRegistry), after the commands of the batches using it.
+			So filling a slot doesn't copy a Ref, and finding the slot of a texture is a lookup in a table instead of a comparison with each slot.
+		*/
+		std::array<Texture2D *, MaxTextureSlots> TextureSlots;
 		uint32_t TextureSlotIndex = 1; // 0 = white texture
 
+		struct TextureSlotCacheEntry
+		{
+			uint32_t Batch = 0;
+			uint32_t Slot = 0;
+		};
+		std::vector<TextureSlotCacheEntry> TextureSlotCache;
+		uint32_t BatchIndex = 0;
+
 		glm::vec4 QuadVertexPositions[4];
 
 		Renderer2D::Statistics Stats;
@@ -80,10 +102,45 @@ namespace Arklumos
 
 	static Renderer2DData s_Data;
 
+	/*
+		The variant of the texture shader for a batch using textureCount slots. A fragment only goes through the cases of the switch of its variant,
+		so a batch of colored quads doesn't pay for 32 texture slots.
+
+		Called by the render commands: the variant is compiled the first time a batch needs it, on the thread owning the graphics context.
+	*/
+	static Shader *GetTextureShader(uint32_t textureCount, bool entityIDOutput)
+	{
+		uint32_t variant = 0;
+		while (Renderer2DData::TextureSlotVariants[variant] < textureCount)
+		{
+			variant++;
+		}
+
+		Shader *&shader = s_Data.TextureShaders[entityIDOutput][variant];
+		if (!shader)
+		{
+			uint32_t slotCount = Renderer2DData::TextureSlotVariants[variant];
+			shader = s_Data.TextureShaderVariants.Get({{"MAX_TEXTURE_SLOTS", std::to_string(slotCount)},
+																								 {"ENTITY_ID_OUTPUT", entityIDOutput ? "1" : "0"}})
+									 .get();
+
+			int32_t samplers[Renderer2DData::MaxTextureSlots];
+			for (uint32_t i = 0; i < slotCount; i++)
+			{
+				samplers[i] = i;
+			}
+			shader->Bind();
+			shader->SetIntArray("u_Textures", samplers, slotCount);
+		}
+		return shader;
+	}
+
 	void Renderer2D::Init()
 	{
 		// AK_PROFILE_FUNCTION();
 
+		AK_MEMORY_TAG(Renderer);
+
 		s_Data.QuadVertexArray = VertexArray::Create();
 
 		/*
@@ -163,34 +220,17 @@ namespace Arklumos
 		s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
 
 		/*
-			Initializes an integer array called samplers with values from 0 to s_Data.MaxTextureSlots - 1.
-			The purpose of this array is to be used as an argument when binding multiple textures to the shader.
-			Each element of the array represents a texture unit, which is a location in the GPU where a texture can be bound.
-			The value of each element represents the index of the texture unit.
-			By initializing the array with consecutive integers starting from 0, each element represents a unique texture unit
-		*/
-		int32_t samplers[s_Data.MaxTextureSlots];
-		for (uint32_t i = 0; i < s_Data.MaxTextureSlots; i++)
-		{
-			samplers[i] = i;
-		}
-
-		/*
-			Creates a new shader program by loading the shader source code from a file named "Texture.glsl" located in the "assets/shaders/" directory. The newly created shader program is then bound for use.
-
-			Next, an integer array samplers of size s_Data.MaxTextureSlots is created, where each element is initialized to its own index value.
-			Then, the integer array samplers is passed to the shader program's uniform u_Textures as an integer array.
+			The texture shader is loaded from the file "Texture.glsl" located in the "assets/shaders/" directory, in several variants: one per number of texture slots
+			(MAX_TEXTURE_SLOTS), with or without the entity ID output (ENTITY_ID_OUTPUT). Each variant is compiled the first time a batch uses it (see GetTextureShader),
+			and its sampler array u_Textures is then set to the texture units 0 to MAX_TEXTURE_SLOTS - 1.
 
-			This allows the shader program to access multiple textures using texture units. Each element in the samplers array represents a texture unit, which can be used to bind textures to that unit.
 			When a texture is bound to a specific texture unit, the integer value representing that texture unit is passed as the TexIndex value of the QuadVertex struct for each vertex.
 			This way, the shader program can look up the correct texture for each vertex based on its TexIndex value
 		*/
-		s_Data.TextureShader = Shader::Create("assets/shaders/Texture.glsl");
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetIntArray("u_Textures", samplers, s_Data.MaxTextureSlots);
+		s_Data.TextureShaderVariants = ShaderVariantCache("assets/shaders/Texture.glsl");
 
 		// Set first texture slot to 0
-		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
+		s_Data.TextureSlots[0] = s_Data.WhiteTexture.get();
 
 		/*
 			Initializes the QuadVertexPositions array in the Renderer2DData struct with the positions of the vertices of a quad.
@@ -219,16 +259,20 @@ namespace Arklumos
 		delete[] s_Data.QuadVertexBufferBase;
 	}
 
+	void Renderer2D::SetEntityIDOutput(bool enabled)
+	{
+		s_Data.EntityIDOutput = enabled;
+	}
+
 	/*
-		Begins a new rendering scene with the given OrthographicCamera by binding the texture shader and setting the view projection matrix uniform to the view projection matrix of the given camera.
+		Begins a new rendering scene with the given OrthographicCamera by uploading its view projection matrix to the camera uniform buffer (shared with the other shaders, see Renderer::UploadCameraData).
 
 	*/
 	void Renderer2D::BeginScene(const OrthographicCamera &camera)
 	{
 		// AK_PROFILE_FUNCTION();
 
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", camera.GetViewProjectionMatrix());
+		Renderer::UploadCameraData(camera.GetViewProjectionMatrix());
 
 		StartBatch();
 	}
@@ -239,8 +283,7 @@ namespace Arklumos
 
 		glm::mat4 viewProj = camera.GetProjection() * glm::inverse(transform);
 
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+		Renderer::UploadCameraData(viewProj);
 
 		StartBatch();
 	}
@@ -251,8 +294,7 @@ namespace Arklumos
 
 		glm::mat4 viewProj = camera.GetViewProjection();
 
-		s_Data.TextureShader->Bind();
-		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
+		Renderer::UploadCameraData(viewProj);
 
 		StartBatch();
 	}
@@ -285,6 +327,13 @@ namespace Arklumos
 		s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
 
 		s_Data.TextureSlotIndex = 1;
+
+		// The entries of the cache are only valid for the batch they were written in, when the counter wraps around they are all cleared
+		if (++s_Data.BatchIndex == 0)
+		{
+			std::fill(s_Data.TextureSlotCache.begin(), s_Data.TextureSlotCache.end(), Renderer2DData::TextureSlotCacheEntry());
+			s_Data.BatchIndex = 1;
+		}
 	}
 
 	/*
@@ -307,16 +356,34 @@ namespace Arklumos
 			return; // Nothing to draw
 		}
 
+		AK_MEMORY_TAG(Renderer);
+
+		/*
+			The vertices are written again by the next batch right after this call, so the command gets its own copy of them (when the render thread runs)
+			along with the textures of the batch and the number of indices.
+		*/
 		uint32_t dataSize = (uint32_t)((uint8_t *)s_Data.QuadVertexBufferPtr - (uint8_t *)s_Data.QuadVertexBufferBase);
-		s_Data.QuadVertexBuffer->SetData(s_Data.QuadVertexBufferBase, dataSize);
+		const void *vertices = Renderer::CopyForRenderThread(s_Data.QuadVertexBufferBase, dataSize);
 
-		// Bind textures
-		for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
-		{
-			s_Data.TextureSlots[i]->Bind(i);
-		}
+		uint32_t indexCount = s_Data.QuadIndexCount;
+		uint32_t textureCount = s_Data.TextureSlotIndex;
+		std::array<Texture2D *, Renderer2DData::MaxTextureSlots> textures = s_Data.TextureSlots;
+		bool entityIDOutput = s_Data.EntityIDOutput;
+
+		Renderer::Submit([vertices, dataSize, indexCount, textureCount, textures, entityIDOutput]()
+										 {
+			// The vertex array of s_Data is created by Init and never replaced, and the shader variants are only used by the render commands, so they can use them directly
+			GetTextureShader(textureCount, entityIDOutput)->Bind();
+			s_Data.QuadVertexBuffer->SetData(vertices, dataSize);
+
+			// Bind textures
+			for (uint32_t i = 0; i < textureCount; i++)
+			{
+				textures[i]->Bind(i);
+			}
+
+			RenderCommand::DrawIndexed(s_Data.QuadVertexArray, indexCount); });
 
-		RenderCommand::DrawIndexed(s_Data.QuadVertexArray, s_Data.QuadIndexCount);
 		s_Data.Stats.DrawCalls++;
 	}
 
@@ -430,23 +497,22 @@ namespace Arklumos
 		/*
 			Determine the texture slot index of a given texture.
 
-			The textureIndex variable is initialized to 0.0f, which corresponds to the first texture slot index.
-			Then, a loop is used to iterate over all the texture slots in the s_Data struct, starting from index 1 (since index 0 is always reserved for the white texture).
-
-			For each texture slot, the code checks whether the texture pointer stored in the texture slot is equal to the pointer of the given texture parameter.
-			If the two pointers are equal, it means that the texture has already been added to the texture slots and its index can be determined by subtracting 1 from the texture slot index (since the first slot is reserved for the white texture).
-			The index is then stored in the textureIndex variable and the loop is exited using the break statement.
+			The slot of a texture is stored in s_Data.TextureSlotCache at the index of its handle, along with the batch it was assigned in.
+			If the entry was written by the current batch, the texture already has a slot and textureIndex is set to it.
 
-			If the texture is not found in the existing texture slots, the textureIndex remains at its initial value of 0.0f, indicating that a new texture slot needs to be created for this texture.
+			Otherwise textureIndex remains at its initial value of 0.0f (the white texture), indicating that a new texture slot needs to be created for this texture.
 		*/
+		uint32_t handleIndex = texture->GetHandle().GetIndex();
+		if (handleIndex >= s_Data.TextureSlotCache.size())
+		{
+			s_Data.TextureSlotCache.resize(handleIndex + 1);
+		}
+
 		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+		const Renderer2DData::TextureSlotCacheEntry &cacheEntry = s_Data.TextureSlotCache[handleIndex];
+		if (cacheEntry.Batch == s_Data.BatchIndex)
 		{
-			if (*s_Data.TextureSlots[i] == *texture)
-			{
-				textureIndex = (float)i;
-				break;
-			}
+			textureIndex = (float)cacheEntry.Slot;
 		}
 
 		/*
@@ -465,7 +531,8 @@ namespace Arklumos
 			}
 
 			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
+			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture.get();
+			s_Data.TextureSlotCache[handleIndex] = {s_Data.BatchIndex, s_Data.TextureSlotIndex};
 			s_Data.TextureSlotIndex++;
 		}
 
@@ -537,7 +604,40 @@ namespace Arklumos
 
 	void Renderer2D::DrawSprite(const glm::mat4 &transform, SpriteRendererComponent &src, int entityID)
 	{
-		DrawQuad(transform, src.Color, entityID);
+		if (src.Texture)
+		{
+			DrawQuad(transform, src.Texture, 1.0f, src.Color, entityID);
+		}
+		else
+		{
+			DrawQuad(transform, src.Color, entityID);
+		}
+	}
+
+	void Renderer2D::DrawRenderList(const RenderList &renderList)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_MEMORY_TAG(Renderer);
+
+		AK_CORE_ASSERT(renderList.DrawOrder.size() == renderList.Size(), "The render list has not been sorted!");
+
+		/*
+			Single pass over the extracted data. The list only contains plain data (matrices, colors, indices),
+			so this loop doesn't touch the registry and reads the arrays in the sorted order.
+		*/
+		for (uint32_t index : renderList.DrawOrder)
+		{
+			uint32_t textureIndex = renderList.TextureIndices[index];
+			if (textureIndex == RenderList::NoTexture)
+			{
+				DrawQuad(renderList.Transforms[index], renderList.Colors[index], renderList.EntityIDs[index]);
+			}
+			else
+			{
+				DrawQuad(renderList.Transforms[index], renderList.Textures[textureIndex], 1.0f, renderList.Colors[index], renderList.EntityIDs[index]);
+			}
+		}
 	}
 
 	void Renderer2D::ResetStats()
@@ -3,6 +3,7 @@
 #include "Arklumos/Renderer/OrthographicCamera.h"
 
 #include "Arklumos/Renderer/Texture.h"
+#include "Arklumos/Renderer/RenderList.h"
 
 #include "Arklumos/Renderer/Camera.h"
 #include "Arklumos/Renderer/EditorCamera.h"
@@ -18,6 +19,9 @@ namespace Arklumos
 		static void Init();
 		static void Shutdown();
 
+		// Writes the entity ID of the quads to a second, integer color attachment, for an application rendering to a framebuffer that has one. Disabled by default
+		static void SetEntityIDOutput(bool enabled);
+
 		static void BeginScene(const Camera &camera, const glm::mat4 &transform);
 		static void BeginScene(const EditorCamera &camera);
 		static void BeginScene(const OrthographicCamera &camera); // TODO: Remove
@@ -40,6 +44,9 @@ namespace Arklumos
 
 		static void DrawSprite(const glm::mat4 &transform, SpriteRendererComponent &src, int entityID);
 
+		// Draws every item of the list, in the order given by RenderList::DrawOrder (call RenderList::Sort first)
+		static void DrawRenderList(const RenderList &renderList);
+
 		// Stats
 		struct Statistics
 		{
@@ -2,12 +2,19 @@
 #include "Arklumos/Renderer/Shader.h"
 
 #include "Arklumos/Renderer/Renderer.h"
+#include "Arklumos/Renderer/ShaderHotReload.h"
+#include "Arklumos/Renderer/ShaderPreprocessor.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
+#include <mutex>
+
 namespace Arklumos
 {
 
-	Ref<Shader> Shader::Create(const std::string &filepath)
+	static std::mutex s_CacheStatsMutex;
+	static Shader::CacheStatistics s_CacheStats;
+
+	Ref<Shader> Shader::Create(const std::string &filepath, const ShaderDefines &defines)
 	{
 		switch (Renderer::GetAPI())
 		{
@@ -16,7 +23,11 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLShader>(filepath);
+		{
+			Ref<Shader> shader = Renderer::CreateResource<OpenGLShader>(filepath, defines);
+			ShaderHotReload::Register(shader.get());
+			return shader;
+		}
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -32,13 +43,33 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+			return Renderer::CreateResource<OpenGLShader>(name, vertexSrc, fragmentSrc);
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
 
+	Shader::CacheStatistics Shader::GetCacheStats()
+	{
+		std::lock_guard lock(s_CacheStatsMutex);
+		return s_CacheStats;
+	}
+
+	void Shader::RecordCacheHit(double milliseconds)
+	{
+		std::lock_guard lock(s_CacheStatsMutex);
+		s_CacheStats.Hits++;
+		s_CacheStats.LoadTime += milliseconds;
+	}
+
+	void Shader::RecordCacheMiss(double milliseconds)
+	{
+		std::lock_guard lock(s_CacheStatsMutex);
+		s_CacheStats.Misses++;
+		s_CacheStats.CompileTime += milliseconds;
+	}
+
 	void ShaderLibrary::Add(const std::string &name, const Ref<Shader> &shader)
 	{
 		AK_CORE_ASSERT(!Exists(name), "Shader already exists!");
@@ -65,15 +96,31 @@ namespace Arklumos
 		return shader;
 	}
 
-	Ref<Shader> ShaderLibrary::Get(const std::string &name)
+	Ref<Shader> ShaderLibrary::Get(StringId name)
 	{
 		AK_CORE_ASSERT(Exists(name), "Shader not found!");
 		return m_Shaders[name];
 	}
 
-	bool ShaderLibrary::Exists(const std::string &name) const
+	bool ShaderLibrary::Exists(StringId name) const
 	{
 		return m_Shaders.find(name) != m_Shaders.end();
 	}
 
+	ShaderVariantCache::ShaderVariantCache(const std::string &filepath)
+			: m_Filepath(filepath)
+	{
+	}
+
+	const Ref<Shader> &ShaderVariantCache::Get(const ShaderDefines &defines)
+	{
+		std::string variantName = ShaderPreprocessor::GetVariantName(m_Filepath, defines);
+		Ref<Shader> &shader = m_Variants[StringId::Hash(variantName.data(), variantName.size())];
+		if (!shader)
+		{
+			shader = Shader::Create(m_Filepath, defines);
+		}
+		return shader;
+	}
+
 }
\ No newline at end of file
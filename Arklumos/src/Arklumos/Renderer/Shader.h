@@ -2,32 +2,70 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
+#include "Arklumos/Core/StringId.h"
+#include "Arklumos/Renderer/RenderResource.h"
+
 namespace Arklumos
 {
 
-	class Shader
+	// Added to each stage of a shader variant as "#define Name Value" (see ShaderPreprocessor)
+	struct ShaderDefine
+	{
+		std::string Name;
+		std::string Value;
+	};
+
+	using ShaderDefines = std::vector<ShaderDefine>;
+
+	class Shader : public RenderResource
 	{
 	public:
 		virtual ~Shader() = default;
 
-		virtual void Bind() const = 0;
+		ResourceHandle<Shader> GetHandle() const { return ResourceHandle<Shader>(GetHandleValue()); }
+
+		// Completes the compilation of the program first if it is done, or waits for it when there is no previous program to draw with (see OpenGLShader)
+		virtual void Bind() = 0;
 		virtual void Unbind() const = 0;
 
-		virtual void SetInt(const std::string &name, int value) = 0;
-		virtual void SetIntArray(const std::string &name, int *values, uint32_t count) = 0;
-		virtual void SetFloat(const std::string &name, float value) = 0;
-		virtual void SetFloat2(const std::string &name, const glm::vec2 &value) = 0;
-		virtual void SetFloat3(const std::string &name, const glm::vec3 &value) = 0;
-		virtual void SetFloat4(const std::string &name, const glm::vec4 &value) = 0;
-		virtual void SetMat4(const std::string &name, const glm::mat4 &value) = 0;
+		// The uniforms are identified by a StringId: a literal is hashed at compile time, the location is then found in a table filled when the shader is linked
+		virtual void SetInt(StringId name, int value) = 0;
+		virtual void SetIntArray(StringId name, int *values, uint32_t count) = 0;
+		virtual void SetFloat(StringId name, float value) = 0;
+		virtual void SetFloat2(StringId name, const glm::vec2 &value) = 0;
+		virtual void SetFloat3(StringId name, const glm::vec3 &value) = 0;
+		virtual void SetFloat4(StringId name, const glm::vec4 &value) = 0;
+		virtual void SetMat4(StringId name, const glm::mat4 &value) = 0;
 
 		virtual const std::string &GetName() const = 0;
 
-		static Ref<Shader> Create(const std::string &filepath);
+		// The file of the shader and the files it includes, empty for a shader built from strings
+		virtual const std::vector<std::string> &GetSourceFiles() const = 0;
+
+		// Reads the source files again and compiles them, the previous program stays in use until the new one is ready (see ShaderHotReload)
+		virtual void Reload() = 0;
+
+		static Ref<Shader> Create(const std::string &filepath, const ShaderDefines &defines = {});
 		static Ref<Shader> Create(const std::string &name, const std::string &vertexSrc, const std::string &fragmentSrc);
+
+		// Programs loaded from the binary cache and programs compiled from their sources since the start, with the time spent (in milliseconds)
+		struct CacheStatistics
+		{
+			uint32_t Hits = 0;
+			uint32_t Misses = 0;
+			double LoadTime = 0.0;
+			double CompileTime = 0.0;
+		};
+
+		static CacheStatistics GetCacheStats();
+
+	protected:
+		static void RecordCacheHit(double milliseconds);
+		static void RecordCacheMiss(double milliseconds);
 	};
 
 	class ShaderLibrary
@@ -38,12 +76,33 @@ namespace Arklumos
 		Ref<Shader> Load(const std::string &filepath);
 		Ref<Shader> Load(const std::string &name, const std::string &filepath);
 
-		Ref<Shader> Get(const std::string &name);
+		Ref<Shader> Get(StringId name);
+
+		bool Exists(StringId name) const;
+
+	private:
+		std::unordered_map<StringId, Ref<Shader>> m_Shaders;
+	};
+
+	/*
+		The specialized variants of a shader file, each one compiled with its defines the first time it is requested, then kept.
+		The defines are expected in the same order for the same variant (they are part of its name and of its key).
+
+		Get creates the shader, so it is called where the graphics API can be used: inside a render command when the render thread runs.
+	*/
+	class ShaderVariantCache
+	{
+	public:
+		ShaderVariantCache() = default;
+		ShaderVariantCache(const std::string &filepath);
+
+		const Ref<Shader> &Get(const ShaderDefines &defines);
 
-		bool Exists(const std::string &name) const;
+		uint32_t GetVariantCount() const { return (uint32_t)m_Variants.size(); }
 
 	private:
-		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+		std::string m_Filepath;
+		std::unordered_map<uint64_t, Ref<Shader>> m_Variants;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/ShaderHotReload.h"
+
+#include "Arklumos/Core/FileWatcher.h"
+#include "Arklumos/Renderer/Renderer.h"
+#include "Arklumos/Renderer/Shader.h"
+
+#include <mutex>
+
+namespace Arklumos
+{
+
+	struct ShaderHotReloadData
+	{
+		Scope<FileWatcher> Watcher;
+
+		// Registered from the thread creating the shaders (the render thread for the lazy variants), read by the main thread
+		std::mutex Mutex;
+		struct ShaderEntry
+		{
+			uint32_t Handle = 0;
+			std::vector<std::string> SourceFiles;
+		};
+		std::vector<ShaderEntry> Shaders;
+	};
+
+	static ShaderHotReloadData s_Data;
+
+	void ShaderHotReload::Init(const std::string &directory)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		s_Data.Watcher = CreateScope<FileWatcher>(directory);
+		AK_CORE_INFO("Shader hot reload: watching '{0}'", s_Data.Watcher->GetDirectory());
+	}
+
+	void ShaderHotReload::Shutdown()
+	{
+		s_Data.Watcher.reset();
+
+		std::lock_guard lock(s_Data.Mutex);
+		s_Data.Shaders.clear();
+	}
+
+	void ShaderHotReload::Register(Shader *shader)
+	{
+		const std::vector<std::string> &sourceFiles = shader->GetSourceFiles();
+		uint32_t handle = shader->GetHandleValue();
+		if (sourceFiles.empty() || handle == 0)
+		{
+			return;
+		}
+
+		std::lock_guard lock(s_Data.Mutex);
+		for (ShaderHotReloadData::ShaderEntry &entry : s_Data.Shaders)
+		{
+			if (entry.Handle == handle)
+			{
+				entry.SourceFiles = sourceFiles;
+				return;
+			}
+		}
+		s_Data.Shaders.push_back({handle, sourceFiles});
+	}
+
+	bool ShaderHotReload::Update()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (!s_Data.Watcher)
+		{
+			return false;
+		}
+
+		std::vector<std::string> writtenFiles = s_Data.Watcher->Poll();
+		if (writtenFiles.empty())
+		{
+			return false;
+		}
+
+		std::vector<Shader *> shaders;
+		{
+			std::lock_guard lock(s_Data.Mutex);
+
+			auto &entries = s_Data.Shaders;
+			for (auto it = entries.begin(); it != entries.end();)
+			{
+				// Null once the shader was deleted: its slot was freed at the end of the frame it was released in
+				Shader *shader = ResourceRegistry::Get(ResourceHandle<Shader>(it->Handle));
+				if (!shader)
+				{
+					it = entries.erase(it);
+					continue;
+				}
+
+				for (const std::string &file : writtenFiles)
+				{
+					if (std::find(it->SourceFiles.begin(), it->SourceFiles.end(), file) != it->SourceFiles.end())
+					{
+						shaders.push_back(shader);
+						break;
+					}
+				}
+				++it;
+			}
+		}
+
+		/*
+			Outside of the lock: without render thread the command runs right away, and the shader registers its new source files.
+			A shader released during this frame is only deleted after the commands of the frame, the pointer is valid in the command.
+		*/
+		for (Shader *shader : shaders)
+		{
+			AK_CORE_INFO("Shader hot reload: reloading '{0}'", shader->GetName());
+			Renderer::Submit([shader]()
+											 { shader->Reload(); });
+		}
+		return !shaders.empty();
+	}
+
+}
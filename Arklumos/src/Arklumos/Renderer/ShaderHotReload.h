@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+namespace Arklumos
+{
+
+	class Shader;
+
+	/*
+		Reloads the shaders whose source files (their file or a file they include) are written, while the application runs.
+
+		Update is called by the main thread once per frame: it polls a FileWatcher on the shader directory and submits a render command
+		reloading each shader built from a written file. The shader starts compiling its new sources and keeps drawing with its previous program
+		until the new one is linked (see OpenGLShader), so editing a shader doesn't stall the frames. A shader that fails to compile keeps its previous program.
+
+		The shaders are referenced by their handles, so a shader released in the meantime is skipped instead of being reloaded after its deletion.
+	*/
+	class ShaderHotReload
+	{
+	public:
+		static void Init(const std::string &directory);
+		static void Shutdown();
+
+		// Adds the shader or updates its source files (after a reload, the includes can change). Called from any thread, the shader must have a handle
+		static void Register(Shader *shader);
+
+		// Returns whether shaders are reloaded this frame
+		static bool Update();
+	};
+
+}
@@ -0,0 +1,149 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/ShaderPreprocessor.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Arklumos
+{
+
+	static bool ReadSourceFile(const std::filesystem::path &path, std::string &result)
+	{
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		if (!in)
+		{
+			return false;
+		}
+
+		std::stringstream content;
+		content << in.rdbuf();
+		result = content.str();
+		return true;
+	}
+
+	// The quoted path of an #include line, empty when the line isn't one
+	static std::string ParseInclude(const std::string &line)
+	{
+		size_t begin = line.find_first_not_of(" \t");
+		if (begin == std::string::npos || line.compare(begin, 8, "#include") != 0)
+		{
+			return {};
+		}
+
+		size_t openingQuote = line.find('"', begin + 8);
+		size_t closingQuote = openingQuote == std::string::npos ? std::string::npos : line.find('"', openingQuote + 1);
+		if (closingQuote == std::string::npos)
+		{
+			AK_CORE_ERROR("Shader preprocessor: malformed include '{0}'", line);
+			return {};
+		}
+		return line.substr(openingQuote + 1, closingQuote - openingQuote - 1);
+	}
+
+	static void AppendWithIncludes(std::string &result, const std::string &source, const std::filesystem::path &filepath, std::unordered_set<std::string> &includedFiles)
+	{
+		size_t lineBegin = 0;
+		while (lineBegin < source.size())
+		{
+			size_t lineEnd = source.find('\n', lineBegin);
+			lineEnd = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+			std::string line = source.substr(lineBegin, lineEnd - lineBegin);
+			lineBegin = lineEnd;
+
+			std::string include = ParseInclude(line);
+			if (include.empty())
+			{
+				result += line;
+				continue;
+			}
+
+			std::filesystem::path includePath = (filepath.parent_path() / include).lexically_normal();
+			if (!includedFiles.insert(includePath.generic_string()).second)
+			{
+				continue;
+			}
+
+			std::string includeSource;
+			if (!ReadSourceFile(includePath, includeSource))
+			{
+				AK_CORE_ERROR("Shader preprocessor: could not open '{0}' included by '{1}'", includePath.generic_string(), filepath.generic_string());
+				continue;
+			}
+
+			AppendWithIncludes(result, includeSource, includePath, includedFiles);
+			if (!result.empty() && result.back() != '\n')
+			{
+				result += '\n';
+			}
+		}
+	}
+
+	std::string ShaderPreprocessor::ResolveIncludes(const std::string &source, const std::string &filepath, std::vector<std::string> *sourceFiles)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		std::filesystem::path path = std::filesystem::path(filepath).lexically_normal();
+		std::unordered_set<std::string> includedFiles = {path.generic_string()};
+
+		std::string result;
+		result.reserve(source.size());
+		AppendWithIncludes(result, source, path, includedFiles);
+
+		if (sourceFiles)
+		{
+			sourceFiles->assign(includedFiles.begin(), includedFiles.end());
+		}
+		return result;
+	}
+
+	std::string ShaderPreprocessor::InjectDefines(const std::string &source, const ShaderDefines &defines)
+	{
+		if (defines.empty())
+		{
+			return source;
+		}
+
+		std::string defineLines;
+		for (const ShaderDefine &define : defines)
+		{
+			defineLines += "#define " + define.Name + " " + define.Value + "\n";
+		}
+
+		// Nothing but comments can come before #version
+		size_t version = source.find("#version");
+		if (version == std::string::npos)
+		{
+			return defineLines + source;
+		}
+
+		size_t lineEnd = source.find('\n', version);
+		if (lineEnd == std::string::npos)
+		{
+			return source + "\n" + defineLines;
+		}
+
+		std::string result = source;
+		result.insert(lineEnd + 1, defineLines);
+		return result;
+	}
+
+	std::string ShaderPreprocessor::GetVariantName(const std::string &name, const ShaderDefines &defines)
+	{
+		if (defines.empty())
+		{
+			return name;
+		}
+
+		std::string result = name + "(";
+		for (size_t i = 0; i < defines.size(); i++)
+		{
+			result += (i > 0 ? "," : "") + defines[i].Name;
+			if (!defines[i].Value.empty())
+			{
+				result += "=" + defines[i].Value;
+			}
+		}
+		return result + ")";
+	}
+
+}
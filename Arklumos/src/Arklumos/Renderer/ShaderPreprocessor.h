@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Arklumos/Renderer/Shader.h"
+
+#include <string>
+#include <vector>
+
+namespace Arklumos
+{
+
+	/*
+		Text transformations applied to the shader sources before they are split into stages and compiled, independent of the graphics API.
+
+			#include "Common/Camera.glsl"
+
+		is replaced by the content of the file, found relative to the file including it. A file is only included once per shader (like with #pragma once),
+		so two headers can include the same one, and a cycle stops instead of recursing forever.
+
+		The defines of a variant are added to each stage right after its #version line, the sources test them with #if / #ifdef
+		and give them a default value, so the file still compiles without defines.
+	*/
+	class ShaderPreprocessor
+	{
+	public:
+		// The includes are resolved on the whole file, the files included can't contain #type lines. sourceFiles receives the file and the files it included (normalized paths)
+		static std::string ResolveIncludes(const std::string &source, const std::string &filepath, std::vector<std::string> *sourceFiles = nullptr);
+
+		static std::string InjectDefines(const std::string &source, const ShaderDefines &defines);
+
+		// "Texture(MAX_TEXTURE_SLOTS=8,ENTITY_ID_OUTPUT=0)", or the name itself without defines. Names the shader in the logs and in the program cache
+		static std::string GetVariantName(const std::string &name, const ShaderDefines &defines);
+	};
+
+}
@@ -15,7 +15,7 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLTexture2D>(width, height);
+			return Renderer::CreateResource<OpenGLTexture2D>(width, height);
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -31,7 +31,7 @@ namespace Arklumos
 			return nullptr;
 
 		case RendererAPI::API::OpenGL:
-			return CreateRef<OpenGLTexture2D>(path);
+			return Renderer::CreateResource<OpenGLTexture2D>(path);
 		}
 
 		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
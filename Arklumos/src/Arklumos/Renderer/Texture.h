@@ -3,15 +3,18 @@
 #include <string>
 
 #include "Arklumos/Core/Base.h"
+#include "Arklumos/Renderer/RenderResource.h"
 
 namespace Arklumos
 {
 
-	class Texture
+	class Texture : public RenderResource
 	{
 	public:
 		virtual ~Texture() = default;
 
+		ResourceHandle<Texture> GetHandle() const { return ResourceHandle<Texture>(GetHandleValue()); }
+
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 		virtual uint32_t GetRendererID() const = 0;
@@ -20,7 +23,11 @@ namespace Arklumos
 
 		virtual void Bind(uint32_t slot = 0) const = 0;
 
-		virtual bool operator==(const Texture &other) const = 0;
+		// False while a texture of the TextureLoader is loading (it binds the placeholder), read from any thread
+		virtual bool IsLoaded() const = 0;
+
+		// The textures are created by Renderer::CreateResource, so two textures are the same when their handles are
+		bool operator==(const Texture &other) const { return GetHandle() == other.GetHandle(); }
 	};
 
 	class Texture2D : public Texture
@@ -0,0 +1,255 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/TextureLoader.h"
+
+#include "Arklumos/Core/JobSystem.h"
+#include "Arklumos/Renderer/FramePacer.h"
+#include "Arklumos/Renderer/Renderer.h"
+#include "Arklumos/Renderer/TextureUploader.h"
+
+#include <stb_image.h>
+
+#include <deque>
+#include <mutex>
+
+namespace Arklumos
+{
+
+	TextureImage::~TextureImage()
+	{
+		stbi_image_free(Pixels);
+	}
+
+	struct TextureLoadRequest
+	{
+		Ref<Texture2D> Texture;
+		std::string Path;
+		TextureLoader::LoadCallback Callback;
+
+		// Written by the decode job, null when the image couldn't be loaded
+		Ref<TextureImage> Image;
+		// Rows submitted so far
+		uint32_t UploadedRows = 0;
+	};
+
+	struct TextureLoaderData
+	{
+		TextureLoaderSpecification Specification;
+		Scope<TextureUploader> Uploader;
+		Ref<Texture2D> Placeholder;
+
+		JobCounter DecodeJobs;
+
+		// Pushed by the decode jobs, taken by the main thread
+		std::mutex DecodedMutex;
+		std::vector<Ref<TextureLoadRequest>> Decoded;
+
+		// Main thread only: uploaded in order, one band of rows after the other
+		std::deque<Ref<TextureLoadRequest>> Uploads;
+		TextureLoader::Progress Progress;
+	};
+
+	static TextureLoaderData s_Data;
+
+	float TextureLoader::Progress::GetFraction() const
+	{
+		if (Requested == 0)
+		{
+			return 1.0f;
+		}
+		return (0.5f * (Decoded + Loaded + Cancelled) + Failed) / Requested;
+	}
+
+	void TextureLoader::Init(const TextureLoaderSpecification &specification)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		s_Data.Specification = specification;
+
+		// One segment per frame the GPU can still be reading, plus the one of the frame being recorded
+		s_Data.Uploader = TextureUploader::Create(specification.UploadBudget, FramePacer::GetMaxFramesInFlight() + 1);
+
+		s_Data.Placeholder = Texture2D::Create(1, 1);
+		uint32_t whiteTextureData = 0xffffffff;
+		s_Data.Placeholder->SetData(&whiteTextureData, sizeof(uint32_t));
+
+		// The flag is global in stb_image, it is set once here rather than by each job (OpenGLTexture2D sets the same value)
+		stbi_set_flip_vertically_on_load(1);
+	}
+
+	void TextureLoader::Shutdown()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (!s_Data.Uploader)
+		{
+			return;
+		}
+
+		JobSystem::Wait(s_Data.DecodeJobs);
+		{
+			std::lock_guard lock(s_Data.DecodedMutex);
+			s_Data.Decoded.clear();
+		}
+		s_Data.Uploads.clear();
+		s_Data.Progress = Progress();
+		s_Data.Placeholder.reset();
+
+		// Deleted after the uploads still queued
+		Renderer::Submit([uploader = s_Data.Uploader.release()]()
+										 { delete uploader; });
+	}
+
+	Ref<Texture2D> TextureLoader::Load(const std::string &path, const LoadCallback &callback)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_CORE_ASSERT(s_Data.Uploader, "TextureLoader isn't initialized!");
+
+		// The counters cover the loads requested since nothing was loading, the batch a loading screen waits for
+		if (s_Data.Progress.IsDone())
+		{
+			s_Data.Progress = Progress();
+		}
+		s_Data.Progress.Requested++;
+
+		Ref<TextureLoadRequest> request = CreateRef<TextureLoadRequest>();
+		request->Texture = s_Data.Uploader->CreateTexture(path);
+		request->Path = path;
+		request->Callback = callback;
+
+		JobSystem::Run("Decode texture", [request]()
+									 {
+			int width, height, channels;
+			stbi_uc *pixels = stbi_load(request->Path.c_str(), &width, &height, &channels, 0);
+			if (pixels && channels != 3 && channels != 4)
+			{
+				AK_CORE_ERROR("TextureLoader: '{0}' has {1} channels, only RGB and RGBA are supported", request->Path, channels);
+				stbi_image_free(pixels);
+				pixels = nullptr;
+			}
+			else if (!pixels)
+			{
+				AK_CORE_ERROR("TextureLoader: could not load '{0}'", request->Path);
+			}
+
+			if (pixels)
+			{
+				request->Image = CreateRef<TextureImage>();
+				request->Image->Pixels = pixels;
+				request->Image->Width = width;
+				request->Image->Height = height;
+				request->Image->Channels = channels;
+			}
+
+			std::lock_guard lock(s_Data.DecodedMutex);
+			s_Data.Decoded.push_back(request); }, &s_Data.DecodeJobs);
+
+		return request->Texture;
+	}
+
+	bool TextureLoader::Update()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (!s_Data.Uploader)
+		{
+			return false;
+		}
+
+		std::vector<Ref<TextureLoadRequest>> decoded;
+		{
+			std::lock_guard lock(s_Data.DecodedMutex);
+			decoded.swap(s_Data.Decoded);
+		}
+
+		Progress &progress = s_Data.Progress;
+		for (Ref<TextureLoadRequest> &request : decoded)
+		{
+			if (request->Image && request->Image->GetRowSize() > s_Data.Specification.UploadBudget)
+			{
+				AK_CORE_ERROR("TextureLoader: a row of '{0}' is larger than the upload budget", request->Path);
+				request->Image.reset();
+			}
+
+			if (!request->Image)
+			{
+				// The texture keeps drawing the placeholder
+				progress.Failed++;
+				if (request->Callback)
+				{
+					request->Callback(request->Texture, false);
+				}
+				continue;
+			}
+
+			progress.Decoded++;
+			progress.UploadBytes += (uint64_t)request->Image->GetRowSize() * request->Image->Height;
+			s_Data.Uploads.push_back(request);
+		}
+
+		// The bands of rows of the frame, within the budget: a large image continues the next frames
+		uint32_t budget = s_Data.Specification.UploadBudget;
+		while (!s_Data.Uploads.empty())
+		{
+			Ref<TextureLoadRequest> request = s_Data.Uploads.front();
+			const TextureImage &image = *request->Image;
+			uint32_t rowSize = image.GetRowSize();
+
+			// Nothing but the loader references the texture anymore, no need to finish it
+			if (request->Texture.use_count() == 1)
+			{
+				progress.Cancelled++;
+				progress.UploadBytes -= (uint64_t)rowSize * (image.Height - request->UploadedRows);
+				s_Data.Uploads.pop_front();
+				continue;
+			}
+
+			uint32_t rowCount = std::min(image.Height - request->UploadedRows, budget / rowSize);
+			if (rowCount == 0)
+			{
+				break;
+			}
+
+			if (request->UploadedRows == 0)
+			{
+				s_Data.Uploader->BeginUpload(request->Texture.get(), image);
+			}
+			s_Data.Uploader->UploadRows(request->Texture.get(), request->Image, request->UploadedRows, rowCount);
+			request->UploadedRows += rowCount;
+			budget -= rowCount * rowSize;
+			progress.UploadedBytes += (uint64_t)rowCount * rowSize;
+
+			if (request->UploadedRows < image.Height)
+			{
+				continue;
+			}
+
+			s_Data.Uploader->EndUpload(request->Texture.get());
+			s_Data.Uploads.pop_front();
+			progress.Loaded++;
+			if (request->Callback)
+			{
+				request->Callback(request->Texture, true);
+			}
+		}
+
+		s_Data.Uploader->EndFrame();
+		return IsLoading();
+	}
+
+	TextureLoader::Progress TextureLoader::GetProgress()
+	{
+		return s_Data.Progress;
+	}
+
+	bool TextureLoader::IsLoading()
+	{
+		return !s_Data.Progress.IsDone();
+	}
+
+	Texture2D *TextureLoader::GetPlaceholder()
+	{
+		return s_Data.Placeholder.get();
+	}
+
+}
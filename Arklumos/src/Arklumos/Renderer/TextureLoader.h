@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+#include "Arklumos/Renderer/Texture.h"
+
+#include <functional>
+#include <string>
+
+namespace Arklumos
+{
+
+	struct TextureLoaderSpecification
+	{
+		/*
+			Bytes of pixels uploaded to the GPU per frame at most. An image larger than that is uploaded in bands of rows over several frames,
+			so loading many or large textures spreads over the frames instead of making one of them spike. It is also the size of a staging segment.
+		*/
+		uint32_t UploadBudget = 8 * 1024 * 1024;
+	};
+
+	/*
+		Loads the textures asynchronously: Load returns the texture right away, the image file is decoded by a job on the worker threads,
+		then its pixels are uploaded through a staging ring (see TextureUploader) within a budget of bytes per frame.
+		Until its last row is uploaded, the texture draws the placeholder (a white 1x1 texture, like Renderer2D's white texture).
+
+		Update is called by the main thread once per frame (see Application): it starts the uploads of the decoded images, submits the rows of the frame,
+		and calls the callbacks of the textures completed or failed. A texture released by everything but the loader stops loading.
+		The progress counters let a loading screen show how far the loads are.
+	*/
+	class TextureLoader
+	{
+	public:
+		// Called on the main thread once the last rows of the texture are submitted (the draws recorded from then on use the image), or when the image couldn't be loaded
+		using LoadCallback = std::function<void(const Ref<Texture2D> &texture, bool loaded)>;
+
+		struct Progress
+		{
+			uint32_t Requested = 0;
+			uint32_t Decoded = 0;
+			uint32_t Loaded = 0;
+			uint32_t Failed = 0;
+			uint32_t Cancelled = 0;
+
+			// Bytes of pixels of the decoded images, and bytes uploaded so far
+			uint64_t UploadBytes = 0;
+			uint64_t UploadedBytes = 0;
+
+			bool IsDone() const { return Loaded + Failed + Cancelled == Requested; }
+			// From 0 to 1, a texture counts as loaded once its image is uploaded (decoding is the first half)
+			float GetFraction() const;
+		};
+
+		static void Init(const TextureLoaderSpecification &specification = TextureLoaderSpecification());
+		static void Shutdown();
+
+		// Called from the main thread
+		static Ref<Texture2D> Load(const std::string &path, const LoadCallback &callback = LoadCallback());
+
+		// Returns whether textures are still loading
+		static bool Update();
+
+		// Counters since Init, a loading screen can keep the progress at its start and subtract it
+		static Progress GetProgress();
+		static bool IsLoading();
+
+		// Bound in place of the textures still loading, from the thread owning the graphics context
+		static Texture2D *GetPlaceholder();
+	};
+
+}
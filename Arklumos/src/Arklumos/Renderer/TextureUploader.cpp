@@ -0,0 +1,26 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/TextureUploader.h"
+
+#include "Arklumos/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLTextureUploader.h"
+
+namespace Arklumos
+{
+
+	Scope<TextureUploader> TextureUploader::Create(uint32_t segmentSize, uint32_t segmentCount)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			AK_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+
+		case RendererAPI::API::OpenGL:
+			return CreateScope<OpenGLTextureUploader>(segmentSize, segmentCount);
+		}
+
+		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+#include "Arklumos/Renderer/Texture.h"
+
+#include <cstdint>
+
+namespace Arklumos
+{
+
+	// Decoded pixels of an image, rows from the bottom to the top (the order of the texture rows), Channels bytes per pixel
+	struct TextureImage
+	{
+		uint8_t *Pixels = nullptr;
+		uint32_t Width = 0, Height = 0, Channels = 0;
+
+		TextureImage() = default;
+		TextureImage(const TextureImage &) = delete;
+		TextureImage &operator=(const TextureImage &) = delete;
+		~TextureImage();
+
+		uint32_t GetRowSize() const { return Width * Channels; }
+	};
+
+	/*
+		Uploads the decoded images of the TextureLoader to the textures, band of rows by band of rows, through a ring of staging segments:
+		the rows of a frame are copied in one segment and the GPU reads them from there, and a segment is only written again once the GPU is done with the frame that used it.
+
+		Called by the main thread, each call submits its render commands. The rows of a frame must fit in a segment.
+	*/
+	class TextureUploader
+	{
+	public:
+		virtual ~TextureUploader() = default;
+
+		// Texture without storage yet, drawing the placeholder of the TextureLoader until its upload ends. Doesn't touch the graphics API
+		virtual Ref<Texture2D> CreateTexture(const std::string &path) = 0;
+
+		// Gives the texture its size and format (set right away, visible from the main thread) and creates its storage
+		virtual void BeginUpload(Texture2D *texture, const TextureImage &image) = 0;
+		// The image is kept alive by the command until it is copied in the staging segment
+		virtual void UploadRows(Texture2D *texture, const Ref<TextureImage> &image, uint32_t firstRow, uint32_t rowCount) = 0;
+		// The texture draws its image from the commands submitted after this one
+		virtual void EndUpload(Texture2D *texture) = 0;
+
+		// Called once the uploads of the frame are submitted, moves on to the next segment when this one was used
+		virtual void EndFrame() = 0;
+
+		static Scope<TextureUploader> Create(uint32_t segmentSize, uint32_t segmentCount);
+	};
+
+}
@@ -0,0 +1,37 @@
+#include "akpch.h"
+#include "Arklumos/Renderer/UniformBuffer.h"
+
+#include "Arklumos/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+namespace Arklumos
+{
+
+	// Binding points per block name, kept after the buffers are released (the binding points are global)
+	static std::unordered_map<StringId, UniformBuffer::BlockBinding> s_BlockBindings;
+
+	Ref<UniformBuffer> UniformBuffer::Create(const std::string &blockName, uint32_t size, uint32_t binding)
+	{
+		s_BlockBindings[StringId(blockName)] = {binding, size};
+
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:
+			AK_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+			return nullptr;
+
+		case RendererAPI::API::OpenGL:
+			return Renderer::CreateResource<OpenGLUniformBuffer>(size, binding);
+		}
+
+		AK_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	const UniformBuffer::BlockBinding *UniformBuffer::FindBlockBinding(StringId blockName)
+	{
+		auto it = s_BlockBindings.find(blockName);
+		return it != s_BlockBindings.end() ? &it->second : nullptr;
+	}
+
+}
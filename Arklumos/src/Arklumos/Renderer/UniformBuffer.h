@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+#include "Arklumos/Core/StringId.h"
+#include "Arklumos/Renderer/Buffer.h"
+#include "Arklumos/Renderer/RenderResource.h"
+
+namespace Arklumos
+{
+
+	/*
+		Offsets of the members of a uniform block declared with layout(std140), computed at compile time to check the C++ struct mirroring the block:
+
+			constexpr uint32_t size = []()
+			{
+				Std140Layout layout;
+				layout.Add(ShaderDataType::Mat4);
+				layout.Add(ShaderDataType::Float3);
+				return layout.GetSize();
+			}();
+			static_assert(sizeof(SceneData) == size);
+
+		The std140 rules: the scalars are aligned on 4 bytes, the vec2 on 8, the vec3 and vec4 on 16 (a vec3 still takes 12 bytes, a float can follow it),
+		the matrices are arrays of vec4 columns, the elements of an array are aligned and padded to 16 bytes, and the block size is a multiple of 16.
+	*/
+	class Std140Layout
+	{
+	public:
+		// Returns the offset of the member
+		constexpr uint32_t Add(ShaderDataType type, uint32_t arrayCount = 1)
+		{
+			bool isArray = arrayCount > 1;
+			uint32_t alignment = isArray ? 16 : GetAlignment(type);
+			uint32_t stride = isArray ? AlignUp(GetSize(type), 16) : GetSize(type);
+
+			uint32_t offset = AlignUp(m_Size, alignment);
+			m_Size = offset + stride * arrayCount;
+			return offset;
+		}
+
+		constexpr uint32_t GetSize() const { return AlignUp(m_Size, 16); }
+
+		static constexpr uint32_t GetAlignment(ShaderDataType type)
+		{
+			switch (type)
+			{
+			case ShaderDataType::Float:
+			case ShaderDataType::Int:
+			case ShaderDataType::Bool:
+				return 4;
+			case ShaderDataType::Float2:
+			case ShaderDataType::Int2:
+				return 8;
+			default:
+				return 16;
+			}
+		}
+
+		static constexpr uint32_t GetSize(ShaderDataType type)
+		{
+			switch (type)
+			{
+			case ShaderDataType::Float:
+			case ShaderDataType::Int:
+			case ShaderDataType::Bool:
+				return 4;
+			case ShaderDataType::Float2:
+			case ShaderDataType::Int2:
+				return 8;
+			case ShaderDataType::Float3:
+			case ShaderDataType::Int3:
+				return 12;
+			case ShaderDataType::Float4:
+			case ShaderDataType::Int4:
+				return 16;
+			case ShaderDataType::Mat3:
+				return 16 * 3;
+			case ShaderDataType::Mat4:
+				return 16 * 4;
+			default:
+				return 0;
+			}
+		}
+
+	private:
+		static constexpr uint32_t AlignUp(uint32_t value, uint32_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		uint32_t m_Size = 0;
+	};
+
+	/*
+		Buffer holding the data of a uniform block, bound to a binding point: every shader whose block is attached to that binding point reads it,
+		so data shared by all the shaders (the camera) is uploaded once per frame instead of once per shader.
+
+		A shader either declares the binding point of the block (layout(std140, binding = 0), GLSL 4.20 and above),
+		or only its name: the block is then attached to the binding point of the uniform buffer created with that name, when the shader is linked.
+	*/
+	class UniformBuffer : public RenderResource
+	{
+	public:
+		struct BlockBinding
+		{
+			uint32_t Binding = 0;
+			uint32_t Size = 0;
+		};
+
+		virtual ~UniformBuffer() = default;
+
+		ResourceHandle<UniformBuffer> GetHandle() const { return ResourceHandle<UniformBuffer>(GetHandleValue()); }
+
+		// Called from a render command, like the other calls to the graphics API
+		virtual void SetData(const void *data, uint32_t size, uint32_t offset = 0) = 0;
+
+		virtual uint32_t GetSize() const = 0;
+		virtual uint32_t GetBinding() const = 0;
+
+		static Ref<UniformBuffer> Create(const std::string &blockName, uint32_t size, uint32_t binding);
+
+		// The binding point of the buffers created with that block name, null if there is none. Called when the shaders are linked
+		static const BlockBinding *FindBlockBinding(StringId blockName);
+	};
+
+}
@@ -6,7 +6,12 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 
+#include "entt.hpp"
+
+#include "Arklumos/Renderer/Texture.h"
+
 #include "SceneCamera.h"
+#include "SpatialIndex.h"
 #include "ScriptableEntity.h"
 
 namespace Arklumos
@@ -41,9 +46,67 @@ namespace Arklumos
 		}
 	};
 
+	/*
+		Parent/children links of an entity, stored as an intrusive doubly linked list of siblings so that no container has to be allocated per entity.
+		Every entity created by the Scene has one, use Entity::SetParent/Scene::SetParent to modify it (never edit the links by hand).
+	*/
+	struct RelationshipComponent
+	{
+		entt::entity Parent = entt::null;
+		entt::entity FirstChild = entt::null;
+		entt::entity PreviousSibling = entt::null;
+		entt::entity NextSibling = entt::null;
+		uint32_t ChildrenCount = 0;
+
+		RelationshipComponent() = default;
+		RelationshipComponent(const RelationshipComponent &) = default;
+	};
+
+	/*
+		Cached world matrix of an entity, maintained by Scene::UpdateWorldTransforms.
+
+		The local TRS used for the last computation is kept as a snapshot: the TransformComponent is edited directly everywhere (scripts, editor panels, gizmo),
+		so comparing against the snapshot is how a local change is detected. The local matrix is cached too, so an entity for which only the parent moved
+		does not rebuild the quaternion from the Euler angles.
+	*/
+	struct WorldTransformComponent
+	{
+		glm::mat4 Transform{1.0f};
+		glm::mat4 LocalTransform{1.0f};
+
+		glm::vec3 Translation = {0.0f, 0.0f, 0.0f};
+		glm::vec3 Rotation = {0.0f, 0.0f, 0.0f};
+		glm::vec3 Scale = {1.0f, 1.0f, 1.0f};
+
+		// The world matrix has to be recomputed (local change, new entity, reparented...)
+		bool Dirty = true;
+		// Set when the world matrix has been recomputed during the last update, read by the children and the spatial index
+		bool Changed = false;
+
+		WorldTransformComponent() = default;
+		WorldTransformComponent(const WorldTransformComponent &) = default;
+	};
+
+	/*
+		Entity moved by the fixed updates (a physics body). The ticks don't line up with the frames, so the entity is drawn between its state before the last tick
+		and its current state, with the alpha of Application::GetFixedUpdateAlpha (see Scene::OnUpdateRuntime): the motion stays smooth whatever the frame rate.
+		Holds the local TRS at the beginning of the last tick, written by Scene::OnFixedUpdateRuntime. Only the entity itself is interpolated, its children follow the state of the last tick.
+	*/
+	struct InterpolatedTransformComponent
+	{
+		glm::vec3 PreviousTranslation = {0.0f, 0.0f, 0.0f};
+		glm::vec3 PreviousRotation = {0.0f, 0.0f, 0.0f};
+		glm::vec3 PreviousScale = {1.0f, 1.0f, 1.0f};
+
+		InterpolatedTransformComponent() = default;
+		InterpolatedTransformComponent(const InterpolatedTransformComponent &) = default;
+	};
+
 	struct SpriteRendererComponent
 	{
 		glm::vec4 Color{1.0f, 1.0f, 1.0f, 1.0f};
+		// Null draws a flat colored quad, otherwise the texture is tinted by Color
+		Ref<Texture2D> Texture;
 
 		SpriteRendererComponent() = default;
 		SpriteRendererComponent(const SpriteRendererComponent &) = default;
@@ -51,6 +114,22 @@ namespace Arklumos
 				: Color(color) {}
 	};
 
+	/*
+		Internal component linking an entity to its leaf in the spatial index of the Scene.
+		It is added/removed by Scene::UpdateSpatialIndex and never needs to be touched by hand (it is neither serialized nor shown in the editor).
+	*/
+	struct SpatialProxyComponent
+	{
+		int32_t ProxyID = DynamicAABBTree::NullNode;
+		// Center of the bounds at the last update, used to predict the motion of the proxy
+		glm::vec3 LastCenter = {0.0f, 0.0f, 0.0f};
+
+		SpatialProxyComponent() = default;
+		SpatialProxyComponent(const SpatialProxyComponent &) = default;
+		SpatialProxyComponent(int32_t proxyID, const glm::vec3 &center)
+				: ProxyID(proxyID), LastCenter(center) {}
+	};
+
 	struct CameraComponent
 	{
 		SceneCamera Camera;
@@ -43,6 +43,17 @@ namespace Arklumos
 			m_Scene->m_Registry.remove<T>(m_EntityHandle);
 		}
 
+		// Hierarchy, see Scene::SetParent
+		void SetParent(Entity parent)
+		{
+			m_Scene->SetParent(*this, parent);
+		}
+
+		Entity GetParent()
+		{
+			return m_Scene->GetParent(*this);
+		}
+
 		operator bool() const { return m_EntityHandle != entt::null; }
 		operator entt::entity() const { return m_EntityHandle; }
 		operator uint32_t() const { return (uint32_t)m_EntityHandle; }
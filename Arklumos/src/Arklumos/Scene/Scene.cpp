@@ -3,6 +3,8 @@
 
 #include "Components.h"
 #include "Arklumos/Renderer/Renderer2D.h"
+#include "Arklumos/Math/TransformBatch.h"
+#include "Arklumos/Core/JobSystem.h"
 
 #include <glm/glm.hpp>
 
@@ -13,6 +15,8 @@ namespace Arklumos
 
 	Scene::Scene()
 	{
+		// Keep the tree in sync when a proxy goes away, whether the entity is destroyed or only lost its sprite
+		m_Registry.on_destroy<SpatialProxyComponent>().connect<&Scene::OnSpatialProxyDestroyed>(*this);
 	}
 
 	Scene::~Scene()
@@ -21,20 +25,76 @@ namespace Arklumos
 
 	Entity Scene::CreateEntity(const std::string &name)
 	{
+		AK_MEMORY_TAG(Scene);
+
 		Entity entity = {m_Registry.create(), this};
 		entity.AddComponent<TransformComponent>();
+		entity.AddComponent<WorldTransformComponent>();
+		entity.AddComponent<RelationshipComponent>();
 		auto &tag = entity.AddComponent<TagComponent>();
 		tag.Tag = name.empty() ? "Entity" : name;
+
+		m_HierarchyDirty = true;
+		m_Changed = true;
 		return entity;
 	}
 
 	void Scene::DestroyEntity(Entity entity)
 	{
+		AK_MEMORY_TAG(Scene);
+
+		// Destroying an entity destroys its whole subtree, the next sibling is fetched before the child is destroyed since destroying it unlinks it
+		entt::entity child = m_Registry.get<RelationshipComponent>(entity).FirstChild;
+		while (child != entt::null)
+		{
+			entt::entity next = m_Registry.get<RelationshipComponent>(child).NextSibling;
+			DestroyEntity(Entity{child, this});
+			child = next;
+		}
+
+		DetachFromParent(entity);
 		m_Registry.destroy(entity);
+
+		m_HierarchyDirty = true;
+		m_Changed = true;
 	}
 
-	void Scene::OnUpdateRuntime(Timestep ts)
+	ScriptableEntity *Scene::GetScriptInstance(entt::entity entity, NativeScriptComponent &nsc)
 	{
+		// TODO: Move to Scene::OnScenePlay
+		if (!nsc.Instance)
+		{
+			nsc.Instance = nsc.InstantiateScript();
+			nsc.Instance->m_Entity = Entity{entity, this};
+
+			nsc.Instance->OnCreate();
+		}
+		return nsc.Instance;
+	}
+
+	void Scene::OnFixedUpdateRuntime(Timestep ts)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_MEMORY_TAG(Scene);
+
+		// The state before the tick, the frames until the next tick are drawn between it and the state after the tick
+		m_Registry.view<TransformComponent, InterpolatedTransformComponent>().each([](auto entity, auto &transform, auto &interpolated)
+																																				 {
+			interpolated.PreviousTranslation = transform.Translation;
+			interpolated.PreviousRotation = transform.Rotation;
+			interpolated.PreviousScale = transform.Scale; });
+
+		m_Registry.view<NativeScriptComponent>().each([&](auto entity, auto &nsc)
+																									{ GetScriptInstance(entity, nsc)->OnFixedUpdate(ts); });
+
+		m_FixedSystemScheduler.Run(m_Registry, ts);
+	}
+
+	void Scene::OnUpdateRuntime(Timestep ts, float fixedUpdateAlpha)
+	{
+		AK_MEMORY_TAG(Scene);
+
 		// Update scripts
 		{
 			/*
@@ -48,18 +108,19 @@ namespace Arklumos
 				This way, nsc will be captured by reference, but this will not be captured implicitly.
 			*/
 			m_Registry.view<NativeScriptComponent>().each([&](auto entity, auto &nsc)
-																										{
-																											// TODO: Move to Scene::OnScenePlay
-																											if (!nsc.Instance)
-																											{
-																												nsc.Instance = nsc.InstantiateScript();
-																												nsc.Instance->m_Entity = Entity{entity, this};
+																										{ GetScriptInstance(entity, nsc)->OnUpdate(ts); });
+		}
 
-																												nsc.Instance->OnCreate();
-																											}
+		// Systems, in parallel
+		m_SystemScheduler.Run(m_Registry, ts);
 
-																											nsc.Instance->OnUpdate(ts); });
-		}
+		// The scripts and the systems may have moved entities, the world matrices are computed once they are done
+		UpdateWorldTransforms();
+		UpdateSpatialIndex();
+
+		// Consumed by DrawRenderList below, the list only lives for the frame
+		RenderList renderList(FrameAllocator::GetResource());
+		ExtractRenderList(renderList, fixedUpdateAlpha);
 
 		// Render 2D
 		/*
@@ -72,18 +133,18 @@ namespace Arklumos
 		glm::mat4 cameraTransform;
 		{
 			// Creates a view of the entities in the registry that have both TransformComponent and CameraComponent attached to them. A view is an object that provides an efficient way to iterate over entities that meet certain criteria.
-			auto view = m_Registry.view<TransformComponent, CameraComponent>();
+			auto view = m_Registry.view<WorldTransformComponent, CameraComponent>();
 			for (auto entity : view)
 			{
 				// Retrieves the TransformComponent and CameraComponent attached to the current entity in the loop, using structured binding syntax. The get method of the view takes an entity ID and a list of component types and returns references to the corresponding components.
-				auto [transform, camera] = view.get<TransformComponent, CameraComponent>(entity);
+				auto [transform, camera] = view.get<WorldTransformComponent, CameraComponent>(entity);
 
 				if (camera.Primary)
 				{
 					// If the current camera component is marked as the primary camera, this line assigns the address of its Camera member to the mainCamera pointer.
 					mainCamera = &camera.Camera;
 					// Assigns the address of its Transform member to the cameraTransform pointer
-					cameraTransform = transform.GetTransform();
+					cameraTransform = transform.Transform;
 					break;
 				}
 			}
@@ -95,15 +156,8 @@ namespace Arklumos
 			// BeginScene sets up the rendering environment with the appropriate view and projection matrices based on the camera properties.
 			Renderer2D::BeginScene(*mainCamera, cameraTransform);
 
-			// Creates a group of entities in the registry that have both TransformComponent and SpriteRendererComponent attached to them. A group is a view that provides a way to iterate over entities that have specific combinations of components.
-			auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-			for (auto entity : group)
-			{
-				// Retrieves the TransformComponent and SpriteRendererComponent attached to the current entity in the loop, using structured binding syntax. The get method of the group takes an entity ID and a list of component types and returns references to the corresponding components.
-				auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
-
-				Renderer2D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
-			}
+			// Draws the sprites extracted from the registry above
+			Renderer2D::DrawRenderList(renderList);
 
 			// Ends the current rendering scene
 			Renderer2D::EndScene();
@@ -112,19 +166,39 @@ namespace Arklumos
 
 	void Scene::OnUpdateEditor(Timestep ts, EditorCamera &camera)
 	{
-		Renderer2D::BeginScene(camera);
+		AK_MEMORY_TAG(Scene);
 
-		auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-		for (auto entity : group)
-		{
-			auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
+		UpdateWorldTransforms();
+		UpdateSpatialIndex();
 
-			Renderer2D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
-		}
+		RenderList renderList(FrameAllocator::GetResource());
+		ExtractRenderList(renderList);
 
+		Renderer2D::BeginScene(camera);
+		Renderer2D::DrawRenderList(renderList);
 		Renderer2D::EndScene();
 	}
 
+	bool Scene::ConsumeChanges()
+	{
+		bool changed = m_Changed;
+		m_Changed = false;
+		return changed;
+	}
+
+	template <typename... Component>
+	static size_t GetPoolsMemoryUsage(const entt::registry &registry)
+	{
+		// A pool stores the components and a packed array of their entities (the sparse arrays are left out)
+		return ((registry.capacity<Component>() * (sizeof(Component) + sizeof(entt::entity))) + ...);
+	}
+
+	size_t Scene::GetRegistryMemoryUsage() const
+	{
+		size_t memory = GetPoolsMemoryUsage<TagComponent, TransformComponent, RelationshipComponent, WorldTransformComponent, InterpolatedTransformComponent, SpriteRendererComponent, SpatialProxyComponent, CameraComponent, NativeScriptComponent>(m_Registry);
+		return memory + m_Registry.capacity() * sizeof(entt::entity);
+	}
+
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
 	{
 		m_ViewportWidth = width;
@@ -161,6 +235,456 @@ namespace Arklumos
 		return {};
 	}
 
+	void Scene::SetParent(Entity entity, Entity parent)
+	{
+		AK_CORE_ASSERT(entity, "Invalid entity!");
+
+		if (parent)
+		{
+			// Refuse cycles: the new parent can't be the entity itself or one of its descendants
+			for (entt::entity ancestor = parent; ancestor != entt::null; ancestor = m_Registry.get<RelationshipComponent>(ancestor).Parent)
+			{
+				if (ancestor == (entt::entity)entity)
+				{
+					AK_CORE_WARN("Cannot parent an entity to itself or to one of its children!");
+					return;
+				}
+			}
+		}
+
+		DetachFromParent(entity);
+
+		if (parent)
+		{
+			// Append at the end of the children of the parent, so the order of the siblings is stable (the serializer relies on it)
+			auto &relationship = m_Registry.get<RelationshipComponent>(entity);
+			auto &parentRelationship = m_Registry.get<RelationshipComponent>(parent);
+
+			relationship.Parent = parent;
+			if (parentRelationship.FirstChild == entt::null)
+			{
+				parentRelationship.FirstChild = entity;
+			}
+			else
+			{
+				entt::entity last = parentRelationship.FirstChild;
+				while (m_Registry.get<RelationshipComponent>(last).NextSibling != entt::null)
+				{
+					last = m_Registry.get<RelationshipComponent>(last).NextSibling;
+				}
+
+				m_Registry.get<RelationshipComponent>(last).NextSibling = entity;
+				relationship.PreviousSibling = last;
+			}
+			parentRelationship.ChildrenCount++;
+		}
+
+		m_Registry.get<WorldTransformComponent>(entity).Dirty = true;
+		m_HierarchyDirty = true;
+		m_Changed = true;
+	}
+
+	Entity Scene::GetParent(Entity entity)
+	{
+		entt::entity parent = m_Registry.get<RelationshipComponent>(entity).Parent;
+		return parent == entt::null ? Entity{} : Entity{parent, this};
+	}
+
+	void Scene::DetachFromParent(entt::entity entity)
+	{
+		auto &relationship = m_Registry.get<RelationshipComponent>(entity);
+		if (relationship.Parent == entt::null)
+		{
+			return;
+		}
+
+		auto &parentRelationship = m_Registry.get<RelationshipComponent>(relationship.Parent);
+		if (parentRelationship.FirstChild == entity)
+		{
+			parentRelationship.FirstChild = relationship.NextSibling;
+		}
+		if (relationship.PreviousSibling != entt::null)
+		{
+			m_Registry.get<RelationshipComponent>(relationship.PreviousSibling).NextSibling = relationship.NextSibling;
+		}
+		if (relationship.NextSibling != entt::null)
+		{
+			m_Registry.get<RelationshipComponent>(relationship.NextSibling).PreviousSibling = relationship.PreviousSibling;
+		}
+		parentRelationship.ChildrenCount--;
+
+		relationship.Parent = entt::null;
+		relationship.PreviousSibling = entt::null;
+		relationship.NextSibling = entt::null;
+
+		m_Registry.get<WorldTransformComponent>(entity).Dirty = true;
+		m_HierarchyDirty = true;
+		m_Changed = true;
+	}
+
+	void Scene::RebuildHierarchyLevels()
+	{
+		/*
+			Breadth first traversal from the roots: the level N contains the entities at depth N, so processing the levels in order is a topological order of the hierarchy
+			(a parent is always computed before its children). The vectors are cleared but not released, to keep their capacity from one rebuild to the next.
+		*/
+		for (auto &level : m_HierarchyLevels)
+		{
+			level.clear();
+		}
+
+		if (m_HierarchyLevels.empty())
+		{
+			m_HierarchyLevels.emplace_back();
+		}
+
+		auto view = m_Registry.view<RelationshipComponent>();
+		for (auto entity : view)
+		{
+			if (view.get<RelationshipComponent>(entity).Parent == entt::null)
+			{
+				m_HierarchyLevels[0].push_back(entity);
+			}
+		}
+
+		size_t depth = 0;
+		while (!m_HierarchyLevels[depth].empty())
+		{
+			if (m_HierarchyLevels.size() == depth + 1)
+			{
+				m_HierarchyLevels.emplace_back();
+			}
+
+			for (entt::entity entity : m_HierarchyLevels[depth])
+			{
+				for (entt::entity child = view.get<RelationshipComponent>(entity).FirstChild; child != entt::null; child = view.get<RelationshipComponent>(child).NextSibling)
+				{
+					m_HierarchyLevels[depth + 1].push_back(child);
+				}
+			}
+
+			depth++;
+		}
+
+		// The last level is always empty, drop it along with the levels left over from a deeper hierarchy
+		m_HierarchyLevels.resize(depth);
+		m_HierarchyDirty = false;
+	}
+
+	void Scene::UpdateWorldTransforms()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (m_HierarchyDirty)
+		{
+			RebuildHierarchyLevels();
+		}
+
+		/*
+			Local matrices. They don't depend on the hierarchy, so every entity whose TRS changed is gathered in the structure of arrays staging buffers
+			and all the local matrices are computed in one batch by the SIMD kernels (see Math::ComposeTransforms).
+			The staging buffers keep their capacity, so this doesn't allocate once the scene has been running for a frame.
+		*/
+		m_TransformStaging.Clear();
+		m_TransformStagingEntities.clear();
+
+		auto view = m_Registry.view<TransformComponent, WorldTransformComponent>();
+		for (auto entity : view)
+		{
+			auto [transform, world] = view.get<TransformComponent, WorldTransformComponent>(entity);
+			if (world.Dirty || transform.Translation != world.Translation || transform.Rotation != world.Rotation || transform.Scale != world.Scale)
+			{
+				world.Translation = transform.Translation;
+				world.Rotation = transform.Rotation;
+				world.Scale = transform.Scale;
+				world.Dirty = true;
+
+				m_TransformStaging.Push(transform.Translation, transform.Rotation, transform.Scale);
+				m_TransformStagingEntities.push_back(entity);
+			}
+		}
+
+		if (!m_TransformStagingEntities.empty())
+		{
+			m_Changed = true;
+			m_LocalTransforms.resize(m_TransformStagingEntities.size());
+
+			// Every range computes its own matrices and writes them to its own entities
+			JobSystem::ParallelFor("Scene::ComposeLocalTransforms", m_TransformStagingEntities.size(), 2048, [&](size_t begin, size_t end)
+														 {
+				Math::ComposeTransforms(m_TransformStaging, begin, end, m_LocalTransforms.data());
+
+				for (size_t i = begin; i < end; i++)
+				{
+					view.get<WorldTransformComponent>(m_TransformStagingEntities[i]).LocalTransform = m_LocalTransforms[i];
+				} });
+		}
+
+		/*
+			World matrices. An entity only reads its own components and the world matrix of its parent, which belongs to the previous level.
+			So the levels have to be processed in order, but the entities of a same level are independent and can be processed in parallel.
+		*/
+		auto hierarchy = m_Registry.view<RelationshipComponent, WorldTransformComponent>();
+		auto updateEntity = [&](entt::entity entity)
+		{
+			const auto &relationship = hierarchy.get<RelationshipComponent>(entity);
+			auto &world = hierarchy.get<WorldTransformComponent>(entity);
+
+			const WorldTransformComponent *parentWorld = relationship.Parent != entt::null ? &hierarchy.get<WorldTransformComponent>(relationship.Parent) : nullptr;
+
+			world.Changed = world.Dirty || (parentWorld && parentWorld->Changed);
+			if (!world.Changed)
+			{
+				return;
+			}
+
+			world.Transform = parentWorld ? parentWorld->Transform * world.LocalTransform : world.LocalTransform;
+			world.Dirty = false;
+		};
+
+		// ParallelFor returns once the whole level is done, so the next level sees the final world matrices of its parents
+		for (const auto &level : m_HierarchyLevels)
+		{
+			JobSystem::ParallelFor("Scene::UpdateWorldTransforms level", level.size(), 1024, [&](size_t begin, size_t end)
+														 {
+				for (size_t i = begin; i < end; i++)
+				{
+					updateEntity(level[i]);
+				} });
+		}
+	}
+
+	// Local matrix at alpha between the state before the last fixed update and the current one, the rotation is interpolated on the shortest arc
+	static glm::mat4 InterpolateTransform(const InterpolatedTransformComponent &previous, const TransformComponent &current, float alpha)
+	{
+		glm::vec3 translation = glm::mix(previous.PreviousTranslation, current.Translation, alpha);
+		glm::quat rotation = glm::slerp(glm::quat(previous.PreviousRotation), glm::quat(current.Rotation), alpha);
+		glm::vec3 scale = glm::mix(previous.PreviousScale, current.Scale, alpha);
+
+		return glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(rotation) * glm::scale(glm::mat4(1.0f), scale);
+	}
+
+	void Scene::ExtractRenderList(RenderList &renderList, float interpolationAlpha)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		/*
+			The group owns the WorldTransformComponent pool: the world matrices of the sprites are packed at the beginning of the pool, in the same order as the entities of the group.
+			So a chunk [begin, end) of the group reads a contiguous range of matrices and writes a contiguous range of the render list.
+
+			Iterating a group with begin()/end() walks the packed arrays backward, the items are written in that same order so the draw order doesn't change.
+		*/
+		auto group = m_Registry.group<WorldTransformComponent>(entt::get<SpriteRendererComponent>);
+		const size_t count = group.size();
+
+		renderList.Clear();
+		renderList.Resize(count);
+
+		const entt::entity *entities = group.data();
+		const WorldTransformComponent *transforms = group.raw<WorldTransformComponent>();
+
+		// The views are created before the chunks, creating a missing pool isn't thread safe
+		auto interpolated = m_Registry.view<InterpolatedTransformComponent>();
+		auto localTransforms = m_Registry.view<TransformComponent>();
+		auto relationships = m_Registry.view<RelationshipComponent>();
+		auto worldTransforms = m_Registry.view<WorldTransformComponent>();
+		const bool interpolate = interpolationAlpha < 1.0f && !interpolated.empty();
+
+		// Filling the texture table isn't thread safe, so the textures are registered (and the sort keys written) in a serial pass before the chunks
+		for (size_t i = 0; i < count; i++)
+		{
+			const auto &sprite = group.get<SpriteRendererComponent>(entities[count - 1 - i]);
+			uint32_t textureIndex = renderList.AddTexture(sprite.Texture);
+			renderList.TextureIndices[i] = textureIndex;
+			renderList.SortKeys[i] = RenderList::MakeSortKey(textureIndex, (uint32_t)i);
+		}
+
+		auto extractChunk = [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				size_t packedIndex = count - 1 - i;
+				entt::entity entity = entities[packedIndex];
+				const auto &sprite = group.get<SpriteRendererComponent>(entity);
+
+				if (interpolate && interpolated.contains(entity))
+				{
+					glm::mat4 local = InterpolateTransform(interpolated.get(entity), localTransforms.get(entity), interpolationAlpha);
+					entt::entity parent = relationships.get(entity).Parent;
+					renderList.Transforms[i] = parent == entt::null ? local : worldTransforms.get(parent).Transform * local;
+				}
+				else
+				{
+					renderList.Transforms[i] = transforms[packedIndex].Transform;
+				}
+				renderList.Colors[i] = sprite.Color;
+				renderList.EntityIDs[i] = (int)entity;
+			}
+		};
+
+		// The chunks write disjoint ranges of the list and only read the registry, so they run in parallel
+		JobSystem::ParallelFor("Scene::ExtractRenderList", count, 1024, extractChunk);
+
+		renderList.Sort();
+	}
+
+	void Scene::UpdateSpatialIndex()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		// Entities that lost their sprite don't have bounds anymore, removing the component releases the proxy (see OnSpatialProxyDestroyed)
+		{
+			auto view = m_Registry.view<SpatialProxyComponent>(entt::exclude<SpriteRendererComponent>);
+			for (auto entity : view)
+			{
+				m_Registry.remove<SpatialProxyComponent>(entity);
+			}
+		}
+
+		/*
+			Insert the new sprites and move the existing ones.
+			Most of the entities don't move from one frame to the next: their bounds stay inside the fat AABB of their leaf and MoveProxy returns right away,
+			so the cost of a static scene is one bounds computation per entity and the tree is only modified for entities that actually moved out of their margin.
+		*/
+		auto group = m_Registry.group<WorldTransformComponent>(entt::get<SpriteRendererComponent>);
+		for (auto entity : group)
+		{
+			const auto &transform = group.get<WorldTransformComponent>(entity);
+			AABB bounds = AABB::FromQuad(transform.Transform);
+			glm::vec3 center = bounds.GetCenter();
+
+			if (auto *proxy = m_Registry.try_get<SpatialProxyComponent>(entity))
+			{
+				m_SpatialIndex.MoveProxy(proxy->ProxyID, bounds, center - proxy->LastCenter);
+				proxy->LastCenter = center;
+			}
+			else
+			{
+				int32_t proxyID = m_SpatialIndex.CreateProxy(bounds, (uint32_t)entity);
+				m_Registry.emplace<SpatialProxyComponent>(entity, proxyID, center);
+			}
+		}
+	}
+
+	void Scene::QueryAABB(const AABB &aabb, FrameVector<Entity> &outEntities)
+	{
+		// The tree works on the fat bounds, so the candidates are checked again against their tight bounds
+		m_SpatialIndex.Query(aabb, [&](int32_t proxyID)
+												 {
+													 entt::entity entity = (entt::entity)m_SpatialIndex.GetUserData(proxyID);
+													 const auto &transform = m_Registry.get<WorldTransformComponent>(entity);
+													 if (AABB::FromQuad(transform.Transform).Overlaps(aabb))
+													 {
+														 outEntities.push_back(Entity{entity, this});
+													 }
+													 return true; });
+	}
+
+	void Scene::QueryPoint(const glm::vec2 &point, FrameVector<Entity> &outEntities)
+	{
+		constexpr float infinity = std::numeric_limits<float>::max();
+		AABB column = {{point.x, point.y, -infinity}, {point.x, point.y, infinity}};
+
+		m_SpatialIndex.Query(column, [&](int32_t proxyID)
+												 {
+													 entt::entity entity = (entt::entity)m_SpatialIndex.GetUserData(proxyID);
+													 const glm::mat4 &transform = m_Registry.get<WorldTransformComponent>(entity).Transform;
+
+													 /*
+														 Projected on the XY plane, the quad is the image of the unit square by the 2x2 matrix made of the X/Y components of its first two axes, plus the translation.
+														 Inverting that matrix gives the coordinates of the point in the space of the quad.
+													 */
+													 glm::vec2 axisX = glm::vec2(transform[0]);
+													 glm::vec2 axisY = glm::vec2(transform[1]);
+													 float determinant = axisX.x * axisY.y - axisY.x * axisX.y;
+													 if (glm::abs(determinant) < std::numeric_limits<float>::epsilon())
+													 {
+														 // The quad is seen edge-on from the Z axis
+														 return true;
+													 }
+
+													 glm::vec2 p = point - glm::vec2(transform[3]);
+													 float u = (p.x * axisY.y - axisY.x * p.y) / determinant;
+													 float v = (axisX.x * p.y - p.x * axisX.y) / determinant;
+													 if (glm::abs(u) <= 0.5f && glm::abs(v) <= 0.5f)
+													 {
+														 outEntities.push_back(Entity{entity, this});
+													 }
+													 return true; });
+	}
+
+	FrameVector<Entity> Scene::QueryAABB(const AABB &aabb)
+	{
+		FrameVector<Entity> entities(FrameAllocator::GetResource());
+		QueryAABB(aabb, entities);
+		return entities;
+	}
+
+	FrameVector<Entity> Scene::QueryPoint(const glm::vec2 &point)
+	{
+		FrameVector<Entity> entities(FrameAllocator::GetResource());
+		QueryPoint(point, entities);
+		return entities;
+	}
+
+	Entity Scene::Raycast(const Ray &ray, float maxDistance, float *outDistance)
+	{
+		entt::entity closest = entt::null;
+		float closestDistance = maxDistance;
+
+		m_SpatialIndex.Raycast(ray, maxDistance, [&](int32_t proxyID, const Ray &, float)
+													 {
+														 entt::entity entity = (entt::entity)m_SpatialIndex.GetUserData(proxyID);
+														 const glm::mat4 &transform = m_Registry.get<WorldTransformComponent>(entity).Transform;
+
+														 // Intersect the ray with the plane of the quad (Z = 0 in local space), then check the bounds of the unit quad
+														 glm::mat4 inverse = glm::inverse(transform);
+														 glm::vec3 origin = glm::vec3(inverse * glm::vec4(ray.Origin, 1.0f));
+														 glm::vec3 direction = glm::vec3(inverse * glm::vec4(ray.Direction, 0.0f));
+														 if (glm::abs(direction.z) < std::numeric_limits<float>::epsilon())
+														 {
+															 return -1.0f;
+														 }
+
+														 // The transform is affine, so the parameter along the ray is the same in both spaces
+														 float t = -origin.z / direction.z;
+														 if (t < 0.0f || t >= closestDistance)
+														 {
+															 return -1.0f;
+														 }
+
+														 glm::vec3 hit = origin + direction * t;
+														 if (glm::abs(hit.x) > 0.5f || glm::abs(hit.y) > 0.5f)
+														 {
+															 return -1.0f;
+														 }
+
+														 closest = entity;
+														 closestDistance = t;
+														 // Clip the ray, farther subtrees are skipped (a distance of 0 would stop the traversal, keep it positive)
+														 return glm::max(t, std::numeric_limits<float>::min()); });
+
+		if (closest == entt::null)
+		{
+			return {};
+		}
+
+		if (outDistance)
+		{
+			*outDistance = closestDistance;
+		}
+		return Entity{closest, this};
+	}
+
+	void Scene::OnSpatialProxyDestroyed(entt::registry &registry, entt::entity entity)
+	{
+		const auto &proxy = registry.get<SpatialProxyComponent>(entity);
+		if (proxy.ProxyID != DynamicAABBTree::NullNode)
+		{
+			m_SpatialIndex.DestroyProxy(proxy.ProxyID);
+		}
+	}
+
 	template <typename T>
 	void Scene::OnComponentAdded(Entity entity, T &component)
 	{
@@ -172,12 +696,32 @@ namespace Arklumos
 	{
 	}
 
+	template <>
+	void Scene::OnComponentAdded<WorldTransformComponent>(Entity entity, WorldTransformComponent &component)
+	{
+	}
+
+	template <>
+	void Scene::OnComponentAdded<RelationshipComponent>(Entity entity, RelationshipComponent &component)
+	{
+	}
+
 	template <>
 	void Scene::OnComponentAdded<CameraComponent>(Entity entity, CameraComponent &component)
 	{
 		component.Camera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
 	}
 
+	template <>
+	void Scene::OnComponentAdded<InterpolatedTransformComponent>(Entity entity, InterpolatedTransformComponent &component)
+	{
+		// Nothing to interpolate from before the first tick
+		const auto &transform = entity.GetComponent<TransformComponent>();
+		component.PreviousTranslation = transform.Translation;
+		component.PreviousRotation = transform.Rotation;
+		component.PreviousScale = transform.Scale;
+	}
+
 	template <>
 	void Scene::OnComponentAdded<SpriteRendererComponent>(Entity entity, SpriteRendererComponent &component)
 	{
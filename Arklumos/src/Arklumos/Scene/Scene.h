@@ -1,7 +1,12 @@
 #pragma once
 
+#include "Arklumos/Core/FrameAllocator.h"
 #include "Arklumos/Core/Timestep.h"
 #include "Arklumos/Renderer/EditorCamera.h"
+#include "Arklumos/Scene/SpatialIndex.h"
+#include "Arklumos/Scene/SystemScheduler.h"
+#include "Arklumos/Math/TransformBatch.h"
+#include "Arklumos/Renderer/RenderList.h"
 
 #include "entt.hpp"
 
@@ -9,6 +14,8 @@ namespace Arklumos
 {
 
 	class Entity;
+	class ScriptableEntity;
+	struct NativeScriptComponent;
 
 	class Scene
 	{
@@ -19,19 +26,107 @@ namespace Arklumos
 		Entity CreateEntity(const std::string &name = std::string());
 		void DestroyEntity(Entity entity);
 
-		void OnUpdateRuntime(Timestep ts);
+		/*
+			fixedUpdateAlpha is Application::GetFixedUpdateAlpha(): the entities with an InterpolatedTransformComponent are drawn at that fraction between
+			their state before the last fixed update and their current state. 1 draws the current state.
+		*/
+		void OnUpdateRuntime(Timestep ts, float fixedUpdateAlpha = 1.0f);
+		/*
+			Simulation step with a constant timestep, called from Layer::OnFixedUpdate: keeps the state of the interpolated entities before the tick,
+			then runs ScriptableEntity::OnFixedUpdate and the fixed systems. OnUpdateRuntime then computes the transforms and renders the result, once per frame.
+		*/
+		void OnFixedUpdateRuntime(Timestep ts);
 		void OnUpdateEditor(Timestep ts, EditorCamera &camera);
 		void OnViewportResize(uint32_t width, uint32_t height);
 
 		Entity GetPrimaryCameraEntity();
 
+		/*
+			Whether entities were created, destroyed, reparented or moved since the last call.
+			For the applications that only draw on demand (see Application::RequestRedraw): a scene still changing after an update (an animation, a running simulation) needs another frame.
+		*/
+		bool ConsumeChanges();
+
+		// Memory reserved by the component pools of the engine components and the entity list of the registry, in bytes
+		size_t GetRegistryMemoryUsage() const;
+
+		/*
+			Hierarchy. The child keeps its local transform, which is now relative to the new parent.
+			Passing an invalid parent detaches the entity (it becomes a root). Parenting an entity to one of its descendants is refused.
+		*/
+		void SetParent(Entity entity, Entity parent);
+		Entity GetParent(Entity entity);
+
+		/*
+			Recomputes the world matrices of the dirty subtrees (see WorldTransformComponent), level by level from the roots.
+			Called at the beginning of the updates, call it by hand to read up to date world matrices after moving entities in the same frame.
+		*/
+		void UpdateWorldTransforms();
+
+		/*
+			Extraction phase between the simulation and the renderer: copies the render data of the sprites (world matrix, color, texture, entity ID, sort key)
+			in the render list, which Renderer2D::DrawRenderList then consumes without touching the registry.
+			The entities are processed in chunks writing disjoint ranges of the list, so the chunks are independent from each other.
+			Expects the world matrices to be up to date (see UpdateWorldTransforms). interpolationAlpha places the interpolated entities between the last two fixed updates.
+		*/
+		void ExtractRenderList(RenderList &renderList, float interpolationAlpha = 1.0f);
+
+		/*
+			Spatial queries, backed by a dynamic AABB tree containing every entity with a SpriteRendererComponent.
+			The index is synchronized with the transforms at the beginning of OnUpdateRuntime/OnUpdateEditor,
+			call UpdateSpatialIndex() first when querying right after moving entities in the same frame.
+
+			The results are appended to outEntities so the same vector can be reused between queries.
+			The overloads returning a FrameVector allocate the results from FrameAllocator::GetResource(), they are meant for the queries done once in a frame
+			and the results must not be kept past the end of the frame.
+		*/
+		void UpdateSpatialIndex();
+		// Entities whose quad bounds overlap the given box
+		void QueryAABB(const AABB &aabb, FrameVector<Entity> &outEntities);
+		FrameVector<Entity> QueryAABB(const AABB &aabb);
+		// Entities whose quad contains the given point in the XY plane (the Z axis is ignored, like picking in a 2D view)
+		void QueryPoint(const glm::vec2 &point, FrameVector<Entity> &outEntities);
+		FrameVector<Entity> QueryPoint(const glm::vec2 &point);
+		// Closest entity whose quad is hit by the ray, or an invalid entity. outDistance receives the distance along the ray
+		Entity Raycast(const Ray &ray, float maxDistance = std::numeric_limits<float>::max(), float *outDistance = nullptr);
+
+		const DynamicAABBTree &GetSpatialIndex() const { return m_SpatialIndex; }
+
+		// Gameplay systems, run by OnUpdateRuntime after the native scripts and before the world transforms are updated
+		SystemScheduler &GetSystemScheduler() { return m_SystemScheduler; }
+		// Gameplay systems run at each fixed update (physics, ...), see OnFixedUpdateRuntime
+		SystemScheduler &GetFixedSystemScheduler() { return m_FixedSystemScheduler; }
+
 	private:
 		template <typename T>
 		void OnComponentAdded(Entity entity, T &component);
 
+		// Instantiates the script of the component the first time it is needed
+		ScriptableEntity *GetScriptInstance(entt::entity entity, NativeScriptComponent &nsc);
+
+		void OnSpatialProxyDestroyed(entt::registry &registry, entt::entity entity);
+
+		void DetachFromParent(entt::entity entity);
+		void RebuildHierarchyLevels();
+
+		// Declared before the registry so the tree outlives it when the Scene is destroyed
+		DynamicAABBTree m_SpatialIndex;
 		entt::registry m_Registry;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
 
+		// Entities sorted by depth in the hierarchy (roots first), rebuilt when the hierarchy changes. The entities of one level only depend on the previous level
+		std::vector<std::vector<entt::entity>> m_HierarchyLevels;
+		bool m_HierarchyDirty = true;
+		bool m_Changed = true;
+
+		// Staging buffers of UpdateWorldTransforms: the TRS of the entities that changed, in the same order as the entities, and their local matrices
+		Math::TransformSoA m_TransformStaging;
+		std::vector<entt::entity> m_TransformStagingEntities;
+		std::vector<glm::mat4> m_LocalTransforms;
+
+		SystemScheduler m_SystemScheduler;
+		SystemScheduler m_FixedSystemScheduler;
+
 		friend class Entity;
 		friend class SceneSerializer;
 		friend class SceneHierarchyPanel;
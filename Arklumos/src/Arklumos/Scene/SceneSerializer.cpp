@@ -88,8 +88,14 @@ namespace Arklumos
 
 	static void SerializeEntity(YAML::Emitter &out, Entity entity)
 	{
-		out << YAML::BeginMap;																					 // Entity
-		out << YAML::Key << "Entity" << YAML::Value << "12837192831273"; // TODO: Entity ID goes here
+		out << YAML::BeginMap; // Entity
+		// The handle is only used to link the entities together inside the file, new handles are allocated when loading
+		out << YAML::Key << "Entity" << YAML::Value << (uint32_t)entity;
+
+		if (Entity parent = entity.GetParent())
+		{
+			out << YAML::Key << "Parent" << YAML::Value << (uint32_t)parent;
+		}
 
 		if (entity.HasComponent<TagComponent>())
 		{
@@ -151,9 +157,28 @@ namespace Arklumos
 			out << YAML::EndMap; // SpriteRendererComponent
 		}
 
+		if (entity.HasComponent<InterpolatedTransformComponent>())
+		{
+			// Only the presence of the component, the previous state is rebuilt from the transform
+			out << YAML::Key << "InterpolatedTransformComponent";
+			out << YAML::BeginMap; // InterpolatedTransformComponent
+			out << YAML::EndMap; // InterpolatedTransformComponent
+		}
+
 		out << YAML::EndMap; // Entity
 	}
 
+	// Parents are written before their children, and siblings in order, so the hierarchy can be rebuilt in a single pass when loading
+	static void SerializeEntityHierarchy(YAML::Emitter &out, Scene *scene, entt::registry &registry, entt::entity entity)
+	{
+		SerializeEntity(out, Entity{entity, scene});
+
+		for (entt::entity child = registry.get<RelationshipComponent>(entity).FirstChild; child != entt::null; child = registry.get<RelationshipComponent>(child).NextSibling)
+		{
+			SerializeEntityHierarchy(out, scene, registry, child);
+		}
+	}
+
 	void SceneSerializer::Serialize(const std::string &filepath)
 	{
 		YAML::Emitter out;
@@ -163,11 +188,11 @@ namespace Arklumos
 		m_Scene->m_Registry.each([&](auto entityID)
 														 {
 			Entity entity = { entityID, m_Scene.get() };
-			if (!entity){
+			if (!entity || entity.GetParent()){
 				return;
 			}
 
-			SerializeEntity(out, entity); });
+			SerializeEntityHierarchy(out, m_Scene.get(), m_Scene->m_Registry, entityID); });
 		out << YAML::EndSeq;
 		out << YAML::EndMap;
 
@@ -195,9 +220,12 @@ namespace Arklumos
 		auto entities = data["Entities"];
 		if (entities)
 		{
+			// Maps the IDs stored in the file to the entities created for them, to resolve the parents
+			std::unordered_map<uint64_t, Entity> entityMap;
+
 			for (auto entity : entities)
 			{
-				uint64_t uuid = entity["Entity"].as<uint64_t>(); // TODO
+				uint64_t uuid = entity["Entity"].as<uint64_t>();
 
 				std::string name;
 				auto tagComponent = entity["TagComponent"];
@@ -209,6 +237,21 @@ namespace Arklumos
 				AK_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
 
 				Entity deserializedEntity = m_Scene->CreateEntity(name);
+				entityMap[uuid] = deserializedEntity;
+
+				// Parents are serialized before their children (see SerializeEntityHierarchy)
+				if (auto parent = entity["Parent"])
+				{
+					auto it = entityMap.find(parent.as<uint64_t>());
+					if (it != entityMap.end())
+					{
+						deserializedEntity.SetParent(it->second);
+					}
+					else
+					{
+						AK_CORE_WARN("Parent of entity '{0}' not found, the entity is loaded as a root", name);
+					}
+				}
 
 				auto transformComponent = entity["TransformComponent"];
 				if (transformComponent)
@@ -246,6 +289,11 @@ namespace Arklumos
 					auto &src = deserializedEntity.AddComponent<SpriteRendererComponent>();
 					src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
 				}
+
+				if (entity["InterpolatedTransformComponent"])
+				{
+					deserializedEntity.AddComponent<InterpolatedTransformComponent>();
+				}
 			}
 		}
 
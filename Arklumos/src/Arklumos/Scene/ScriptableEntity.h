@@ -20,6 +20,8 @@ namespace Arklumos
 		virtual void OnCreate() {}
 		virtual void OnDestroy() {}
 		virtual void OnUpdate(Timestep ts) {}
+		// At the fixed rate of the application, see Scene::OnFixedUpdateRuntime
+		virtual void OnFixedUpdate(Timestep ts) {}
 
 	private:
 		Entity m_Entity;
@@ -0,0 +1,495 @@
+#include "akpch.h"
+#include "Arklumos/Scene/SpatialIndex.h"
+
+namespace Arklumos
+{
+
+	// Margin added around the bounds of the leaves, in world units
+	static constexpr float s_AABBMargin = 0.1f;
+	// How much of the displacement is used to predict the motion of a moving proxy
+	static constexpr float s_DisplacementMultiplier = 4.0f;
+
+	AABB AABB::FromQuad(const glm::mat4 &transform)
+	{
+		/*
+			Transforming the 4 corners of the quad would work, but the bounds of an affinely transformed box can be computed directly from the matrix:
+			the new center is the transformed center, and each new half extent is the sum of the absolute values of the rotated/scaled half extents.
+			The quad is 1x1 and flat, so only the first two columns are involved.
+		*/
+		glm::vec3 center = glm::vec3(transform[3]);
+		glm::vec3 extents = (glm::abs(glm::vec3(transform[0])) + glm::abs(glm::vec3(transform[1]))) * 0.5f;
+
+		return {center - extents, center + extents};
+	}
+
+	bool Ray::Intersects(const AABB &box, float maxDistance, float &outDistance) const
+	{
+		float tMin = 0.0f;
+		float tMax = maxDistance;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (glm::abs(Direction[axis]) < std::numeric_limits<float>::epsilon())
+			{
+				// The ray is parallel to the slab, it has to start inside it
+				if (Origin[axis] < box.Min[axis] || Origin[axis] > box.Max[axis])
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			float invDirection = 1.0f / Direction[axis];
+			float t1 = (box.Min[axis] - Origin[axis]) * invDirection;
+			float t2 = (box.Max[axis] - Origin[axis]) * invDirection;
+			if (t1 > t2)
+			{
+				std::swap(t1, t2);
+			}
+
+			tMin = glm::max(tMin, t1);
+			tMax = glm::min(tMax, t2);
+			if (tMin > tMax)
+			{
+				return false;
+			}
+		}
+
+		outDistance = tMin;
+		return true;
+	}
+
+	DynamicAABBTree::DynamicAABBTree()
+	{
+		m_Nodes.reserve(64);
+	}
+
+	int32_t DynamicAABBTree::AllocateNode()
+	{
+		// Grow the pool if there are no free nodes left, chaining the new nodes in the free list
+		if (m_FreeList == NullNode)
+		{
+			int32_t oldCapacity = (int32_t)m_Nodes.size();
+			int32_t newCapacity = oldCapacity == 0 ? 16 : oldCapacity * 2;
+			m_Nodes.resize(newCapacity);
+
+			for (int32_t i = oldCapacity; i < newCapacity - 1; i++)
+			{
+				m_Nodes[i].Next = i + 1;
+				m_Nodes[i].Height = -1;
+			}
+			m_Nodes[newCapacity - 1].Next = NullNode;
+			m_Nodes[newCapacity - 1].Height = -1;
+
+			m_FreeList = oldCapacity;
+		}
+
+		int32_t nodeID = m_FreeList;
+		TreeNode &node = m_Nodes[nodeID];
+		m_FreeList = node.Next;
+
+		node.Parent = NullNode;
+		node.Child1 = NullNode;
+		node.Child2 = NullNode;
+		node.Height = 0;
+		node.UserData = 0;
+
+		return nodeID;
+	}
+
+	void DynamicAABBTree::FreeNode(int32_t nodeID)
+	{
+		AK_CORE_ASSERT(0 <= nodeID && nodeID < (int32_t)m_Nodes.size(), "Invalid tree node!");
+
+		m_Nodes[nodeID].Next = m_FreeList;
+		m_Nodes[nodeID].Height = -1;
+		m_FreeList = nodeID;
+	}
+
+	int32_t DynamicAABBTree::CreateProxy(const AABB &aabb, uint32_t userData)
+	{
+		int32_t proxyID = AllocateNode();
+
+		glm::vec3 margin(s_AABBMargin);
+		TreeNode &node = m_Nodes[proxyID];
+		node.Box = {aabb.Min - margin, aabb.Max + margin};
+		node.UserData = userData;
+		node.Height = 0;
+
+		InsertLeaf(proxyID);
+		m_ProxyCount++;
+
+		return proxyID;
+	}
+
+	void DynamicAABBTree::DestroyProxy(int32_t proxyID)
+	{
+		AK_CORE_ASSERT(0 <= proxyID && proxyID < (int32_t)m_Nodes.size(), "Invalid proxy!");
+		AK_CORE_ASSERT(m_Nodes[proxyID].IsLeaf(), "Proxy is not a leaf!");
+
+		RemoveLeaf(proxyID);
+		FreeNode(proxyID);
+		m_ProxyCount--;
+	}
+
+	bool DynamicAABBTree::MoveProxy(int32_t proxyID, const AABB &aabb, const glm::vec3 &displacement)
+	{
+		AK_CORE_ASSERT(0 <= proxyID && proxyID < (int32_t)m_Nodes.size(), "Invalid proxy!");
+		AK_CORE_ASSERT(m_Nodes[proxyID].IsLeaf(), "Proxy is not a leaf!");
+
+		const AABB &fatAABB = m_Nodes[proxyID].Box;
+		if (fatAABB.Contains(aabb))
+		{
+			/*
+				The tight bounds are still inside the fat ones, but if the proxy shrank a lot (or was teleported inside a big fat box)
+				the fat bounds would be way too large for the queries, so only keep them when they are not much bigger than needed.
+			*/
+			glm::vec3 margin(4.0f * s_AABBMargin);
+			AABB hugeAABB = {aabb.Min - margin - glm::abs(displacement) * s_DisplacementMultiplier, aabb.Max + margin + glm::abs(displacement) * s_DisplacementMultiplier};
+			if (hugeAABB.Contains(fatAABB))
+			{
+				return false;
+			}
+		}
+
+		RemoveLeaf(proxyID);
+
+		// Extend the AABB, and predict the motion by extending it in the direction of the displacement
+		glm::vec3 margin(s_AABBMargin);
+		AABB fat = {aabb.Min - margin, aabb.Max + margin};
+		glm::vec3 d = displacement * s_DisplacementMultiplier;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (d[axis] < 0.0f)
+			{
+				fat.Min[axis] += d[axis];
+			}
+			else
+			{
+				fat.Max[axis] += d[axis];
+			}
+		}
+
+		m_Nodes[proxyID].Box = fat;
+
+		InsertLeaf(proxyID);
+		return true;
+	}
+
+	uint32_t DynamicAABBTree::GetUserData(int32_t proxyID) const
+	{
+		AK_CORE_ASSERT(0 <= proxyID && proxyID < (int32_t)m_Nodes.size(), "Invalid proxy!");
+		return m_Nodes[proxyID].UserData;
+	}
+
+	const AABB &DynamicAABBTree::GetFatAABB(int32_t proxyID) const
+	{
+		AK_CORE_ASSERT(0 <= proxyID && proxyID < (int32_t)m_Nodes.size(), "Invalid proxy!");
+		return m_Nodes[proxyID].Box;
+	}
+
+	int32_t DynamicAABBTree::GetHeight() const
+	{
+		return m_Root == NullNode ? 0 : m_Nodes[m_Root].Height;
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_Nodes.clear();
+		m_Root = NullNode;
+		m_FreeList = NullNode;
+		m_ProxyCount = 0;
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32_t leaf)
+	{
+		if (m_Root == NullNode)
+		{
+			m_Root = leaf;
+			m_Nodes[m_Root].Parent = NullNode;
+			return;
+		}
+
+		// Find the best sibling for this node, using the surface area heuristic
+		AABB leafAABB = m_Nodes[leaf].Box;
+		int32_t index = m_Root;
+		while (!m_Nodes[index].IsLeaf())
+		{
+			const TreeNode &node = m_Nodes[index];
+			int32_t child1 = node.Child1;
+			int32_t child2 = node.Child2;
+
+			float area = node.Box.GetPerimeter();
+			float combinedArea = AABB::Combine(node.Box, leafAABB).GetPerimeter();
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto descendCost = [&](int32_t child)
+			{
+				const AABB &childAABB = m_Nodes[child].Box;
+				float newArea = AABB::Combine(leafAABB, childAABB).GetPerimeter();
+				if (m_Nodes[child].IsLeaf())
+				{
+					return newArea + inheritanceCost;
+				}
+				return (newArea - childAABB.GetPerimeter()) + inheritanceCost;
+			};
+
+			float cost1 = descendCost(child1);
+			float cost2 = descendCost(child2);
+
+			// Descend according to the minimum cost
+			if (cost < cost1 && cost < cost2)
+			{
+				break;
+			}
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		int32_t sibling = index;
+
+		// Create a new parent
+		int32_t oldParent = m_Nodes[sibling].Parent;
+		int32_t newParent = AllocateNode();
+		m_Nodes[newParent].Parent = oldParent;
+		m_Nodes[newParent].Box = AABB::Combine(leafAABB, m_Nodes[sibling].Box);
+		m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+
+		if (oldParent != NullNode)
+		{
+			// The sibling was not the root
+			if (m_Nodes[oldParent].Child1 == sibling)
+			{
+				m_Nodes[oldParent].Child1 = newParent;
+			}
+			else
+			{
+				m_Nodes[oldParent].Child2 = newParent;
+			}
+		}
+		else
+		{
+			// The sibling was the root
+			m_Root = newParent;
+		}
+
+		m_Nodes[newParent].Child1 = sibling;
+		m_Nodes[newParent].Child2 = leaf;
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		// Walk back up the tree fixing heights and AABBs
+		index = m_Nodes[leaf].Parent;
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			int32_t child1 = m_Nodes[index].Child1;
+			int32_t child2 = m_Nodes[index].Child2;
+
+			m_Nodes[index].Height = 1 + glm::max(m_Nodes[child1].Height, m_Nodes[child2].Height);
+			m_Nodes[index].Box = AABB::Combine(m_Nodes[child1].Box, m_Nodes[child2].Box);
+
+			index = m_Nodes[index].Parent;
+		}
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = NullNode;
+			return;
+		}
+
+		int32_t parent = m_Nodes[leaf].Parent;
+		int32_t grandParent = m_Nodes[parent].Parent;
+		int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+		if (grandParent != NullNode)
+		{
+			// Destroy the parent and connect the sibling to the grand parent
+			if (m_Nodes[grandParent].Child1 == parent)
+			{
+				m_Nodes[grandParent].Child1 = sibling;
+			}
+			else
+			{
+				m_Nodes[grandParent].Child2 = sibling;
+			}
+			m_Nodes[sibling].Parent = grandParent;
+			FreeNode(parent);
+
+			// Adjust the ancestor bounds
+			int32_t index = grandParent;
+			while (index != NullNode)
+			{
+				index = Balance(index);
+
+				int32_t child1 = m_Nodes[index].Child1;
+				int32_t child2 = m_Nodes[index].Child2;
+
+				m_Nodes[index].Box = AABB::Combine(m_Nodes[child1].Box, m_Nodes[child2].Box);
+				m_Nodes[index].Height = 1 + glm::max(m_Nodes[child1].Height, m_Nodes[child2].Height);
+
+				index = m_Nodes[index].Parent;
+			}
+		}
+		else
+		{
+			m_Root = sibling;
+			m_Nodes[sibling].Parent = NullNode;
+			FreeNode(parent);
+		}
+	}
+
+	/*
+		Performs a left or right rotation if the node A is imbalanced (the height of its two subtrees differ by more than one).
+		Returns the new root index of the subtree.
+
+		        A
+		      /   \
+		     B     C
+		    / \   / \
+		   D   E F   G
+	*/
+	int32_t DynamicAABBTree::Balance(int32_t iA)
+	{
+		AK_CORE_ASSERT(iA != NullNode, "Invalid tree node!");
+
+		TreeNode &A = m_Nodes[iA];
+		if (A.IsLeaf() || A.Height < 2)
+		{
+			return iA;
+		}
+
+		int32_t iB = A.Child1;
+		int32_t iC = A.Child2;
+		TreeNode &B = m_Nodes[iB];
+		TreeNode &C = m_Nodes[iC];
+
+		int32_t balance = C.Height - B.Height;
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			int32_t iF = C.Child1;
+			int32_t iG = C.Child2;
+			TreeNode &F = m_Nodes[iF];
+			TreeNode &G = m_Nodes[iG];
+
+			// Swap A and C
+			C.Child1 = iA;
+			C.Parent = A.Parent;
+			A.Parent = iC;
+
+			// A's old parent should point to C
+			if (C.Parent != NullNode)
+			{
+				if (m_Nodes[C.Parent].Child1 == iA)
+				{
+					m_Nodes[C.Parent].Child1 = iC;
+				}
+				else
+				{
+					m_Nodes[C.Parent].Child2 = iC;
+				}
+			}
+			else
+			{
+				m_Root = iC;
+			}
+
+			// Rotate
+			if (F.Height > G.Height)
+			{
+				C.Child2 = iF;
+				A.Child2 = iG;
+				G.Parent = iA;
+				A.Box = AABB::Combine(B.Box, G.Box);
+				C.Box = AABB::Combine(A.Box, F.Box);
+
+				A.Height = 1 + glm::max(B.Height, G.Height);
+				C.Height = 1 + glm::max(A.Height, F.Height);
+			}
+			else
+			{
+				C.Child2 = iG;
+				A.Child2 = iF;
+				F.Parent = iA;
+				A.Box = AABB::Combine(B.Box, F.Box);
+				C.Box = AABB::Combine(A.Box, G.Box);
+
+				A.Height = 1 + glm::max(B.Height, F.Height);
+				C.Height = 1 + glm::max(A.Height, G.Height);
+			}
+
+			return iC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			int32_t iD = B.Child1;
+			int32_t iE = B.Child2;
+			TreeNode &D = m_Nodes[iD];
+			TreeNode &E = m_Nodes[iE];
+
+			// Swap A and B
+			B.Child1 = iA;
+			B.Parent = A.Parent;
+			A.Parent = iB;
+
+			// A's old parent should point to B
+			if (B.Parent != NullNode)
+			{
+				if (m_Nodes[B.Parent].Child1 == iA)
+				{
+					m_Nodes[B.Parent].Child1 = iB;
+				}
+				else
+				{
+					m_Nodes[B.Parent].Child2 = iB;
+				}
+			}
+			else
+			{
+				m_Root = iB;
+			}
+
+			// Rotate
+			if (D.Height > E.Height)
+			{
+				B.Child2 = iD;
+				A.Child1 = iE;
+				E.Parent = iA;
+				A.Box = AABB::Combine(C.Box, E.Box);
+				B.Box = AABB::Combine(A.Box, D.Box);
+
+				A.Height = 1 + glm::max(C.Height, E.Height);
+				B.Height = 1 + glm::max(A.Height, D.Height);
+			}
+			else
+			{
+				B.Child2 = iE;
+				A.Child1 = iD;
+				D.Parent = iA;
+				A.Box = AABB::Combine(C.Box, D.Box);
+				B.Box = AABB::Combine(A.Box, E.Box);
+
+				A.Height = 1 + glm::max(C.Height, D.Height);
+				B.Height = 1 + glm::max(A.Height, E.Height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+}
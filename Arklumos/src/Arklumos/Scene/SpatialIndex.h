@@ -0,0 +1,288 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Arklumos
+{
+
+	// Axis aligned bounding box used by the spatial queries of the Scene
+	struct AABB
+	{
+		glm::vec3 Min = {0.0f, 0.0f, 0.0f};
+		glm::vec3 Max = {0.0f, 0.0f, 0.0f};
+
+		AABB() = default;
+		AABB(const glm::vec3 &min, const glm::vec3 &max)
+				: Min(min), Max(max) {}
+
+		glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		// Half of the surface area, used as the cost heuristic by the tree (the factor 2 is irrelevant for comparisons)
+		float GetPerimeter() const
+		{
+			glm::vec3 d = Max - Min;
+			return d.x * d.y + d.y * d.z + d.z * d.x;
+		}
+
+		bool Contains(const AABB &other) const
+		{
+			return Min.x <= other.Min.x && Min.y <= other.Min.y && Min.z <= other.Min.z &&
+						 other.Max.x <= Max.x && other.Max.y <= Max.y && other.Max.z <= Max.z;
+		}
+
+		bool Contains(const glm::vec3 &point) const
+		{
+			return Min.x <= point.x && Min.y <= point.y && Min.z <= point.z &&
+						 point.x <= Max.x && point.y <= Max.y && point.z <= Max.z;
+		}
+
+		bool Overlaps(const AABB &other) const
+		{
+			return Min.x <= other.Max.x && Min.y <= other.Max.y && Min.z <= other.Max.z &&
+						 other.Min.x <= Max.x && other.Min.y <= Max.y && other.Min.z <= Max.z;
+		}
+
+		static AABB Combine(const AABB &a, const AABB &b)
+		{
+			return {glm::min(a.Min, b.Min), glm::max(a.Max, b.Max)};
+		}
+
+		// Bounds of the unit quad (-0.5 .. 0.5 on X/Y, as drawn by Renderer2D) once moved by the given transform
+		static AABB FromQuad(const glm::mat4 &transform);
+	};
+
+	struct Ray
+	{
+		glm::vec3 Origin = {0.0f, 0.0f, 0.0f};
+		glm::vec3 Direction = {0.0f, 0.0f, -1.0f};
+
+		Ray() = default;
+		Ray(const glm::vec3 &origin, const glm::vec3 &direction)
+				: Origin(origin), Direction(direction) {}
+
+		glm::vec3 GetPoint(float distance) const { return Origin + Direction * distance; }
+
+		// Slab test, returns the entry distance along the ray in outDistance (0 when the origin is inside the box)
+		bool Intersects(const AABB &box, float maxDistance, float &outDistance) const;
+	};
+
+	/*
+		Dynamic AABB tree (bounding volume hierarchy) used as the broadphase of the Scene.
+
+		Each proxy is a leaf of a binary tree whose internal nodes store the union of the bounds of their children.
+		Leaves store a "fat" AABB (the real bounds enlarged by a margin) so that small movements don't require touching the tree at all:
+		MoveProxy only re-inserts a leaf when its tight bounds leave the fat bounds.
+
+		Insertion walks down the tree choosing the child that increases the total surface area the least, and the tree is kept balanced with rotations on the way back up,
+		so queries stay O(log n) even when proxies are inserted in a spatially ordered way (which is what happens when loading a scene).
+
+		Nodes live in a single contiguous pool (indices instead of pointers) with a free list, so creating/destroying proxies does not allocate once the pool is warm.
+	*/
+	class DynamicAABBTree
+	{
+	public:
+		static constexpr int32_t NullNode = -1;
+
+		DynamicAABBTree();
+
+		// Creates a proxy in the tree as a leaf node, returns its index. userData is what the queries report back (the entity for the Scene)
+		int32_t CreateProxy(const AABB &aabb, uint32_t userData);
+		void DestroyProxy(int32_t proxyID);
+
+		/*
+			Moves a proxy. If the new bounds are still inside the fat AABB nothing is done and false is returned.
+			Otherwise the proxy is re-inserted with new fat bounds (extended along the displacement to anticipate the motion) and true is returned.
+		*/
+		bool MoveProxy(int32_t proxyID, const AABB &aabb, const glm::vec3 &displacement = glm::vec3(0.0f));
+
+		uint32_t GetUserData(int32_t proxyID) const;
+		const AABB &GetFatAABB(int32_t proxyID) const;
+
+		uint32_t GetProxyCount() const { return m_ProxyCount; }
+		int32_t GetHeight() const;
+		void Clear();
+
+		/*
+			Query functions, the callback is invoked for each proxy whose fat AABB matches.
+			The callback returns false to stop the query early.
+		*/
+		template <typename F>
+		void Query(const AABB &aabb, F &&callback) const
+		{
+			if (m_Root == NullNode)
+			{
+				return;
+			}
+
+			TraversalStack stack;
+			stack.Push(m_Root);
+
+			while (!stack.Empty())
+			{
+				int32_t nodeID = stack.Pop();
+
+				const TreeNode &node = m_Nodes[nodeID];
+				if (!node.Box.Overlaps(aabb))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					if (!callback(nodeID))
+					{
+						return;
+					}
+				}
+				else
+				{
+					stack.Push(node.Child1);
+					stack.Push(node.Child2);
+				}
+			}
+		}
+
+		template <typename F>
+		void Query(const glm::vec3 &point, F &&callback) const
+		{
+			Query(AABB(point, point), std::forward<F>(callback));
+		}
+
+		/*
+			Ray cast against the proxies in the tree. The callback receives (proxyID, ray, maxDistance) and returns:
+				- a negative value to ignore the proxy and continue,
+				- 0 to terminate the ray cast,
+				- a distance to clip the ray (the closest hit so far), so farther subtrees get culled.
+		*/
+		template <typename F>
+		void Raycast(const Ray &ray, float maxDistance, F &&callback) const
+		{
+			if (m_Root == NullNode)
+			{
+				return;
+			}
+
+			TraversalStack stack;
+			stack.Push(m_Root);
+
+			while (!stack.Empty())
+			{
+				int32_t nodeID = stack.Pop();
+
+				const TreeNode &node = m_Nodes[nodeID];
+				float entry;
+				if (!ray.Intersects(node.Box, maxDistance, entry))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					float value = callback(nodeID, ray, maxDistance);
+					if (value == 0.0f)
+					{
+						// The client has terminated the ray cast
+						return;
+					}
+
+					if (value > 0.0f)
+					{
+						maxDistance = value;
+					}
+				}
+				else
+				{
+					stack.Push(node.Child1);
+					stack.Push(node.Child2);
+				}
+			}
+		}
+
+	private:
+		/*
+			Traversal stack of one query, local to the call: a callback can query the tree again, and the systems running on the JobSystem can query it in parallel.
+			A depth first traversal holds at most one node per level plus one, the balanced tree of millions of proxies stays within the inline array,
+			only a degenerate tree spills to the heap.
+		*/
+		class TraversalStack
+		{
+		public:
+			void Push(int32_t nodeID)
+			{
+				if (m_Size < InlineCapacity)
+				{
+					m_Inline[m_Size] = nodeID;
+				}
+				else
+				{
+					m_Spill.push_back(nodeID);
+				}
+				m_Size++;
+			}
+
+			int32_t Pop()
+			{
+				m_Size--;
+				if (m_Size < InlineCapacity)
+				{
+					return m_Inline[m_Size];
+				}
+
+				int32_t nodeID = m_Spill.back();
+				m_Spill.pop_back();
+				return nodeID;
+			}
+
+			bool Empty() const { return m_Size == 0; }
+
+		private:
+			static constexpr uint32_t InlineCapacity = 64;
+
+			int32_t m_Inline[InlineCapacity];
+			std::vector<int32_t> m_Spill;
+			uint32_t m_Size = 0;
+		};
+
+		struct TreeNode
+		{
+			AABB Box;
+			uint32_t UserData = 0;
+
+			union
+			{
+				int32_t Parent;
+				int32_t Next;
+			};
+
+			int32_t Child1 = NullNode;
+			int32_t Child2 = NullNode;
+
+			// Leaf = 0, free node = -1
+			int32_t Height = -1;
+
+			TreeNode() : Parent(NullNode) {}
+
+			bool IsLeaf() const { return Child1 == NullNode; }
+		};
+
+		int32_t AllocateNode();
+		void FreeNode(int32_t nodeID);
+
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+
+		int32_t Balance(int32_t index);
+
+		std::vector<TreeNode> m_Nodes;
+		int32_t m_Root = NullNode;
+		int32_t m_FreeList = NullNode;
+		uint32_t m_ProxyCount = 0;
+	};
+
+}
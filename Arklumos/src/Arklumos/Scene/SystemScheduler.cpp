@@ -0,0 +1,148 @@
+#include "akpch.h"
+#include "Arklumos/Scene/SystemScheduler.h"
+
+#include <algorithm>
+
+namespace Arklumos
+{
+
+	static bool Contains(const std::vector<entt::id_type> &components, entt::id_type component)
+	{
+		return std::find(components.begin(), components.end(), component) != components.end();
+	}
+
+	bool SystemAccess::ConflictsWith(const SystemAccess &other) const
+	{
+		if (Exclusive || other.Exclusive)
+		{
+			return true;
+		}
+
+		for (entt::id_type component : Writes)
+		{
+			if (Contains(other.Reads, component) || Contains(other.Writes, component))
+			{
+				return true;
+			}
+		}
+
+		for (entt::id_type component : other.Writes)
+		{
+			if (Contains(Reads, component))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	class ExclusiveSystem : public System
+	{
+	public:
+		ExclusiveSystem(const char *name, std::function<void(entt::registry &, Timestep)> function)
+			: System(name, SystemAccess{{}, {}, true}, 0), m_Function(std::move(function)) {}
+
+		virtual void Prepare(entt::registry &registry) override { m_Registry = &registry; }
+		virtual void Execute(Timestep ts) override { m_Function(*m_Registry, ts); }
+
+	private:
+		std::function<void(entt::registry &, Timestep)> m_Function;
+		entt::registry *m_Registry = nullptr;
+	};
+
+	void SystemScheduler::AddExclusiveSystem(const char *name, std::function<void(entt::registry &, Timestep)> function)
+	{
+		AddSystem(CreateScope<ExclusiveSystem>(name, std::move(function)));
+	}
+
+	void SystemScheduler::AddSystem(Scope<System> system)
+	{
+		m_Systems.push_back(std::move(system));
+		m_StagesDirty = true;
+	}
+
+	void SystemScheduler::Clear()
+	{
+		m_Systems.clear();
+		m_Stages.clear();
+		m_StagesDirty = false;
+	}
+
+	size_t SystemScheduler::GetStageCount()
+	{
+		if (m_StagesDirty)
+		{
+			BuildStages();
+		}
+		return m_Stages.size();
+	}
+
+	void SystemScheduler::BuildStages()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		m_Stages.clear();
+
+		std::vector<size_t> systemStages(m_Systems.size());
+		for (size_t i = 0; i < m_Systems.size(); i++)
+		{
+			// After the last stage containing an earlier system this one conflicts with
+			size_t stage = 0;
+			for (size_t j = 0; j < i; j++)
+			{
+				if (m_Systems[i]->GetAccess().ConflictsWith(m_Systems[j]->GetAccess()))
+				{
+					stage = std::max(stage, systemStages[j] + 1);
+				}
+			}
+
+			systemStages[i] = stage;
+			if (stage == m_Stages.size())
+			{
+				m_Stages.emplace_back();
+			}
+			m_Stages[stage].push_back(m_Systems[i].get());
+		}
+
+		m_StagesDirty = false;
+	}
+
+	void SystemScheduler::Run(entt::registry &registry, Timestep ts)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		AK_CORE_ASSERT(JobSystem::IsMainThread(), "The systems are run from the main thread!");
+
+		if (m_StagesDirty)
+		{
+			BuildStages();
+		}
+
+		for (auto &stage : m_Stages)
+		{
+			// The views are created on the main thread, after the exclusive systems of the previous stages (which may have changed the pools)
+			for (System *system : stage)
+			{
+				system->Prepare(registry);
+			}
+
+			// A stage with a single system (always the case of an exclusive one) runs on the main thread, its chunks still go to the workers
+			if (stage.size() == 1)
+			{
+				stage[0]->Execute(ts);
+				continue;
+			}
+
+			JobCounter counter;
+			for (System *system : stage)
+			{
+				JobSystem::Run(system->GetName(), [system, ts]()
+											 { system->Execute(ts); },
+											 &counter);
+			}
+			JobSystem::Wait(counter);
+		}
+	}
+
+}
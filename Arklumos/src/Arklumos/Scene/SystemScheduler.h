@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Arklumos/Core/Base.h"
+#include "Arklumos/Core/JobSystem.h"
+#include "Arklumos/Core/Timestep.h"
+
+#include "entt.hpp"
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Arklumos
+{
+
+	// Lists of the components a system reads and writes, see SystemScheduler::AddSystem
+	template <typename... Components>
+	struct Read
+	{
+	};
+
+	template <typename... Components>
+	struct Write
+	{
+	};
+
+	/*
+		Components a system accesses. Two systems conflict when one of them writes a component the other one reads or writes,
+		an exclusive system conflicts with every other system.
+	*/
+	struct SystemAccess
+	{
+		std::vector<entt::id_type> Reads;
+		std::vector<entt::id_type> Writes;
+		bool Exclusive = false;
+
+		bool ConflictsWith(const SystemAccess &other) const;
+	};
+
+	class System
+	{
+	public:
+		System(const char *name, SystemAccess access, size_t grainSize)
+			: m_Name(name), m_Access(std::move(access)), m_GrainSize(grainSize) {}
+		virtual ~System() = default;
+
+		const char *GetName() const { return m_Name; }
+		const SystemAccess &GetAccess() const { return m_Access; }
+
+		// Called on the main thread right before the stage of the system runs (creating the views may create pools, which isn't thread safe)
+		virtual void Prepare(entt::registry &registry) = 0;
+
+		// Called on any thread of the JobSystem, at the same time as the other systems of the stage
+		virtual void Execute(Timestep ts) = 0;
+
+	protected:
+		const char *m_Name;
+		SystemAccess m_Access;
+		size_t m_GrainSize;
+	};
+
+	template <typename ReadList, typename WriteList, typename Function>
+	class ViewSystem;
+
+	/*
+		System iterating the entities that have all its components, in chunks of grainSize entities spread over the JobSystem.
+		The function receives (Timestep, entt::entity, const ReadComponents &..., WriteComponents &...) and is called concurrently for different entities.
+	*/
+	template <typename... ReadComponents, typename... WriteComponents, typename Function>
+	class ViewSystem<Read<ReadComponents...>, Write<WriteComponents...>, Function> : public System
+	{
+	public:
+		ViewSystem(const char *name, Function function, size_t grainSize)
+			: System(name, SystemAccess{{entt::type_info<ReadComponents>::id()...}, {entt::type_info<WriteComponents>::id()...}}, grainSize), m_Function(std::move(function))
+		{
+			static_assert(sizeof...(ReadComponents) + sizeof...(WriteComponents) > 0, "A system needs at least one component!");
+		}
+
+		virtual void Prepare(entt::registry &registry) override
+		{
+			m_View.emplace(registry.view<const ReadComponents..., WriteComponents...>());
+
+			// The entities are taken from the smallest pool, the other components are checked for each of them
+			m_Candidates = nullptr;
+			m_CandidateCount = std::numeric_limits<size_t>::max();
+			auto selectPool = [this](size_t size, const entt::entity *entities)
+			{
+				if (size < m_CandidateCount)
+				{
+					m_CandidateCount = size;
+					m_Candidates = entities;
+				}
+			};
+			(selectPool(registry.size<ReadComponents>(), registry.data<ReadComponents>()), ...);
+			(selectPool(registry.size<WriteComponents>(), registry.data<WriteComponents>()), ...);
+		}
+
+		virtual void Execute(Timestep ts) override
+		{
+			const ViewType &view = *m_View;
+			const entt::entity *candidates = m_Candidates;
+
+			// Each chunk touches its own entities, so the chunks write to different components
+			JobSystem::ParallelFor(m_Name, m_CandidateCount, m_GrainSize, [&](size_t begin, size_t end)
+														 {
+															 for (size_t i = begin; i < end; i++)
+															 {
+																 entt::entity entity = candidates[i];
+																 if (view.contains(entity))
+																 {
+																	 m_Function(ts, entity, view.template get<const ReadComponents>(entity)..., view.template get<WriteComponents>(entity)...);
+																 }
+															 } });
+		}
+
+	private:
+		using ViewType = decltype(std::declval<entt::registry &>().view<const ReadComponents..., WriteComponents...>());
+
+		Function m_Function;
+		std::optional<ViewType> m_View;
+		const entt::entity *m_Candidates = nullptr;
+		size_t m_CandidateCount = 0;
+	};
+
+	/*
+		Runs the gameplay systems of a scene in parallel.
+
+		Each system declares the components it reads and writes. The systems are sorted in stages from these declarations:
+		a system goes in the first stage after every earlier system it conflicts with, so the systems of a stage never touch the same data
+		(except for reading it) and run at the same time, each of them split in chunks over the JobSystem.
+		Systems that conflict keep their registration order.
+
+		The systems mustn't create or destroy entities nor add or remove components, the pools would change under the other systems.
+		Exclusive systems run alone on the main thread, with the whole registry available, for the logic that needs to do so.
+	*/
+	class SystemScheduler
+	{
+	public:
+		/*
+			scheduler.AddSystem<Read<VelocityComponent>, Write<TransformComponent>>("Movement", [](Timestep ts, entt::entity entity, const VelocityComponent &velocity, TransformComponent &transform)
+			{ transform.Translation += velocity.Velocity * ts.GetSeconds(); });
+
+			The components must have data, a tag (an empty struct) can't be passed to the function.
+		*/
+		template <typename ReadList, typename WriteList, typename Function>
+		void AddSystem(const char *name, Function function, size_t grainSize = 1024)
+		{
+			AddSystem(CreateScope<ViewSystem<ReadList, WriteList, Function>>(name, std::move(function), grainSize));
+		}
+
+		void AddExclusiveSystem(const char *name, std::function<void(entt::registry &, Timestep)> function);
+		void AddSystem(Scope<System> system);
+		void Clear();
+
+		// Runs every system, stage after stage, returns once they are all done. Called from the main thread
+		void Run(entt::registry &registry, Timestep ts);
+
+		size_t GetSystemCount() const { return m_Systems.size(); }
+		size_t GetStageCount();
+
+	private:
+		void BuildStages();
+
+		std::vector<Scope<System>> m_Systems;
+		std::vector<std::vector<System *>> m_Stages;
+		bool m_StagesDirty = false;
+	};
+
+}
@@ -11,21 +11,27 @@ namespace Arklumos
 	/////////////////////////////////////////////////////////////////////////////
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+			: m_Size(size)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		glCreateBuffers(1, &m_RendererID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+
+		AK_TRACK_GPU_MEMORY(Buffers, m_Size);
 	}
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float *vertices, uint32_t size)
+			: m_Size(size)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		glCreateBuffers(1, &m_RendererID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+
+		AK_TRACK_GPU_MEMORY(Buffers, m_Size);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
@@ -33,6 +39,8 @@ namespace Arklumos
 		// AK_PROFILE_FUNCTION();
 
 		glDeleteBuffers(1, &m_RendererID);
+
+		AK_TRACK_GPU_MEMORY(Buffers, -(int64_t)m_Size);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
@@ -70,6 +78,8 @@ namespace Arklumos
 		// Binding with GL_ARRAY_BUFFER allows the data to be loaded regardless of VAO state.
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferData(GL_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+
+		AK_TRACK_GPU_MEMORY(Buffers, m_Count * sizeof(uint32_t));
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
@@ -77,6 +87,8 @@ namespace Arklumos
 		// AK_PROFILE_FUNCTION();
 
 		glDeleteBuffers(1, &m_RendererID);
+
+		AK_TRACK_GPU_MEMORY(Buffers, -(int64_t)(m_Count * sizeof(uint32_t)));
 	}
 
 	void OpenGLIndexBuffer::Bind() const
@@ -22,6 +22,7 @@ namespace Arklumos
 
 	private:
 		uint32_t m_RendererID;
+		uint32_t m_Size;
 		BufferLayout m_Layout;
 	};
 
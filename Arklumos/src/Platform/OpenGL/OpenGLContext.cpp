@@ -36,4 +36,14 @@ namespace Arklumos
 		glfwSwapBuffers(m_WindowHandle);
 	}
 
+	void OpenGLContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_WindowHandle);
+	}
+
+	void OpenGLContext::DetachCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "akpch.h"
+#include "Platform/OpenGL/OpenGLFence.h"
+
+namespace Arklumos
+{
+
+	OpenGLFence::OpenGLFence()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		/*
+			Querying GL_TIMESTAMP returns the GPU time once the previous commands reached the driver (without waiting for their execution),
+			while the query counter is written when the GPU actually executes it: the difference is the time the GPU needed to catch up with the fence.
+		*/
+		glGetInteger64v(GL_TIMESTAMP, &m_InsertionTime);
+		glGenQueries(1, &m_TimestampQuery);
+		glQueryCounter(m_TimestampQuery, GL_TIMESTAMP);
+
+		m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	OpenGLFence::~OpenGLFence()
+	{
+		glDeleteSync(m_Fence);
+		glDeleteQueries(1, &m_TimestampQuery);
+	}
+
+	bool OpenGLFence::Wait(uint64_t timeout)
+	{
+		if (m_Signaled)
+		{
+			return true;
+		}
+
+		// Flushing makes sure the fence reaches the GPU, otherwise waiting on it could never return
+		GLenum result = glClientWaitSync(m_Fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+		m_Signaled = result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+
+		AK_CORE_ASSERT(result != GL_WAIT_FAILED, "Waiting on a fence failed!");
+		return m_Signaled;
+	}
+
+	uint64_t OpenGLFence::GetGPUDuration()
+	{
+		AK_CORE_ASSERT(m_Signaled, "The fence isn't signaled yet!");
+
+		GLuint64 completionTime = 0;
+		glGetQueryObjectui64v(m_TimestampQuery, GL_QUERY_RESULT, &completionTime);
+		return completionTime > (GLuint64)m_InsertionTime ? completionTime - m_InsertionTime : 0;
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Arklumos/Renderer/GPUFence.h"
+
+#include <glad/glad.h>
+
+namespace Arklumos
+{
+
+	class OpenGLFence : public GPUFence
+	{
+	public:
+		OpenGLFence();
+		virtual ~OpenGLFence();
+
+		virtual bool Wait(uint64_t timeout) override;
+		virtual uint64_t GetGPUDuration() override;
+
+	private:
+		GLsync m_Fence = nullptr;
+		// GL_TIMESTAMP query written when the GPU reaches the fence, and the GPU time when the fence was inserted
+		uint32_t m_TimestampQuery = 0;
+		GLint64 m_InsertionTime = 0;
+		bool m_Signaled = false;
+	};
+
+}
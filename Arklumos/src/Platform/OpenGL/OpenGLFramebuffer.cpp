@@ -1,6 +1,8 @@
 #include "akpch.h"
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
 
+#include "Arklumos/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Arklumos
@@ -79,20 +81,6 @@ namespace Arklumos
 			return false;
 		}
 
-		static GLenum HazelFBTextureFormatToGL(FramebufferTextureFormat format)
-		{
-			switch (format)
-			{
-			case FramebufferTextureFormat::RGBA8:
-				return GL_RGBA8;
-			case FramebufferTextureFormat::RED_INTEGER:
-				return GL_RED_INTEGER;
-			}
-
-			AK_CORE_ASSERT(false);
-			return 0;
-		}
-
 	}
 
 	OpenGLFramebuffer::OpenGLFramebuffer(const FramebufferSpecification &spec)
@@ -110,7 +98,8 @@ namespace Arklumos
 			}
 		}
 
-		Invalidate();
+		Renderer::Submit([this, spec = m_Specification]()
+										 { Invalidate(spec); });
 	}
 
 	OpenGLFramebuffer::~OpenGLFramebuffer()
@@ -120,10 +109,14 @@ namespace Arklumos
 		// Delete the two texture objects used for color and depth attachments, identified by the m_ColorAttachment and m_DepthAttachment member variables, respectively. Texture objects are used to store and manipulate texture images in OpenGL, and they can be used as attachments to a framebuffer object for rendering
 		glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
 		glDeleteTextures(1, &m_DepthAttachment);
+
+		AK_TRACK_GPU_MEMORY(Framebuffers, -m_AttachmentsMemorySize);
 	}
 
-	void OpenGLFramebuffer::Invalidate()
+	void OpenGLFramebuffer::Invalidate(const FramebufferSpecification &spec)
 	{
+		std::lock_guard lock(m_AttachmentsMutex);
+
 		/*
 			Checking if the m_RendererID member variable of the current object is not equal to zero. If m_RendererID is not zero, it means that the object has already been initialized with a valid OpenGL identifier for a framebuffer object.
 
@@ -137,12 +130,20 @@ namespace Arklumos
 		*/
 		if (m_RendererID)
 		{
-			glDeleteFramebuffers(1, &m_RendererID);
-			glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
-			glDeleteTextures(1, &m_DepthAttachment);
+			/*
+				With the render thread, the main thread may already have recorded the previous color attachment for the next frame (ImGui shows it in the viewport),
+				so the old objects are only deleted once that frame has been rendered.
+			*/
+			RenderThread::SubmitResourceFree([framebuffer = m_RendererID, colorAttachments = m_ColorAttachments, depthAttachment = m_DepthAttachment]()
+																			 {
+				glDeleteFramebuffers(1, &framebuffer);
+				glDeleteTextures(colorAttachments.size(), colorAttachments.data());
+				glDeleteTextures(1, &depthAttachment); });
 
 			m_ColorAttachments.clear();
 			m_DepthAttachment = 0;
+
+			AK_TRACK_GPU_MEMORY(Framebuffers, -m_AttachmentsMemorySize);
 		}
 
 		/*
@@ -155,7 +156,7 @@ namespace Arklumos
 		glCreateFramebuffers(1, &m_RendererID);
 		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 
-		bool multisample = m_Specification.Samples > 1;
+		bool multisample = spec.Samples > 1;
 
 		// Attachments
 		if (m_ColorAttachmentSpecifications.size())
@@ -169,10 +170,10 @@ namespace Arklumos
 				switch (m_ColorAttachmentSpecifications[i].TextureFormat)
 				{
 				case FramebufferTextureFormat::RGBA8:
-					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, m_Specification.Width, m_Specification.Height, i);
+					Utils::AttachColorTexture(m_ColorAttachments[i], spec.Samples, GL_RGBA8, GL_RGBA, spec.Width, spec.Height, i);
 					break;
 				case FramebufferTextureFormat::RED_INTEGER:
-					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, m_Specification.Width, m_Specification.Height, i);
+					Utils::AttachColorTexture(m_ColorAttachments[i], spec.Samples, GL_R32I, GL_RED_INTEGER, spec.Width, spec.Height, i);
 					break;
 				}
 			}
@@ -185,7 +186,7 @@ namespace Arklumos
 			switch (m_DepthAttachmentSpecification.TextureFormat)
 			{
 			case FramebufferTextureFormat::DEPTH24STENCIL8:
-				Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_Specification.Width, m_Specification.Height);
+				Utils::AttachDepthTexture(m_DepthAttachment, spec.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, spec.Width, spec.Height);
 				break;
 			}
 		}
@@ -204,6 +205,11 @@ namespace Arklumos
 
 		AK_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
+		// Every supported format (RGBA8, R32I, DEPTH24STENCIL8) takes 4 bytes per sample
+		size_t attachmentCount = m_ColorAttachments.size() + (m_DepthAttachment ? 1 : 0);
+		m_AttachmentsMemorySize = (int64_t)attachmentCount * 4 * spec.Width * spec.Height * std::max(spec.Samples, 1u);
+		AK_TRACK_GPU_MEMORY(Framebuffers, m_AttachmentsMemorySize);
+
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
@@ -219,13 +225,16 @@ namespace Arklumos
 	*/
 	void OpenGLFramebuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+		Renderer::Submit([this, width = m_Specification.Width, height = m_Specification.Height]()
+										 {
+			glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+			glViewport(0, 0, width, height); });
 	}
 
 	void OpenGLFramebuffer::Unbind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		Renderer::Submit([]()
+										 { glBindFramebuffer(GL_FRAMEBUFFER, 0); });
 	}
 
 	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
@@ -239,26 +248,16 @@ namespace Arklumos
 		m_Specification.Width = width;
 		m_Specification.Height = height;
 
-		Invalidate();
-	}
-
-	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
-	{
-		AK_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
-
-		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
-		int pixelData;
-		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
-		return pixelData;
+		Renderer::Submit([this, spec = m_Specification]()
+										 { Invalidate(spec); });
 	}
 
-	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+	uint32_t OpenGLFramebuffer::GetColorAttachmentRendererID(uint32_t index) const
 	{
-		AK_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+		std::lock_guard lock(m_AttachmentsMutex);
 
-		auto &spec = m_ColorAttachmentSpecifications[attachmentIndex];
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0,
-										Utils::HazelFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
+		AK_CORE_ASSERT(index < m_ColorAttachments.size());
+		return m_ColorAttachments[index];
 	}
 
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Arklumos/Renderer/Framebuffer.h"
 
+#include <mutex>
+
 namespace Arklumos
 {
 
@@ -11,21 +13,15 @@ namespace Arklumos
 		OpenGLFramebuffer(const FramebufferSpecification &spec);
 		virtual ~OpenGLFramebuffer();
 
-		void Invalidate();
+		// (Re)creates the framebuffer and its attachments, executed as a render command
+		void Invalidate(const FramebufferSpecification &spec);
 
 		virtual void Bind() override;
 		virtual void Unbind() override;
 
 		virtual void Resize(uint32_t width, uint32_t height) override;
-		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
-
-		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
 
-		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override
-		{
-			AK_CORE_ASSERT(index < m_ColorAttachments.size());
-			return m_ColorAttachments[index];
-		}
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override;
 
 		virtual const FramebufferSpecification &GetSpecification() const override { return m_Specification; }
 
@@ -39,6 +35,11 @@ namespace Arklumos
 
 		std::vector<uint32_t> m_ColorAttachments;
 		uint32_t m_DepthAttachment = 0;
+		// Memory of the attachments on the GPU, for the memory statistics
+		int64_t m_AttachmentsMemorySize = 0;
+
+		// The attachments are recreated by the render thread while the main thread reads their IDs (to show them with ImGui)
+		mutable std::mutex m_AttachmentsMutex;
 	};
 
 }
\ No newline at end of file
@@ -1,11 +1,22 @@
 #include "akpch.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
+#include "Arklumos/Core/Timer.h"
+#include "Arklumos/Renderer/ShaderHotReload.h"
+#include "Arklumos/Renderer/ShaderPreprocessor.h"
+#include "Arklumos/Renderer/UniformBuffer.h"
+
+#include <filesystem>
 #include <fstream>
 #include <glad/glad.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
+// GL_KHR_parallel_shader_compile (the loader is generated without extensions, the constant is the same for the ARB version)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace Arklumos
 {
 
@@ -25,27 +36,254 @@ namespace Arklumos
 		return 0;
 	}
 
+	/*
+		Program binary cache: the program linked by the driver is saved with glGetProgramBinary in a file named after the shader and the hash of its cache key,
+		the next launches load it with glProgramBinary instead of compiling and linking the sources again.
+
+		The key hashes the sources of the stages (as they are after the preprocessing) and the identity of the driver and of the GPU: a binary is only valid for the driver that produced it,
+		and a driver can still reject a binary it produced (after an update keeping the same version string), the shader is then compiled as if the cache was empty.
+	*/
+	static const char *s_ProgramCacheDirectory = "assets/cache/shader/opengl";
+
+	// Incremented when the format of the files or the way the key is computed changes
+	static constexpr uint32_t s_ProgramCacheVersion = 1;
+	static constexpr uint32_t s_ProgramCacheMagic = 0x42504B41; // "AKPB"
+
+	struct ProgramBinaryHeader
+	{
+		uint32_t Magic = s_ProgramCacheMagic;
+		uint32_t Version = s_ProgramCacheVersion;
+		uint64_t Key = 0;
+		uint32_t Format = 0;
+		uint32_t Size = 0;
+	};
+
+	// Queried once, some drivers don't support any binary format
+	static bool IsProgramCacheSupported()
+	{
+		static const bool supported = []()
+		{
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			if (formatCount == 0)
+			{
+				AK_CORE_WARN("The driver doesn't support program binaries, the shaders are compiled at each launch");
+			}
+			return formatCount > 0;
+		}();
+		return supported;
+	}
+
+	static std::string GetDriverIdentity()
+	{
+		std::string identity;
+		for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION})
+		{
+			const GLubyte *value = glGetString(name);
+			identity += value ? (const char *)value : "";
+			identity += '\n';
+		}
+		return identity;
+	}
+
+	static uint64_t GetProgramCacheKey(const std::unordered_map<GLenum, std::string> &shaderSources)
+	{
+		static const std::string driverIdentity = GetDriverIdentity();
+
+		// The stages are hashed in a fixed order, the iteration order of the map isn't
+		std::vector<GLenum> stages;
+		for (auto &kv : shaderSources)
+		{
+			stages.push_back(kv.first);
+		}
+		std::sort(stages.begin(), stages.end());
+
+		std::string key = driverIdentity + std::to_string(s_ProgramCacheVersion) + '\n';
+		for (GLenum stage : stages)
+		{
+			key += std::to_string(stage) + '\n';
+			key += shaderSources.at(stage);
+			key += '\0';
+		}
+		return StringId::Hash(key.data(), key.size());
+	}
+
+	/*
+		With GL_KHR_parallel_shader_compile, the driver compiles and links on its own threads: glCompileShader and glLinkProgram return right away,
+		and GL_COMPLETION_STATUS_KHR tells whether the program is ready without waiting. Without it, the first query of a status waits for the compilation.
+	*/
+	static bool IsParallelCompileSupported()
+	{
+		static const bool supported = []()
+		{
+			GLint extensionCount = 0;
+			glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+			for (GLint i = 0; i < extensionCount; i++)
+			{
+				const char *extension = (const char *)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+				if (strcmp(extension, "GL_KHR_parallel_shader_compile") == 0 || strcmp(extension, "GL_ARB_parallel_shader_compile") == 0)
+				{
+					return true;
+				}
+			}
+			AK_CORE_INFO("The driver doesn't support GL_KHR_parallel_shader_compile, the shaders are compiled one after another");
+			return false;
+		}();
+		return supported;
+	}
+
+	// The element count and the base type of a uniform of that type, 0 for the types that aren't copied
+	static int GetUniformComponentCount(GLenum type, bool &isInteger)
+	{
+		isInteger = false;
+		switch (type)
+		{
+		case GL_FLOAT:
+			return 1;
+		case GL_FLOAT_VEC2:
+			return 2;
+		case GL_FLOAT_VEC3:
+			return 3;
+		case GL_FLOAT_VEC4:
+			return 4;
+		case GL_FLOAT_MAT3:
+			return 9;
+		case GL_FLOAT_MAT4:
+			return 16;
+		}
+
+		isInteger = true;
+		switch (type)
+		{
+		case GL_INT:
+		case GL_BOOL:
+		case GL_SAMPLER_2D:
+		case GL_SAMPLER_2D_ARRAY:
+		case GL_SAMPLER_CUBE:
+		case GL_INT_SAMPLER_2D:
+		case GL_UNSIGNED_INT_SAMPLER_2D:
+			return 1;
+		case GL_INT_VEC2:
+			return 2;
+		case GL_INT_VEC3:
+			return 3;
+		case GL_INT_VEC4:
+			return 4;
+		}
+		return 0;
+	}
+
+	/*
+		Copies the values of the uniforms of a program to the uniforms with the same name and type of its replacement.
+		The values set once after the creation of a shader (the texture units of the samplers) survive a reload, the others are set every frame anyway.
+	*/
+	static void CopyUniformValues(GLuint source, GLuint destination)
+	{
+		GLint maxNameLength = 0;
+		glGetProgramiv(destination, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+
+		std::unordered_map<std::string, GLenum> sourceTypes;
+		GLint uniformCount = 0;
+		glGetProgramiv(source, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(source, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		nameBuffer.resize(std::max((size_t)maxNameLength, nameBuffer.size()));
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(source, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+			sourceTypes[std::string(nameBuffer.data(), length)] = type;
+		}
+
+		glGetProgramiv(destination, GL_ACTIVE_UNIFORMS, &uniformCount);
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(destination, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+			std::string name(nameBuffer.data(), length);
+
+			bool isInteger = false;
+			int componentCount = GetUniformComponentCount(type, isInteger);
+			auto sourceType = sourceTypes.find(name);
+			if (componentCount == 0 || sourceType == sourceTypes.end() || sourceType->second != type)
+			{
+				continue;
+			}
+
+			// The arrays are reported as "name[0]", each element is copied (the sizes of the array in the two programs can differ)
+			size_t bracket = name.find('[');
+			std::string baseName = name.substr(0, bracket);
+			for (GLint element = 0; element < size; element++)
+			{
+				std::string elementName = bracket == std::string::npos ? baseName : baseName + "[" + std::to_string(element) + "]";
+				GLint sourceLocation = glGetUniformLocation(source, elementName.c_str());
+				GLint destinationLocation = glGetUniformLocation(destination, elementName.c_str());
+				if (sourceLocation == -1 || destinationLocation == -1)
+				{
+					continue;
+				}
+
+				if (isInteger)
+				{
+					GLint values[4] = {};
+					glGetUniformiv(source, sourceLocation, values);
+					switch (componentCount)
+					{
+					case 1: glProgramUniform1iv(destination, destinationLocation, 1, values); break;
+					case 2: glProgramUniform2iv(destination, destinationLocation, 1, values); break;
+					case 3: glProgramUniform3iv(destination, destinationLocation, 1, values); break;
+					case 4: glProgramUniform4iv(destination, destinationLocation, 1, values); break;
+					}
+				}
+				else
+				{
+					GLfloat values[16] = {};
+					glGetUniformfv(source, sourceLocation, values);
+					switch (componentCount)
+					{
+					case 1: glProgramUniform1fv(destination, destinationLocation, 1, values); break;
+					case 2: glProgramUniform2fv(destination, destinationLocation, 1, values); break;
+					case 3: glProgramUniform3fv(destination, destinationLocation, 1, values); break;
+					case 4: glProgramUniform4fv(destination, destinationLocation, 1, values); break;
+					case 9: glProgramUniformMatrix3fv(destination, destinationLocation, 1, GL_FALSE, values); break;
+					case 16: glProgramUniformMatrix4fv(destination, destinationLocation, 1, GL_FALSE, values); break;
+					}
+				}
+			}
+		}
+	}
+
+	static std::filesystem::path GetProgramCachePath(const std::string &shaderName, uint64_t cacheKey)
+	{
+		std::stringstream fileName;
+		fileName << shaderName << '.' << std::hex << std::setw(16) << std::setfill('0') << cacheKey << ".bin";
+		return std::filesystem::path(s_ProgramCacheDirectory) / fileName.str();
+	}
+
 	/*
 		Constructor for the OpenGLShader with a filepath
 
-		First, the function reads the contents of the file using the ReadFile function. Then, it calls the PreProcess function which preprocesses the shader source code and separates the shader code into individual shader sources (vertex, fragment, geometry, etc.) that can be compiled separately. Finally, the Compile function is called to compile the shader sources.
+		First, the function reads the contents of the file using the ReadFile function. Then, it calls the PreProcess function which preprocesses the shader source code and separates the shader code into individual shader sources (vertex, fragment, geometry, etc.) that can be compiled separately (the #include lines are resolved before, the defines of the variant are added to each stage after). Finally, the CreateProgram function loads the program from the program binary cache, or compiles the shader sources when they aren't in it.
 
 		After compiling the shader sources, the constructor extracts the name of the shader from the file path by finding the last occurrence of a slash (/ or \) character to determine the beginning of the filename, and the last occurrence of a dot (.) character to determine the end of the filename extension. The substring of the file path between these two indices is set as the name of the shader using the substr function
 	*/
-	OpenGLShader::OpenGLShader(const std::string &filepath)
+	OpenGLShader::OpenGLShader(const std::string &filepath, const ShaderDefines &defines)
+			: m_Filepath(filepath), m_Defines(defines)
 	{
 		// AK_PROFILE_FUNCTION();
 
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
-		Compile(shaderSources);
-
-		// Extract name from filepath
+		// Extract name from filepath (first, the errors of the compilation mention it)
 		auto lastSlash = filepath.find_last_of("/\\");
 		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
 		auto lastDot = filepath.rfind('.');
 		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
-		m_Name = filepath.substr(lastSlash, count);
+		m_Name = ShaderPreprocessor::GetVariantName(filepath.substr(lastSlash, count), defines);
+
+		CreateProgram(LoadSources());
 	}
 
 	/*
@@ -54,7 +292,7 @@ namespace Arklumos
 		Then, it creates an std::unordered_map called sources, which maps a GLenum value (representing the shader type) to the corresponding shader source code.
 		The vertex shader source code is mapped to GL_VERTEX_SHADER, and the fragment shader source code is mapped to GL_FRAGMENT_SHADER.
 
-		Finally, the Compile function is called with the sources map as a parameter, which compiles and links the shader program
+		Finally, the CreateProgram function is called with the sources map as a parameter, which loads the program from the program binary cache or compiles and links it
 	*/
 	OpenGLShader::OpenGLShader(const std::string &name, const std::string &vertexSrc, const std::string &fragmentSrc)
 			: m_Name(name)
@@ -64,16 +302,44 @@ namespace Arklumos
 		std::unordered_map<GLenum, std::string> sources;
 		sources[GL_VERTEX_SHADER] = vertexSrc;
 		sources[GL_FRAGMENT_SHADER] = fragmentSrc;
-		Compile(sources);
+		CreateProgram(sources);
 	}
 
 	OpenGLShader::~OpenGLShader()
 	{
 		// AK_PROFILE_FUNCTION();
 
+		DiscardPendingCompile();
 		glDeleteProgram(m_RendererID);
 	}
 
+	void OpenGLShader::Reload()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (m_Filepath.empty())
+		{
+			return;
+		}
+
+		CreateProgram(LoadSources());
+
+		// The includes may have changed
+		ShaderHotReload::Register(this);
+	}
+
+	// Reads the file, resolves its includes, splits it in stages and adds the defines of the variant to each stage
+	std::unordered_map<GLenum, std::string> OpenGLShader::LoadSources()
+	{
+		std::string source = ShaderPreprocessor::ResolveIncludes(ReadFile(m_Filepath), m_Filepath, &m_SourceFiles);
+		auto shaderSources = PreProcess(source);
+		for (auto &kv : shaderSources)
+		{
+			kv.second = ShaderPreprocessor::InjectDefines(kv.second, m_Defines);
+		}
+		return shaderSources;
+	}
+
 	/*
 		Defines ReadFile which takes a std::string parameter filepath indicating the path to a file to be read. It returns a std::string that contains the contents of the file.
 
@@ -162,42 +428,216 @@ namespace Arklumos
 		return shaderSources;
 	}
 
-	// Compiles and attaches shader objects to the program
-	void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string> &shaderSources)
+	/*
+		Loads the program from the binary cache, or starts its compilation: the program is added to the cache once it is linked (see FinishCompile).
+		On a reload, the previous program stays in use until the new one is ready.
+	*/
+	void OpenGLShader::CreateProgram(const std::unordered_map<GLenum, std::string> &shaderSources)
 	{
 		// AK_PROFILE_FUNCTION();
 
-		/*
-			First, a new program is created using glCreateProgram(), which returns a unique identifier for the program. Then, the code checks if there are only two shaders in shaderSources.
-			If there are more than two, it asserts to stop the execution.
+		Timer timer;
+		uint64_t cacheKey = GetProgramCacheKey(shaderSources);
 
-			A loop is then used to create and compile each shader object from shaderSources. For each shader, a new shader object is created using glCreateShader().
-			The shader object is then set up with the shader source code using glShaderSource() and compiled using glCompileShader().
+		if (uint32_t program = LoadProgramBinary(cacheKey))
+		{
+			// A compilation started before (sources edited twice in a row) would replace the newer program
+			DiscardPendingCompile();
+			SetProgram(program);
 
-			After compiling the shader object, the code checks whether the compilation was successful by calling glGetShaderiv() with GL_COMPILE_STATUS as the parameter.
-			If the shader compilation was not successful, an error message is printed, and the shader object is deleted.
+			double loadTime = timer.ElapsedMillis();
+			RecordCacheHit(loadTime);
+			AK_CORE_INFO("Shader '{0}': loaded from the program cache in {1:.2f} ms", m_Name, loadTime);
+			return;
+		}
 
-			If the compilation is successful, the shader object is attached to the program using glAttachShader().
-			The shader object's unique identifier is also stored in the glShaderIDs array.
+		StartCompile(shaderSources, cacheKey);
+	}
+
+	// Returns the program, 0 when the binary isn't in the cache or isn't accepted by the driver
+	uint32_t OpenGLShader::LoadProgramBinary(uint64_t cacheKey)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (!IsProgramCacheSupported())
+		{
+			return 0;
+		}
+
+		std::filesystem::path path = GetProgramCachePath(m_Name, cacheKey);
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		if (!in)
+		{
+			return 0;
+		}
+
+		ProgramBinaryHeader header;
+		in.read((char *)&header, sizeof(header));
+		if (!in || header.Magic != s_ProgramCacheMagic || header.Version != s_ProgramCacheVersion || header.Key != cacheKey)
+		{
+			AK_CORE_WARN("Shader '{0}': invalid program cache file '{1}'", m_Name, path.string());
+			return 0;
+		}
+
+		std::vector<char> binary(header.Size);
+		in.read(binary.data(), header.Size);
+		if (!in)
+		{
+			AK_CORE_WARN("Shader '{0}': truncated program cache file '{1}'", m_Name, path.string());
+			return 0;
+		}
 
-			Once all shaders have been compiled and attached to the program, the program is linked using glLinkProgram().
-		*/
 		GLuint program = glCreateProgram();
+		glProgramBinary(program, (GLenum)header.Format, binary.data(), (GLsizei)header.Size);
+
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			// Usually a driver update, the file is replaced by the binary of the new compilation
+			AK_CORE_WARN("Shader '{0}': the driver rejected the cached program binary", m_Name);
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		return program;
+	}
+
+	void OpenGLShader::SaveProgramBinary(uint32_t program, uint64_t cacheKey)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		if (!IsProgramCacheSupported())
+		{
+			return;
+		}
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+		{
+			return;
+		}
+
+		ProgramBinaryHeader header;
+		header.Key = cacheKey;
+		std::vector<char> binary(length);
+		GLsizei written = 0;
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &written, &format, binary.data());
+		header.Format = (uint32_t)format;
+		header.Size = (uint32_t)written;
+
+		std::error_code error;
+		std::filesystem::create_directories(s_ProgramCacheDirectory, error);
+		if (error)
+		{
+			AK_CORE_WARN("Could not create the program cache directory '{0}': {1}", s_ProgramCacheDirectory, error.message());
+			return;
+		}
+
+		// The binaries of the previous versions of the shader are never loaded again
+		std::filesystem::path path = GetProgramCachePath(m_Name, cacheKey);
+		std::string prefix = m_Name + '.';
+		for (auto &entry : std::filesystem::directory_iterator(s_ProgramCacheDirectory, error))
+		{
+			std::string fileName = entry.path().filename().string();
+			if (entry.path() != path && entry.path().extension() == ".bin" && fileName.compare(0, prefix.size(), prefix) == 0 &&
+					fileName.size() == prefix.size() + 16 + 4)
+			{
+				std::filesystem::remove(entry.path(), error);
+			}
+		}
+
+		// Written next to the file then renamed, another instance of the application never reads half a file
+		std::filesystem::path temporaryPath = path;
+		temporaryPath += ".tmp";
+		{
+			std::ofstream out(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+			out.write((const char *)&header, sizeof(header));
+			out.write(binary.data(), header.Size);
+			if (!out)
+			{
+				AK_CORE_WARN("Could not write the program cache file '{0}'", temporaryPath.string());
+				return;
+			}
+		}
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+		{
+			AK_CORE_WARN("Could not write the program cache file '{0}': {1}", path.string(), error.message());
+			std::filesystem::remove(temporaryPath, error);
+		}
+	}
+
+	/*
+		Creates a shader object per stage, compiles them, attaches them to a new program and links it, without checking the results:
+		with GL_KHR_parallel_shader_compile the driver does the work on its threads, so every shader created in a row compiles at the same time.
+		The statuses are checked by FinishCompile once the program is complete (see UpdateCompilation).
+	*/
+	void OpenGLShader::StartCompile(const std::unordered_map<GLenum, std::string> &shaderSources, uint64_t cacheKey)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		DiscardPendingCompile();
+
 		AK_CORE_ASSERT(shaderSources.size() <= 2, "We only support 2 shaders for now");
-		std::array<GLenum, 2> glShaderIDs;
-		int glShaderIDIndex = 0;
+		m_PendingCompile.Program = glCreateProgram();
+		m_PendingCompile.CacheKey = cacheKey;
+		m_PendingCompile.StartTime.Reset();
+
 		for (auto &kv : shaderSources)
 		{
-			GLenum type = kv.first;
-			const std::string &source = kv.second;
-
-			GLuint shader = glCreateShader(type);
+			GLuint shader = glCreateShader(kv.first);
 
-			const GLchar *sourceCStr = source.c_str();
+			const GLchar *sourceCStr = kv.second.c_str();
 			glShaderSource(shader, 1, &sourceCStr, 0);
-
 			glCompileShader(shader);
 
+			glAttachShader(m_PendingCompile.Program, shader);
+			m_PendingCompile.Shaders.push_back(shader);
+		}
+
+		// Keeps the binary retrievable for the program cache
+		glProgramParameteri(m_PendingCompile.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(m_PendingCompile.Program);
+	}
+
+	bool OpenGLShader::UpdateCompilation(bool wait)
+	{
+		if (m_PendingCompile.Program == 0)
+		{
+			return true;
+		}
+
+		if (!wait && IsParallelCompileSupported())
+		{
+			GLint isComplete = GL_FALSE;
+			glGetProgramiv(m_PendingCompile.Program, GL_COMPLETION_STATUS_KHR, &isComplete);
+			if (isComplete == GL_FALSE)
+			{
+				return false;
+			}
+		}
+
+		FinishCompile();
+		return true;
+	}
+
+	/*
+		Checks the statuses of the compilation and of the link. On success the program replaces the previous one and is added to the program cache.
+		On failure the errors are logged: the previous program stays in use after a reload, a shader without previous program is a fatal error as before.
+	*/
+	void OpenGLShader::FinishCompile()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		PendingCompile pending = std::move(m_PendingCompile);
+		m_PendingCompile = PendingCompile();
+
+		bool success = true;
+		for (GLuint shader : pending.Shaders)
+		{
 			GLint isCompiled = 0;
 			glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
 			if (isCompiled == GL_FALSE)
@@ -205,62 +645,206 @@ namespace Arklumos
 				GLint maxLength = 0;
 				glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
 
-				std::vector<GLchar> infoLog(maxLength);
+				std::vector<GLchar> infoLog(std::max(maxLength, 1));
 				glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
 
-				glDeleteShader(shader);
-
-				AK_CORE_ERROR("{0}", infoLog.data());
-				AK_CORE_ASSERT(false, "Shader compilation failure!");
-				break;
+				AK_CORE_ERROR("Shader '{0}': {1}", m_Name, infoLog.data());
+				success = false;
 			}
-
-			glAttachShader(program, shader);
-			glShaderIDs[glShaderIDIndex++] = shader;
 		}
 
-		//
-		m_RendererID = program;
-
-		// Link our program
-		glLinkProgram(program);
-
 		// Note the different functions here: glGetProgram* instead of glGetShader*.
 		GLint isLinked = 0;
-		glGetProgramiv(program, GL_LINK_STATUS, (int *)&isLinked);
-		if (isLinked == GL_FALSE)
+		glGetProgramiv(pending.Program, GL_LINK_STATUS, &isLinked);
+		if (success && isLinked == GL_FALSE)
 		{
 			GLint maxLength = 0;
-			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+			glGetProgramiv(pending.Program, GL_INFO_LOG_LENGTH, &maxLength);
 
 			// The maxLength includes the NULL character
-			std::vector<GLchar> infoLog(maxLength);
-			glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
+			std::vector<GLchar> infoLog(std::max(maxLength, 1));
+			glGetProgramInfoLog(pending.Program, maxLength, &maxLength, &infoLog[0]);
+
+			AK_CORE_ERROR("Shader '{0}': {1}", m_Name, infoLog.data());
+			success = false;
+		}
+
+		for (GLuint shader : pending.Shaders)
+		{
+			glDetachShader(pending.Program, shader);
+			glDeleteShader(shader);
+		}
 
+		if (!success)
+		{
 			// We don't need the program anymore.
-			glDeleteProgram(program);
+			glDeleteProgram(pending.Program);
+
+			AK_CORE_ASSERT(m_RendererID != 0, "Shader compilation failure!");
+			AK_CORE_WARN("Shader '{0}': the compilation failed, the previous program stays in use", m_Name);
+			return;
+		}
+
+		SetProgram(pending.Program);
+		SaveProgramBinary(m_RendererID, pending.CacheKey);
+
+		// From the start of the compilation to the first use: the time the shader wasn't available
+		double compileTime = pending.StartTime.ElapsedMillis();
+		RecordCacheMiss(compileTime);
+		AK_CORE_INFO("Shader '{0}': not in the program cache, compiled and ready after {1:.2f} ms", m_Name, compileTime);
+	}
 
-			for (auto id : glShaderIDs)
+	void OpenGLShader::DiscardPendingCompile()
+	{
+		if (m_PendingCompile.Program == 0)
+		{
+			return;
+		}
+
+		for (GLuint shader : m_PendingCompile.Shaders)
+		{
+			glDeleteShader(shader);
+		}
+		glDeleteProgram(m_PendingCompile.Program);
+		m_PendingCompile = PendingCompile();
+	}
+
+	// Replaces the program, keeping the values of the uniforms of the previous one
+	void OpenGLShader::SetProgram(uint32_t program)
+	{
+		if (m_RendererID != 0)
+		{
+			CopyUniformValues(m_RendererID, program);
+			glDeleteProgram(m_RendererID);
+		}
+
+		m_RendererID = program;
+		ReflectUniforms();
+	}
+
+	/*
+		Queries the locations of all the active uniforms once, so setting a uniform is an integer lookup instead of a glGetUniformLocation with its string comparisons in the driver.
+		The uniforms of the uniform blocks have no location and are skipped, the blocks themselves are attached to the binding points of their uniform buffers.
+	*/
+	void OpenGLShader::ReflectUniforms()
+	{
+		m_UniformLocations.clear();
+
+		GLint uniformCount = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		GLint maxNameLength = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_RendererID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+
+			std::string name(nameBuffer.data(), length);
+			GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+			if (location == -1)
 			{
-				glDeleteShader(id);
+				continue;
 			}
 
-			AK_CORE_ERROR("{0}", infoLog.data());
-			AK_CORE_ASSERT(false, "Shader link failure!");
-			return;
+			// The arrays are reported as "name[0]", the elements aren't guaranteed to have consecutive locations
+			// The names are interned once here, so the logs and the warning of GetUniformLocation can print them
+			size_t bracket = name.find('[');
+			if (bracket != std::string::npos)
+			{
+				std::string arrayName = name.substr(0, bracket);
+				m_UniformLocations[StringId::Intern(arrayName)] = location;
+				for (GLint element = 0; element < size; element++)
+				{
+					std::string elementName = arrayName + "[" + std::to_string(element) + "]";
+					m_UniformLocations[StringId::Intern(elementName)] = glGetUniformLocation(m_RendererID, elementName.c_str());
+				}
+			}
+			else
+			{
+				m_UniformLocations[StringId::Intern(name)] = location;
+			}
 		}
 
-		for (auto id : glShaderIDs)
+		GLint blockCount = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+
+		nameBuffer.resize(std::max(maxNameLength, 1));
+		for (GLint i = 0; i < blockCount; i++)
 		{
-			glDetachShader(program, id);
-			glDeleteShader(id);
+			GLsizei length = 0;
+			glGetActiveUniformBlockName(m_RendererID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, nameBuffer.data());
+			std::string name(nameBuffer.data(), length);
+
+			GLint binding = 0;
+			glGetActiveUniformBlockiv(m_RendererID, (GLuint)i, GL_UNIFORM_BLOCK_BINDING, &binding);
+			GLint dataSize = 0;
+			glGetActiveUniformBlockiv(m_RendererID, (GLuint)i, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+
+			const UniformBuffer::BlockBinding *blockBinding = UniformBuffer::FindBlockBinding(StringId(name));
+			if (!blockBinding)
+			{
+				AK_CORE_WARN("Shader '{0}': no uniform buffer for the block '{1}'", m_Name, name);
+				continue;
+			}
+
+			// A block declared without binding is at 0, it gets the binding point of its buffer
+			if (binding != 0 && (uint32_t)binding != blockBinding->Binding)
+			{
+				AK_CORE_WARN("Shader '{0}': the block '{1}' is declared at the binding {2}, its uniform buffer is at {3}", m_Name, name, binding, blockBinding->Binding);
+			}
+			glUniformBlockBinding(m_RendererID, (GLuint)i, blockBinding->Binding);
+
+			if ((uint32_t)dataSize > blockBinding->Size)
+			{
+				AK_CORE_ERROR("Shader '{0}': the block '{1}' takes {2} bytes, its uniform buffer only {3}", m_Name, name, dataSize, blockBinding->Size);
+			}
+		}
+	}
+
+	int OpenGLShader::GetUniformLocation(StringId name)
+	{
+		// Without previous program, there is nothing to set the uniform on until the compilation is done
+		if (m_RendererID == 0)
+		{
+			UpdateCompilation(true);
+		}
+
+		auto it = m_UniformLocations.find(name);
+		if (it != m_UniformLocations.end())
+		{
+			return it->second;
+		}
+
+		/*
+			Not active (unknown or optimized out by the compiler): the uniform is ignored, and the warning isn't repeated.
+			An identifier built from a literal has no string unless it was interned somewhere, so the warning gives its hash and the uniforms the shader does have
+			(the array elements aside), which is enough to spot a typo.
+		*/
+		std::string activeUniforms;
+		for (const auto &[uniform, location] : m_UniformLocations)
+		{
+			const char *uniformName = uniform.GetString();
+			if (location != -1 && !strchr(uniformName, '['))
+			{
+				activeUniforms += activeUniforms.empty() ? uniformName : std::string(", ") + uniformName;
+			}
 		}
+		AK_CORE_WARN("Shader '{0}': uniform '{1}' ({2:#018x}) not found, active uniforms: {3}", m_Name, name.GetString(), name.GetHash(), activeUniforms);
+		m_UniformLocations[name] = -1;
+		return -1;
 	}
 
-	void OpenGLShader::Bind() const
+	void OpenGLShader::Bind()
 	{
 		// AK_PROFILE_FUNCTION();
 
+		// Switches to the new program once it is ready, only waits for it when there is no program yet
+		UpdateCompilation(m_RendererID == 0);
 		glUseProgram(m_RendererID);
 	}
 
@@ -271,98 +855,98 @@ namespace Arklumos
 		glUseProgram(0);
 	}
 
-	void OpenGLShader::SetInt(const std::string &name, int value)
+	void OpenGLShader::SetInt(StringId name, int value)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		UploadUniformInt(name, value);
 	}
 
-	void OpenGLShader::SetIntArray(const std::string &name, int *values, uint32_t count)
+	void OpenGLShader::SetIntArray(StringId name, int *values, uint32_t count)
 	{
 		UploadUniformIntArray(name, values, count);
 	}
 
-	void OpenGLShader::SetFloat(const std::string &name, float value)
+	void OpenGLShader::SetFloat(StringId name, float value)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		UploadUniformFloat(name, value);
 	}
 
-	void OpenGLShader::SetFloat2(const std::string &name, const glm::vec2 &value)
+	void OpenGLShader::SetFloat2(StringId name, const glm::vec2 &value)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		UploadUniformFloat2(name, value);
 	}
 
-	void OpenGLShader::SetFloat3(const std::string &name, const glm::vec3 &value)
+	void OpenGLShader::SetFloat3(StringId name, const glm::vec3 &value)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		UploadUniformFloat3(name, value);
 	}
 
-	void OpenGLShader::SetFloat4(const std::string &name, const glm::vec4 &value)
+	void OpenGLShader::SetFloat4(StringId name, const glm::vec4 &value)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		UploadUniformFloat4(name, value);
 	}
 
-	void OpenGLShader::SetMat4(const std::string &name, const glm::mat4 &value)
+	void OpenGLShader::SetMat4(StringId name, const glm::mat4 &value)
 	{
 		// AK_PROFILE_FUNCTION();
 
 		UploadUniformMat4(name, value);
 	}
 
-	void OpenGLShader::UploadUniformInt(const std::string &name, int value)
+	void OpenGLShader::UploadUniformInt(StringId name, int value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1i(location, value);
 	}
 
-	void OpenGLShader::UploadUniformIntArray(const std::string &name, int *values, uint32_t count)
+	void OpenGLShader::UploadUniformIntArray(StringId name, int *values, uint32_t count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1iv(location, count, values);
 	}
 
-	void OpenGLShader::UploadUniformFloat(const std::string &name, float value)
+	void OpenGLShader::UploadUniformFloat(StringId name, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1f(location, value);
 	}
 
-	void OpenGLShader::UploadUniformFloat2(const std::string &name, const glm::vec2 &value)
+	void OpenGLShader::UploadUniformFloat2(StringId name, const glm::vec2 &value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform2f(location, value.x, value.y);
 	}
 
-	void OpenGLShader::UploadUniformFloat3(const std::string &name, const glm::vec3 &value)
+	void OpenGLShader::UploadUniformFloat3(StringId name, const glm::vec3 &value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform3f(location, value.x, value.y, value.z);
 	}
 
-	void OpenGLShader::UploadUniformFloat4(const std::string &name, const glm::vec4 &value)
+	void OpenGLShader::UploadUniformFloat4(StringId name, const glm::vec4 &value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform4f(location, value.x, value.y, value.z, value.w);
 	}
 
-	void OpenGLShader::UploadUniformMat3(const std::string &name, const glm::mat3 &matrix)
+	void OpenGLShader::UploadUniformMat3(StringId name, const glm::mat3 &matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
-	void OpenGLShader::UploadUniformMat4(const std::string &name, const glm::mat4 &matrix)
+	void OpenGLShader::UploadUniformMat4(StringId name, const glm::mat4 &matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Arklumos/Core/Timer.h"
 #include "Arklumos/Renderer/Shader.h"
 #include <glm/glm.hpp>
 
@@ -12,41 +13,73 @@ namespace Arklumos
 	class OpenGLShader : public Shader
 	{
 	public:
-		OpenGLShader(const std::string &filepath);
+		OpenGLShader(const std::string &filepath, const ShaderDefines &defines = {});
 		OpenGLShader(const std::string &name, const std::string &vertexSrc, const std::string &fragmentSrc);
 		virtual ~OpenGLShader();
 
-		virtual void Bind() const override;
+		virtual void Bind() override;
 		virtual void Unbind() const override;
 
-		virtual void SetInt(const std::string &name, int value) override;
-		virtual void SetIntArray(const std::string &name, int *values, uint32_t count) override;
-		virtual void SetFloat(const std::string &name, float value) override;
-		virtual void SetFloat2(const std::string &name, const glm::vec2 &value) override;
-		virtual void SetFloat3(const std::string &name, const glm::vec3 &value) override;
-		virtual void SetFloat4(const std::string &name, const glm::vec4 &value) override;
-		virtual void SetMat4(const std::string &name, const glm::mat4 &value) override;
+		virtual void SetInt(StringId name, int value) override;
+		virtual void SetIntArray(StringId name, int *values, uint32_t count) override;
+		virtual void SetFloat(StringId name, float value) override;
+		virtual void SetFloat2(StringId name, const glm::vec2 &value) override;
+		virtual void SetFloat3(StringId name, const glm::vec3 &value) override;
+		virtual void SetFloat4(StringId name, const glm::vec4 &value) override;
+		virtual void SetMat4(StringId name, const glm::mat4 &value) override;
 
 		virtual const std::string &GetName() const override { return m_Name; }
+		virtual const std::vector<std::string> &GetSourceFiles() const override { return m_SourceFiles; }
 
-		void UploadUniformInt(const std::string &name, int value);
-		void UploadUniformIntArray(const std::string &name, int *values, uint32_t count);
+		virtual void Reload() override;
 
-		void UploadUniformFloat(const std::string &name, float value);
-		void UploadUniformFloat2(const std::string &name, const glm::vec2 &value);
-		void UploadUniformFloat3(const std::string &name, const glm::vec3 &value);
-		void UploadUniformFloat4(const std::string &name, const glm::vec4 &value);
+		void UploadUniformInt(StringId name, int value);
+		void UploadUniformIntArray(StringId name, int *values, uint32_t count);
 
-		void UploadUniformMat3(const std::string &name, const glm::mat3 &matrix);
-		void UploadUniformMat4(const std::string &name, const glm::mat4 &matrix);
+		void UploadUniformFloat(StringId name, float value);
+		void UploadUniformFloat2(StringId name, const glm::vec2 &value);
+		void UploadUniformFloat3(StringId name, const glm::vec3 &value);
+		void UploadUniformFloat4(StringId name, const glm::vec4 &value);
+
+		void UploadUniformMat3(StringId name, const glm::mat3 &matrix);
+		void UploadUniformMat4(StringId name, const glm::mat4 &matrix);
 
 	private:
 		std::string ReadFile(const std::string &filepath);
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string &source);
-		void Compile(const std::unordered_map<GLenum, std::string> &shaderSources);
+		std::unordered_map<GLenum, std::string> LoadSources();
+		void CreateProgram(const std::unordered_map<GLenum, std::string> &shaderSources);
+		void StartCompile(const std::unordered_map<GLenum, std::string> &shaderSources, uint64_t cacheKey);
+		// Returns false while the compilation is still running (only when not waiting)
+		bool UpdateCompilation(bool wait);
+		void FinishCompile();
+		void DiscardPendingCompile();
+		void SetProgram(uint32_t program);
+		uint32_t LoadProgramBinary(uint64_t cacheKey);
+		void SaveProgramBinary(uint32_t program, uint64_t cacheKey);
+		void ReflectUniforms();
+		int GetUniformLocation(StringId name);
 
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
 		std::string m_Name;
+
+		// Empty for a shader built from strings
+		std::string m_Filepath;
+		ShaderDefines m_Defines;
+		std::vector<std::string> m_SourceFiles;
+
+		// The program being compiled, it replaces m_RendererID once it is linked
+		struct PendingCompile
+		{
+			uint32_t Program = 0;
+			std::vector<uint32_t> Shaders;
+			uint64_t CacheKey = 0;
+			Timer StartTime;
+		};
+		PendingCompile m_PendingCompile;
+
+		// Locations of the active uniforms, filled after the link (an array is found by its name and by the name of each element)
+		std::unordered_map<StringId, int> m_UniformLocations;
 	};
 
 }
\ No newline at end of file
@@ -1,11 +1,24 @@
 #include "akpch.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 
+#include "Arklumos/Renderer/TextureLoader.h"
+
 #include <stb_image.h>
 
 namespace Arklumos
 {
 
+	int64_t OpenGLTexture2D::GetMemorySize(GLenum internalFormat, uint32_t width, uint32_t height)
+	{
+		int64_t bytesPerPixel = internalFormat == GL_RGB8 ? 3 : 4;
+		return bytesPerPixel * width * height;
+	}
+
+	OpenGLTexture2D::OpenGLTexture2D()
+			: m_Loaded(false)
+	{
+	}
+
 	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
 			: m_Width(width), m_Height(height)
 	{
@@ -22,6 +35,8 @@ namespace Arklumos
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		AK_TRACK_GPU_MEMORY(Textures, GetMemorySize(m_InternalFormat, m_Width, m_Height));
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(const std::string &path)
@@ -69,6 +84,8 @@ namespace Arklumos
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
 
 		stbi_image_free(data);
+
+		AK_TRACK_GPU_MEMORY(Textures, GetMemorySize(m_InternalFormat, m_Width, m_Height));
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
@@ -76,6 +93,8 @@ namespace Arklumos
 		// AK_PROFILE_FUNCTION();
 
 		glDeleteTextures(1, &m_RendererID);
+
+		AK_TRACK_GPU_MEMORY(Textures, -GetMemorySize(m_InternalFormat, m_Width, m_Height));
 	}
 
 	void OpenGLTexture2D::SetData(void *data, uint32_t size)
@@ -91,6 +110,11 @@ namespace Arklumos
 	{
 		// AK_PROFILE_FUNCTION();
 
+		if (!m_Loaded.load(std::memory_order_acquire))
+		{
+			TextureLoader::GetPlaceholder()->Bind(slot);
+			return;
+		}
 		glBindTextureUnit(slot, m_RendererID);
 	}
 }
\ No newline at end of file
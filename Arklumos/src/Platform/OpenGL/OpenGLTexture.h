@@ -4,12 +4,16 @@
 
 #include <glad/glad.h>
 
+#include <atomic>
+
 namespace Arklumos
 {
 
 	class OpenGLTexture2D : public Texture2D
 	{
 	public:
+		// Empty texture filled by the OpenGLTextureUploader, without any OpenGL call
+		OpenGLTexture2D();
 		OpenGLTexture2D(uint32_t width, uint32_t height);
 		OpenGLTexture2D(const std::string &path);
 		virtual ~OpenGLTexture2D();
@@ -22,17 +26,22 @@ namespace Arklumos
 
 		virtual void Bind(uint32_t slot = 0) const override;
 
-		virtual bool operator==(const Texture &other) const override
-		{
-			return m_RendererID == ((OpenGLTexture2D &)other).m_RendererID;
-		}
+		virtual bool IsLoaded() const override { return m_Loaded.load(std::memory_order_acquire); }
+
+		// Memory of a texture on the GPU, for the memory statistics (shared with the OpenGLTextureUploader, which creates the storage of the streamed textures)
+		static int64_t GetMemorySize(GLenum internalFormat, uint32_t width, uint32_t height);
 
 	private:
+		friend class OpenGLTextureUploader;
+
 		std::string m_Path;
-		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_RendererID = 0;
+
+		GLenum m_InternalFormat = 0, m_DataFormat = 0;
 
-		GLenum m_InternalFormat, m_DataFormat;
+		// Written by the render thread once the last rows are uploaded
+		std::atomic<bool> m_Loaded = true;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "akpch.h"
+#include "Platform/OpenGL/OpenGLTextureUploader.h"
+
+#include "Arklumos/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLTexture.h"
+
+#include <cstring>
+
+namespace Arklumos
+{
+
+	static constexpr GLbitfield s_StagingMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	OpenGLTextureUploader::OpenGLTextureUploader(uint32_t segmentSize, uint32_t segmentCount)
+			: m_SegmentSize(segmentSize), m_SegmentCount(segmentCount)
+	{
+		m_SegmentFences.resize(m_SegmentCount);
+
+		Renderer::Submit([this]()
+										 { CreateBuffer(); });
+	}
+
+	OpenGLTextureUploader::~OpenGLTextureUploader()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		// Deleted from a render command (see TextureLoader::Shutdown), after the uploads still queued
+		m_SegmentFences.clear();
+		if (m_BufferID)
+		{
+			glUnmapNamedBuffer(m_BufferID);
+			glDeleteBuffers(1, &m_BufferID);
+
+			AK_TRACK_GPU_MEMORY(Buffers, -(int64_t)m_SegmentSize * m_SegmentCount);
+		}
+	}
+
+	void OpenGLTextureUploader::CreateBuffer()
+	{
+		// AK_PROFILE_FUNCTION();
+
+		GLsizeiptr size = (GLsizeiptr)m_SegmentSize * m_SegmentCount;
+		glCreateBuffers(1, &m_BufferID);
+		glNamedBufferStorage(m_BufferID, size, nullptr, s_StagingMapFlags);
+		m_MappedData = (uint8_t *)glMapNamedBufferRange(m_BufferID, 0, size, s_StagingMapFlags);
+		AK_CORE_ASSERT(m_MappedData, "Mapping the texture staging buffer failed!");
+
+		AK_TRACK_GPU_MEMORY(Buffers, size);
+	}
+
+	Ref<Texture2D> OpenGLTextureUploader::CreateTexture(const std::string &path)
+	{
+		Ref<OpenGLTexture2D> texture = Renderer::CreateResource<OpenGLTexture2D>();
+		texture->m_Path = path;
+		return texture;
+	}
+
+	void OpenGLTextureUploader::BeginUpload(Texture2D *texture, const TextureImage &image)
+	{
+		OpenGLTexture2D *glTexture = static_cast<OpenGLTexture2D *>(texture);
+
+		// Set before the command is submitted, the render thread reads them after
+		glTexture->m_Width = image.Width;
+		glTexture->m_Height = image.Height;
+		glTexture->m_InternalFormat = image.Channels == 4 ? GL_RGBA8 : GL_RGB8;
+		glTexture->m_DataFormat = image.Channels == 4 ? GL_RGBA : GL_RGB;
+
+		Renderer::Submit([glTexture]()
+										 {
+			glCreateTextures(GL_TEXTURE_2D, 1, &glTexture->m_RendererID);
+			glTextureStorage2D(glTexture->m_RendererID, 1, glTexture->m_InternalFormat, glTexture->m_Width, glTexture->m_Height);
+
+			glTextureParameteri(glTexture->m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(glTexture->m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+			glTextureParameteri(glTexture->m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTextureParameteri(glTexture->m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+			AK_TRACK_GPU_MEMORY(Textures, OpenGLTexture2D::GetMemorySize(glTexture->m_InternalFormat, glTexture->m_Width, glTexture->m_Height)); });
+	}
+
+	void OpenGLTextureUploader::UploadRows(Texture2D *texture, const Ref<TextureImage> &image, uint32_t firstRow, uint32_t rowCount)
+	{
+		AK_CORE_ASSERT(image->GetRowSize() * rowCount <= m_SegmentSize, "The rows don't fit in a staging segment!");
+
+		OpenGLTexture2D *glTexture = static_cast<OpenGLTexture2D *>(texture);
+		GLenum dataFormat = glTexture->m_DataFormat;
+		m_SegmentUsed = true;
+
+		Renderer::Submit([this, glTexture, image, firstRow, rowCount, dataFormat]()
+										 { CopyRows(*image, firstRow, rowCount, glTexture->m_RendererID, dataFormat); });
+	}
+
+	void OpenGLTextureUploader::CopyRows(const TextureImage &image, uint32_t firstRow, uint32_t rowCount, uint32_t textureID, GLenum dataFormat)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		// First rows written in the segment this frame: the GPU must be done with the frame that used it last time (already the case in general, the frame pacer limits the frames in flight)
+		if (m_SegmentOffset == 0 && m_SegmentFences[m_Segment])
+		{
+			m_SegmentFences[m_Segment]->Wait(UINT64_MAX);
+			m_SegmentFences[m_Segment].reset();
+		}
+
+		uint32_t size = image.GetRowSize() * rowCount;
+		AK_CORE_ASSERT(m_SegmentOffset + size <= m_SegmentSize, "The uploads of the frame exceed the staging segment!");
+
+		size_t offset = (size_t)m_Segment * m_SegmentSize + m_SegmentOffset;
+		memcpy(m_MappedData + offset, image.Pixels + (size_t)firstRow * image.GetRowSize(), size);
+		m_SegmentOffset += size;
+
+		// The rows are tightly packed, an RGB row isn't always a multiple of 4 bytes
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_BufferID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(textureID, 0, 0, firstRow, image.Width, rowCount, dataFormat, GL_UNSIGNED_BYTE, (const void *)offset);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	void OpenGLTextureUploader::EndUpload(Texture2D *texture)
+	{
+		OpenGLTexture2D *glTexture = static_cast<OpenGLTexture2D *>(texture);
+		Renderer::Submit([glTexture]()
+										 { glTexture->m_Loaded.store(true, std::memory_order_release); });
+	}
+
+	void OpenGLTextureUploader::EndFrame()
+	{
+		if (!m_SegmentUsed)
+		{
+			return;
+		}
+		m_SegmentUsed = false;
+
+		Renderer::Submit([this]()
+										 {
+			m_SegmentFences[m_Segment] = GPUFence::Create();
+			m_Segment = (m_Segment + 1) % m_SegmentCount;
+			m_SegmentOffset = 0; });
+	}
+
+}
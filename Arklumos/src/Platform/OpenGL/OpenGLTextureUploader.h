@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Arklumos/Renderer/GPUFence.h"
+#include "Arklumos/Renderer/TextureUploader.h"
+
+#include <glad/glad.h>
+
+namespace Arklumos
+{
+
+	/*
+		The staging ring is a single pixel unpack buffer, mapped once for good (persistent and coherent mapping): the render thread copies the rows in it with a memcpy
+		and glTextureSubImage2D reads them from the buffer, so the driver copies them to the texture on its side without stalling the thread.
+		Each segment is guarded by the fence inserted after the uploads of the frame that used it.
+	*/
+	class OpenGLTextureUploader : public TextureUploader
+	{
+	public:
+		OpenGLTextureUploader(uint32_t segmentSize, uint32_t segmentCount);
+		virtual ~OpenGLTextureUploader();
+
+		virtual Ref<Texture2D> CreateTexture(const std::string &path) override;
+
+		virtual void BeginUpload(Texture2D *texture, const TextureImage &image) override;
+		virtual void UploadRows(Texture2D *texture, const Ref<TextureImage> &image, uint32_t firstRow, uint32_t rowCount) override;
+		virtual void EndUpload(Texture2D *texture) override;
+
+		virtual void EndFrame() override;
+
+	private:
+		// From the render commands
+		void CreateBuffer();
+		void CopyRows(const TextureImage &image, uint32_t firstRow, uint32_t rowCount, uint32_t textureID, GLenum dataFormat);
+
+	private:
+		uint32_t m_SegmentSize, m_SegmentCount;
+
+		// Owned by the render thread
+		uint32_t m_BufferID = 0;
+		uint8_t *m_MappedData = nullptr;
+		std::vector<Scope<GPUFence>> m_SegmentFences;
+		uint32_t m_Segment = 0;
+		uint32_t m_SegmentOffset = 0;
+
+		// Owned by the main thread: rows were submitted since the last EndFrame
+		bool m_SegmentUsed = false;
+	};
+
+}
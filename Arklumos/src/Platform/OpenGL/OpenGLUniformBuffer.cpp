@@ -0,0 +1,32 @@
+#include "akpch.h"
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+#include <glad/glad.h>
+
+namespace Arklumos
+{
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+		: m_Size(size), m_Binding(binding)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+
+		AK_TRACK_GPU_MEMORY(Buffers, m_Size);
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+
+		AK_TRACK_GPU_MEMORY(Buffers, -(int64_t)m_Size);
+	}
+
+	void OpenGLUniformBuffer::SetData(const void *data, uint32_t size, uint32_t offset)
+	{
+		AK_CORE_ASSERT(offset + size <= m_Size, "Uniform buffer overflow!");
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+}
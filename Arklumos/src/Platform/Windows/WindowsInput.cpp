@@ -6,60 +6,63 @@
 
 namespace Arklumos
 {
-	/*
-		Checks whether a key on the keyboard is currently pressed or not
 
-		The function IsKeyPressed takes an integer keycode as input, which represents the identifier for a particular key on the keyboard.
-		It then uses the Application class to get a reference to the GLFW window that is currently active. The GetNativeWindow() function returns a pointer to the underlying GLFW window handle.
-		The function then calls glfwGetKey with the window handle and the keycode as arguments to get the current state of the key. The glfwGetKey function returns GLFW_PRESS if the key is currently being pressed, and GLFW_RELEASE otherwise.
-		The function checks if the state returned by glfwGetKey is either GLFW_PRESS or GLFW_REPEAT, which indicates that the key is currently being pressed.
-		Finally, the function returns a boolean value indicating whether the key is currently pressed or not.
+	/*
+		Ranges of the key codes defined by GLFW (see KeyCodes.h). glfwGetKey reports an error for a code in between, so only these are polled.
 	*/
-	bool Input::IsKeyPressed(const KeyCode key)
+	struct KeyRange
 	{
-		auto window = static_cast<GLFWwindow *>(Application::Get().GetWindow().GetNativeWindow());
-		auto state = glfwGetKey(window, static_cast<int32_t>(key));
-		return state == GLFW_PRESS || state == GLFW_REPEAT;
-	}
+		KeyCode First;
+		KeyCode Last;
+	};
+
+	static constexpr KeyRange s_KeyRanges[] = {
+			{Key::Space, Key::Space},
+			{Key::Apostrophe, Key::Apostrophe},
+			{Key::Comma, Key::D9},
+			{Key::Semicolon, Key::Semicolon},
+			{Key::Equal, Key::Equal},
+			{Key::A, Key::RightBracket},
+			{Key::GraveAccent, Key::GraveAccent},
+			{Key::World1, Key::World2},
+			{Key::Escape, Key::End},
+			{Key::CapsLock, Key::Pause},
+			{Key::F1, Key::F25},
+			{Key::KP0, Key::KPEqual},
+			{Key::LeftShift, Key::Menu}};
 
 	/*
-		Checks whether a mouse button is currently pressed or not
+		Snapshots the keyboard and the mouse of the GLFW window of the application.
 
-		The function IsMouseButtonPressed takes an integer parameter button that represents the ID of the mouse button that needs to be checked.
-		The function first gets the native window handle from the application's window using Application::Get().GetWindow().GetNativeWindow() and casts it to a GLFW window object using static_cast<GLFWwindow*>. This is required because GLFW is the underlying windowing library being used by the application.
-		The function then calls glfwGetMouseButton function, passing in the GLFW window object and the button parameter. This function returns the current state of the specified mouse button (GLFW_PRESS or GLFW_RELEASE).
-		Finally, the function checks if the returned state is GLFW_PRESS (button is currently pressed) and returns true, otherwise it returns false.
+		glfwGetKey and glfwGetMouseButton return the last state GLFW saw in the events it processed, so the snapshot matches the events polled just before.
+		GLFW may only be called from the main thread, which is why the state is copied once here rather than queried by every caller.
 	*/
-	bool Input::IsMouseButtonPressed(const MouseCode button)
+	void Input::Update()
 	{
+		// AK_PROFILE_FUNCTION();
+
 		auto *window = static_cast<GLFWwindow *>(Application::Get().GetWindow().GetNativeWindow());
-		auto state = glfwGetMouseButton(window, static_cast<int32_t>(button));
-		return state == GLFW_PRESS;
-	}
 
-	/*
-		Method GetMousePosition of the WindowsInput class, which returns the current position of the mouse cursor within the window.
+		InputSnapshot snapshot;
+		for (const KeyRange &range : s_KeyRanges)
+		{
+			for (KeyCode key = range.First; key <= range.Last; key++)
+			{
+				// GLFW_REPEAT is only reported by the key callback, the polled state is GLFW_PRESS or GLFW_RELEASE
+				snapshot.Keys[key] = glfwGetKey(window, static_cast<int32_t>(key)) == GLFW_PRESS;
+			}
+		}
+
+		for (MouseCode button = 0; button < InputSnapshot::MouseButtonCount; button++)
+		{
+			snapshot.MouseButtons[button] = glfwGetMouseButton(window, static_cast<int32_t>(button)) == GLFW_PRESS;
+		}
 
-		The method starts by retrieving a pointer to the GLFW window associated with the application's window using Application::Get().GetWindow().GetNativeWindow(). Then, it calls the glfwGetCursorPos function, which retrieves the current position of the mouse cursor relative to the top-left corner of the window in screen coordinates. The function returns the position of the cursor as two double values, which are stored in the xpos and ypos variables.
-		Finally, the method returns a std::pair object with the xpos and ypos values cast to float.
-	*/
-	glm::vec2 Input::GetMousePosition()
-	{
-		auto *window = static_cast<GLFWwindow *>(Application::Get().GetWindow().GetNativeWindow());
 		double xpos, ypos;
 		glfwGetCursorPos(window, &xpos, &ypos);
+		snapshot.MousePosition = {(float)xpos, (float)ypos};
 
-		return {(float)xpos, (float)ypos};
-	}
-
-	float Input::GetMouseX()
-	{
-		return GetMousePosition().x;
-	}
-
-	float Input::GetMouseY()
-	{
-		return GetMousePosition().y;
+		SetSnapshot(snapshot);
 	}
 
-}
\ No newline at end of file
+}
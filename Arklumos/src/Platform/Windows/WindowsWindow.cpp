@@ -2,10 +2,12 @@
 #include "Platform/Windows/WindowsWindow.h"
 
 #include "Arklumos/Core/Input.h"
+#include "Arklumos/Core/Timer.h"
 
 #include "Arklumos/Events/ApplicationEvent.h"
 #include "Arklumos/Events/MouseEvent.h"
 #include "Arklumos/Events/KeyEvent.h"
+#include "Arklumos/Events/EventQueue.h"
 
 #include "Arklumos/Renderer/Renderer.h"
 
@@ -22,6 +24,22 @@ namespace Arklumos
 		AK_CORE_ERROR("GLFW Error ({0}): {1}", error, description);
 	}
 
+	// The GLFW callbacks run while the events are polled, on the main thread
+	template <typename WindowData, typename T>
+	static void EmitEvent(WindowData &data, T &event)
+	{
+		event.Timestamp = Timer::Now();
+
+		if (data.Queue)
+		{
+			data.Queue->Post(event);
+		}
+		else
+		{
+			data.EventCallback(event);
+		}
+	}
+
 	WindowsWindow::WindowsWindow(const WindowProps &props)
 	{
 		// AK_PROFILE_FUNCTION();
@@ -68,6 +86,7 @@ namespace Arklumos
 			if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
 				glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
 #endif
+			glfwWindowHint(GLFW_VISIBLE, props.Visible ? GLFW_TRUE : GLFW_FALSE);
 			m_p_Window = glfwCreateWindow((int)props.Width, (int)props.Height, m_Data.Title.c_str(), nullptr, nullptr);
 			++s_GLFWWindowCount;
 		}
@@ -88,7 +107,7 @@ namespace Arklumos
 			data.Height = height;
 
 			WindowResizeEvent event(width, height);
-			data.EventCallback(event); });
+			EmitEvent(data, event); });
 
 		// Listen event window close
 		// function sets the callback for closing the window, which creates a WindowCloseEvent event
@@ -96,7 +115,7 @@ namespace Arklumos
 															 {
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 			WindowCloseEvent event;
-			data.EventCallback(event); });
+			EmitEvent(data, event); });
 
 		// Listen event keypress / keyrelease
 		// function sets the callback for key presses and releases, which creates either a KeyPressedEvent or a KeyReleasedEvent event depending on the action
@@ -109,19 +128,19 @@ namespace Arklumos
 				case GLFW_PRESS:
 				{
 					KeyPressedEvent event(key, 0);
-					data.EventCallback(event);
+					EmitEvent(data, event);
 					break;
 				}
 				case GLFW_RELEASE:
 				{
 					KeyReleasedEvent event(key);
-					data.EventCallback(event);
+					EmitEvent(data, event);
 					break;
 				}
 				case GLFW_REPEAT:
 				{
 					KeyPressedEvent event(key, 1);
-					data.EventCallback(event);
+					EmitEvent(data, event);
 					break;
 				}
 			} });
@@ -132,7 +151,7 @@ namespace Arklumos
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
 			KeyTypedEvent event(keycode);
-			data.EventCallback(event); });
+			EmitEvent(data, event); });
 
 		// Listen event mousebutton pressed / released
 		// function sets the callback for mouse button presses and releases, which creates either a MouseButtonPressedEvent or a MouseButtonReleasedEvent event depending on the action
@@ -148,13 +167,13 @@ namespace Arklumos
 				case GLFW_PRESS:
 				{
 					MouseButtonPressedEvent event(button);
-					data.EventCallback(event);
+					EmitEvent(data, event);
 					break;
 				}
 				case GLFW_RELEASE:
 				{
 					MouseButtonReleasedEvent event(button);
-					data.EventCallback(event);
+					EmitEvent(data, event);
 					break;
 				}
 			} });
@@ -166,7 +185,7 @@ namespace Arklumos
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
 			MouseScrolledEvent event((float)xOffset, (float)yOffset);
-			data.EventCallback(event); });
+			EmitEvent(data, event); });
 
 		// Listen event mouse movement
 		// function sets the callback for mouse movement, which creates a MouseMovedEvent event
@@ -175,7 +194,7 @@ namespace Arklumos
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
 			MouseMovedEvent event((float)xPos, (float)yPos);
-			data.EventCallback(event); });
+			EmitEvent(data, event); });
 
 		// All these events are passed to the EventCallback function in the WindowData struct, which is responsible for handling these events.
 	}
@@ -198,22 +217,48 @@ namespace Arklumos
 	{
 		// AK_PROFILE_FUNCTION();
 
+		PollEvents();
+
+		// Events are polled on the main thread (GLFW requires it) but the buffers are swapped by the thread that owns the context
+		GraphicsContext *context = m_p_Context.get();
+		Renderer::Submit([context]()
+										 { context->SwapBuffers(); });
+	}
+
+	void WindowsWindow::PollEvents()
+	{
+		// AK_PROFILE_FUNCTION();
+
 		glfwPollEvents();
-		m_p_Context->SwapBuffers();
+	}
+
+	void WindowsWindow::WaitEvents(double timeout)
+	{
+		// AK_PROFILE_FUNCTION();
+
+		glfwWaitEventsTimeout(timeout);
+	}
+
+	void WindowsWindow::PostEmptyEvent()
+	{
+		glfwPostEmptyEvent();
 	}
 
 	void WindowsWindow::SetVSync(bool enabled)
 	{
 		// AK_PROFILE_FUNCTION();
 
-		if (enabled)
-		{
-			glfwSwapInterval(1);
-		}
-		else
-		{
-			glfwSwapInterval(0);
-		}
+		// The swap interval applies to the context current on the calling thread
+		Renderer::Submit([enabled]()
+										 {
+			if (enabled)
+			{
+				glfwSwapInterval(1);
+			}
+			else
+			{
+				glfwSwapInterval(0);
+			} });
 
 		m_Data.VSync = enabled;
 	}
@@ -15,16 +15,21 @@ namespace Arklumos
 		virtual ~WindowsWindow();
 
 		void OnUpdate() override;
+		void PollEvents() override;
+		void WaitEvents(double timeout) override;
+		void PostEmptyEvent() override;
 
 		unsigned int GetWidth() const override { return m_Data.Width; }
 		unsigned int GetHeight() const override { return m_Data.Height; }
 
 		// Window attributes
 		void SetEventCallback(const EventCallbackFn &callback) override { m_Data.EventCallback = callback; }
+		void SetEventQueue(EventQueue *queue) override { m_Data.Queue = queue; }
 		void SetVSync(bool enabled) override;
 		bool IsVSync() const override;
 
 		virtual void *GetNativeWindow() const { return m_p_Window; }
+		virtual GraphicsContext *GetGraphicsContext() const override { return m_p_Context.get(); }
 
 	private:
 		virtual void Init(const WindowProps &props);
@@ -41,6 +46,7 @@ namespace Arklumos
 			bool VSync;
 
 			EventCallbackFn EventCallback;
+			EventQueue *Queue = nullptr;
 		};
 
 		WindowData m_Data;
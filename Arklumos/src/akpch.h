@@ -26,6 +26,7 @@
 #include "Arklumos/Core/Log.h"
 
 #include "Arklumos/Debug/Instrumentor.h"
+#include "Arklumos/Debug/MemoryTracker.h"
 
 #ifdef AK_PLATFORM_WINDOWS
 #include <Windows.h>
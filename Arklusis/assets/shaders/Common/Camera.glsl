@@ -0,0 +1,6 @@
+// Camera uniform buffer, shared by the shaders (see Renderer::UploadCameraData)
+// No binding in the layout (the 330 shaders can't declare one): the block is attached to the camera uniform buffer by name when the shader is linked
+layout(std140) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
@@ -5,7 +5,8 @@
 
 layout(location = 0) in vec3 a_Position;
 
-uniform mat4 u_ViewProjection;
+#include "Common/Camera.glsl"
+
 uniform mat4 u_Transform;
 
 void main()
@@ -9,8 +9,8 @@ namespace Arklumos
 	class Arklusis : public Application
 	{
 	public:
-		Arklusis()
-				: Application("Arklusis the editor")
+		Arklusis(const ApplicationSpecification &specification)
+				: Application(specification)
 		{
 			PushLayer(new EditorLayer());
 		}
@@ -22,7 +22,12 @@ namespace Arklumos
 
 	Application *CreateApplication()
 	{
-		return new Arklusis();
+		ApplicationSpecification specification;
+		specification.Name = "Arklusis the editor";
+		// The editor is idle most of the time, it only draws when something changes
+		specification.IdleRendering = true;
+
+		return new Arklusis(specification);
 	}
 
 }
\ No newline at end of file
@@ -9,11 +9,16 @@
 
 #include "ImGuizmo.h"
 
-#include "Arklumos/Math/Math.h"
+#include <filesystem>
+
+#include "Arklumos/Math/TransformBatch.h"
 
 namespace Arklumos
 {
 
+	// The edited scene while the play mode runs
+	static const char *s_PlayModeBackupPath = "assets/cache/PlayModeBackup.arklumos";
+
 	EditorLayer::EditorLayer()
 			: Layer("EditorLayer"), m_CameraController(1280.0f / 720.0f), m_SquareColor({0.2f, 0.3f, 0.8f, 1.0f})
 	{
@@ -23,10 +28,12 @@ namespace Arklumos
 	{
 		// AK_PROFILE_FUNCTION();
 
-		m_CheckerboardTexture = Texture2D::Create("assets/textures/Checkerboard.png");
+		// Decoded on the worker threads, draws white until it is uploaded
+		m_CheckerboardTexture = TextureLoader::Load("assets/textures/Checkerboard.png");
 
 		FramebufferSpecification fbSpec;
-		fbSpec.Attachments = {FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::RED_INTEGER, FramebufferTextureFormat::Depth};
+		// Picking goes through the spatial index of the scene, no need for an entity ID attachment
+		fbSpec.Attachments = {FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::Depth};
 		fbSpec.Width = 1280;
 		fbSpec.Height = 720;
 		m_Framebuffer = Framebuffer::Create(fbSpec);
@@ -35,6 +42,29 @@ namespace Arklumos
 
 		m_EditorCamera = EditorCamera(30.0f, 1.778f, 0.1f, 1000.0f);
 
+		// Bindings of the editor, the defaults are used when the file is missing
+		if (!m_InputActions.Deserialize("assets/input/EditorInput.yaml"))
+		{
+			for (KeyCode key : {Key::A, Key::D, Key::W, Key::S, Key::Q, Key::E})
+			{
+				m_InputActions.AddKeyBinding("CameraMove", key);
+			}
+			m_InputActions.AddKeyBinding("GizmoSnap", Key::LeftControl);
+		}
+
+		// Only the events the editor reacts to reach the layer
+		SubscribeEvent<KeyPressedEvent>(AK_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
+		SubscribeEvent<MouseButtonPressedEvent>(AK_BIND_EVENT_FN(EditorLayer::OnMouseButtonPressed));
+		SubscribeEvent<MouseScrolledEvent>([this](MouseScrolledEvent &e)
+																			 {
+			m_CameraController.OnEvent(e);
+			m_EditorCamera.OnEvent(e);
+			return false; });
+		SubscribeEvent<WindowResizeEvent>([this](WindowResizeEvent &e)
+																			{
+			m_CameraController.OnEvent(e);
+			return false; });
+
 #if 0
 		// Entity
 		auto square = m_ActiveScene->CreateEntity("Green Square");
@@ -122,6 +152,12 @@ namespace Arklumos
 		if (m_ViewportFocused)
 		{
 			m_CameraController.OnUpdate(ts);
+
+			// The camera moves as long as a key is held, which sends no event after the first one (except the repeats, much slower than the frame rate)
+			if (m_InputActions.IsActionDown("CameraMove"))
+			{
+				Application::Get().RequestRedraw();
+			}
 		}
 
 		m_EditorCamera.OnUpdate(ts);
@@ -132,11 +168,28 @@ namespace Arklumos
 		RenderCommand::SetClearColor({0.1f, 0.1f, 0.1f, 1});
 		RenderCommand::Clear();
 
-		// Clear our entity ID attachment to -1
-		m_Framebuffer->ClearAttachment(1, -1);
-
 		// Update scene
-		m_ActiveScene->OnUpdateEditor(ts, m_EditorCamera);
+		switch (m_SceneState)
+		{
+		case SceneState::Edit:
+		{
+			m_ActiveScene->OnUpdateEditor(ts, m_EditorCamera);
+			break;
+		}
+		case SceneState::Play:
+		{
+			// The simulation moves on at each frame, and the interpolated entities are drawn between the last two fixed updates
+			m_ActiveScene->OnUpdateRuntime(ts, Application::Get().GetFixedUpdateAlpha());
+			Application::Get().RequestRedraw();
+			break;
+		}
+		}
+
+		// Edits made by the panels are drawn in the next frame
+		if (m_ActiveScene->ConsumeChanges())
+		{
+			Application::Get().RequestRedraw();
+		}
 
 		auto [mx, my] = ImGui::GetMousePos();
 		mx -= m_ViewportBounds[0].x;
@@ -146,15 +199,50 @@ namespace Arklumos
 		int mouseX = (int)mx;
 		int mouseY = (int)my;
 
-		if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y)
+		ViewportCamera viewportCamera;
+		if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y && GetViewportCamera(viewportCamera))
+		{
+			/*
+				Picking on the CPU: the mouse position is converted to normalized device coordinates, then unprojected on the near and far planes of the camera the viewport is drawn with.
+				The ray between those two points is cast against the spatial index of the scene, which returns the closest quad under the cursor.
+				This avoids reading back the framebuffer, which stalls the CPU until the GPU is done rendering the frame.
+			*/
+			glm::vec2 ndc = {(mx / viewportSize.x) * 2.0f - 1.0f, (my / viewportSize.y) * 2.0f - 1.0f};
+			glm::mat4 inverseViewProjection = glm::inverse(viewportCamera.Projection * viewportCamera.View);
+
+			glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc.x, ndc.y, -1.0f, 1.0f);
+			glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+			glm::vec3 rayStart = glm::vec3(nearPoint) / nearPoint.w;
+			glm::vec3 rayEnd = glm::vec3(farPoint) / farPoint.w;
+
+			Ray ray(rayStart, glm::normalize(rayEnd - rayStart));
+			m_HoveredEntity = m_ActiveScene->Raycast(ray, glm::length(rayEnd - rayStart));
+
+			// Quads stacked under the cursor where the ray crosses the Z = 0 plane (the plane of a 2D scene), the results only live for the frame
+			m_HoveredQuadCount = 0;
+			float planeDistance = glm::abs(ray.Direction.z) > std::numeric_limits<float>::epsilon() ? -ray.Origin.z / ray.Direction.z : -1.0f;
+			if (planeDistance >= 0.0f)
+			{
+				m_HoveredQuadCount = (uint32_t)m_ActiveScene->QueryPoint(glm::vec2(ray.GetPoint(planeDistance))).size();
+			}
+		}
+		else
 		{
-			int pixelData = m_Framebuffer->ReadPixel(1, mouseX, mouseY);
-			m_HoveredEntity = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_ActiveScene.get());
+			m_HoveredEntity = {};
+			m_HoveredQuadCount = 0;
 		}
 
 		m_Framebuffer->Unbind();
 	}
 
+	void EditorLayer::OnFixedUpdate(Timestep ts)
+	{
+		if (m_SceneState == SceneState::Play)
+		{
+			m_ActiveScene->OnFixedUpdateRuntime(ts);
+		}
+	}
+
 	void EditorLayer::OnImGuiRender()
 	{
 		// AK_PROFILE_FUNCTION();
@@ -243,6 +331,18 @@ namespace Arklumos
 				ImGui::EndMenu();
 			}
 
+			if (ImGui::MenuItem(m_SceneState == SceneState::Edit ? "Play" : "Stop"))
+			{
+				if (m_SceneState == SceneState::Edit)
+				{
+					OnScenePlay();
+				}
+				else
+				{
+					OnSceneStop();
+				}
+			}
+
 			ImGui::EndMenuBar();
 		}
 
@@ -250,12 +350,12 @@ namespace Arklumos
 
 		ImGui::Begin("Stats");
 
-		std::string name = "None";
+		const char *name = "None";
 		if (m_HoveredEntity)
 		{
-			name = m_HoveredEntity.GetComponent<TagComponent>().Tag;
+			name = m_HoveredEntity.GetComponent<TagComponent>().Tag.c_str();
 		}
-		ImGui::Text("Hovered Entity: %s", name.c_str());
+		ImGui::Text("Hovered Entity: %s (%d quads under the cursor)", name, m_HoveredQuadCount);
 
 		auto stats = Renderer2D::GetStats();
 		ImGui::Text("Renderer2D Stats:");
@@ -263,6 +363,41 @@ namespace Arklumos
 		ImGui::Text("Quads: %d", stats.QuadCount);
 		ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 		ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+		ImGui::Text("Transform kernels: %s", Math::GetTransformBatchInstructionSet());
+		ImGui::Text("Job workers: %d%s", JobSystem::GetWorkerCount(), JobSystem::IsSingleThreaded() ? " (single threaded)" : "");
+		auto frameAllocatorStats = FrameAllocator::GetStats();
+		ImGui::Text("Frame memory: %.1f KB (+ %.1f KB double buffered) / %.1f KB", frameAllocatorStats.UsedMemory / 1024.0f, frameAllocatorStats.DoubleBufferedUsedMemory / 1024.0f, frameAllocatorStats.Capacity / 1024.0f);
+		auto framePacerStats = FramePacer::GetStats();
+		ImGui::Text("Frame: CPU %.2f ms, latency %.2f ms", framePacerStats.CPUTime, framePacerStats.Latency);
+		ImGui::Text("Frames in flight: %d / %d (fence wait %.2f ms)", framePacerStats.FramesInFlight, FramePacer::GetMaxFramesInFlight(), framePacerStats.FenceWaitTime);
+		if (RenderThread::IsRunning())
+		{
+			auto renderThreadStats = RenderThread::GetStats();
+			ImGui::Text("Render thread: %.2f ms (main waited %.2f ms)", renderThreadStats.RenderTime, renderThreadStats.WaitTime);
+			ImGui::Text("Render commands: %d (%.1f KB)", renderThreadStats.CommandCount, renderThreadStats.CommandMemory / 1024.0f);
+		}
+		auto resourceStats = ResourceRegistry::GetStats();
+		ImGui::Text("Rendering resources: %d (%d released this frame, %d slots)", resourceStats.LiveResources, resourceStats.PendingReleases, resourceStats.Capacity);
+		if (TextureLoader::IsLoading())
+		{
+			auto textureProgress = TextureLoader::GetProgress();
+			ImGui::Text("Loading textures: %d/%d (%.0f%%)", textureProgress.Loaded, textureProgress.Requested, textureProgress.GetFraction() * 100.0f);
+		}
+
+		ImGui::Text("Scene registry: %.1f KB", m_ActiveScene->GetRegistryMemoryUsage() / 1024.0f);
+		for (uint8_t i = 0; i < (uint8_t)GPUMemoryType::Count; i++)
+		{
+			ImGui::Text("GPU %s: %.1f MB", MemoryTracker::GetGPUMemoryTypeName((GPUMemoryType)i), MemoryTracker::GetGPUMemory((GPUMemoryType)i) / (1024.0f * 1024.0f));
+		}
+		// The CPU memory is only tracked in the builds defining AK_TRACK_MEMORY
+		if (MemoryTracker::IsEnabled())
+		{
+			for (uint8_t i = 0; i < (uint8_t)MemoryTag::Count; i++)
+			{
+				auto tagStats = MemoryTracker::GetTagStats((MemoryTag)i);
+				ImGui::Text("%s: %.1f KB (peak %.1f KB, %.0f allocs/s)", MemoryTracker::GetTagName((MemoryTag)i), tagStats.LiveBytes / 1024.0f, tagStats.PeakBytes / 1024.0f, tagStats.AllocationRate);
+			}
+		}
 
 		ImGui::End();
 
@@ -289,30 +424,24 @@ namespace Arklumos
 
 		// Gizmos
 		Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity();
-		if (selectedEntity && m_GizmoType != -1)
+		ViewportCamera viewportCamera;
+		if (selectedEntity && m_GizmoType != -1 && GetViewportCamera(viewportCamera))
 		{
-			ImGuizmo::SetOrthographic(false);
+			ImGuizmo::SetOrthographic(viewportCamera.Orthographic);
 			ImGuizmo::SetDrawlist();
 
 			ImGuizmo::SetRect(m_ViewportBounds[0].x, m_ViewportBounds[0].y, m_ViewportBounds[1].x - m_ViewportBounds[0].x, m_ViewportBounds[1].y - m_ViewportBounds[0].y);
 
-			// Camera
-			// Runtime camera from entity
-			// auto cameraEntity = m_ActiveScene->GetPrimaryCameraEntity();
-			// const auto& camera = cameraEntity.GetComponent<CameraComponent>().Camera;
-			// const glm::mat4& cameraProjection = camera.GetProjection();
-			// glm::mat4 cameraView = glm::inverse(cameraEntity.GetComponent<TransformComponent>().GetTransform());
-
-			// Editor camera
-			const glm::mat4 &cameraProjection = m_EditorCamera.GetProjection();
-			glm::mat4 cameraView = m_EditorCamera.GetViewMatrix();
+			// Camera the viewport is drawn with (the primary camera of the scene while playing)
+			const glm::mat4 &cameraProjection = viewportCamera.Projection;
+			const glm::mat4 &cameraView = viewportCamera.View;
 
-			// Entity transform
+			// Entity transform, the gizmo works in world space with the matrix cached by the scene
 			auto &tc = selectedEntity.GetComponent<TransformComponent>();
-			glm::mat4 transform = tc.GetTransform();
+			glm::mat4 transform = selectedEntity.GetComponent<WorldTransformComponent>().Transform;
 
 			// Snapping
-			bool snap = Input::IsKeyPressed(Key::LeftControl);
+			bool snap = m_InputActions.IsActionDown("GizmoSnap");
 			float snapValue = 0.5f; // Snap to 0.5m for translation/scale
 			// Snap to 45 degrees for rotation
 			if (m_GizmoType == ImGuizmo::OPERATION::ROTATE)
@@ -328,8 +457,15 @@ namespace Arklumos
 
 			if (ImGuizmo::IsUsing())
 			{
+				// Back to the space of the parent, the TransformComponent is local
+				if (Entity parent = selectedEntity.GetParent())
+				{
+					transform = glm::inverse(parent.GetComponent<WorldTransformComponent>().Transform) * transform;
+				}
+
+				// The batch decomposition handles the pitches of +/-90 degrees that rotation snapping produces
 				glm::vec3 translation, rotation, scale;
-				Math::DecomposeTransform(transform, translation, rotation, scale);
+				Math::DecomposeTransforms(&transform, 1, &translation, &rotation, &scale);
 
 				glm::vec3 deltaRotation = rotation - tc.Rotation;
 				tc.Translation = translation;
@@ -344,16 +480,28 @@ namespace Arklumos
 		ImGui::End();
 	}
 
-	void EditorLayer::OnEvent(Event &e)
+	bool EditorLayer::GetViewportCamera(ViewportCamera &camera)
 	{
-		m_CameraController.OnEvent(e);
-		m_EditorCamera.OnEvent(e);
-
-		EventDispatcher dispatcher(e);
-		// TODO: Remove Event typpee !!
-		// AK_CORE_INFO(e);
-		dispatcher.Dispatch<KeyPressedEvent>(AK_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
-		dispatcher.Dispatch<MouseButtonPressedEvent>(AK_BIND_EVENT_FN(EditorLayer::OnMouseButtonPressed));
+		if (m_SceneState == SceneState::Edit)
+		{
+			camera.Projection = m_EditorCamera.GetProjection();
+			camera.View = m_EditorCamera.GetViewMatrix();
+			camera.Orthographic = false;
+			return true;
+		}
+
+		// The world matrix the scene renders the primary camera with (see Scene::OnUpdateRuntime)
+		Entity cameraEntity = m_ActiveScene->GetPrimaryCameraEntity();
+		if (!cameraEntity)
+		{
+			return false;
+		}
+
+		const SceneCamera &sceneCamera = cameraEntity.GetComponent<CameraComponent>().Camera;
+		camera.Projection = sceneCamera.GetProjection();
+		camera.View = glm::inverse(cameraEntity.GetComponent<WorldTransformComponent>().Transform);
+		camera.Orthographic = sceneCamera.GetProjectionType() == SceneCamera::ProjectionType::Orthographic;
+		return true;
 	}
 
 	bool EditorLayer::OnKeyPressed(KeyPressedEvent &e)
@@ -451,6 +599,9 @@ namespace Arklumos
 
 	void EditorLayer::NewScene()
 	{
+		// The scene being played is dropped along with its saved state
+		m_SceneState = SceneState::Edit;
+
 		m_ActiveScene = CreateRef<Scene>();
 		m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
@@ -461,6 +612,8 @@ namespace Arklumos
 		std::optional<std::string> filepath = FileDialogs::OpenFile("Arklumos Scene (*.arklumos)\0*.arklumos\0");
 		if (filepath)
 		{
+			m_SceneState = SceneState::Edit;
+
 			m_ActiveScene = CreateRef<Scene>();
 			m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 			m_SceneHierarchyPanel.SetContext(m_ActiveScene);
@@ -482,4 +635,31 @@ namespace Arklumos
 		}
 	}
 
-}
\ No newline at end of file
+	void EditorLayer::OnScenePlay()
+	{
+		std::filesystem::create_directories(std::filesystem::path(s_PlayModeBackupPath).parent_path());
+
+		SceneSerializer serializer(m_ActiveScene);
+		serializer.Serialize(s_PlayModeBackupPath);
+
+		m_SceneState = SceneState::Play;
+	}
+
+	void EditorLayer::OnSceneStop()
+	{
+		m_SceneState = SceneState::Edit;
+
+		// Back to the scene as it was edited, the selection belonged to the played scene
+		m_ActiveScene = CreateRef<Scene>();
+		m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_HoveredEntity = {};
+
+		SceneSerializer serializer(m_ActiveScene);
+		if (!serializer.Deserialize(s_PlayModeBackupPath))
+		{
+			AK_CORE_ERROR("Could not restore the edited scene from '{0}'", s_PlayModeBackupPath);
+		}
+	}
+
+}
@@ -20,8 +20,8 @@ namespace Arklumos
 		virtual void OnDetach() override;
 
 		void OnUpdate(Timestep ts) override;
+		virtual void OnFixedUpdate(Timestep ts) override;
 		virtual void OnImGuiRender() override;
-		void OnEvent(Event &e) override;
 
 	private:
 		bool OnKeyPressed(KeyPressedEvent &e);
@@ -31,6 +31,19 @@ namespace Arklumos
 		void OpenScene();
 		void SaveSceneAs();
 
+		void OnScenePlay();
+		void OnSceneStop();
+
+		// Camera the viewport is drawn with, used by the picking and the gizmos
+		struct ViewportCamera
+		{
+			glm::mat4 Projection;
+			glm::mat4 View;
+			bool Orthographic = false;
+		};
+		// The editor camera, or the primary camera of the scene while playing. False when playing without a primary camera (nothing is drawn)
+		bool GetViewportCamera(ViewportCamera &camera);
+
 		Arklumos::OrthographicCameraController m_CameraController;
 
 		// Temp
@@ -44,11 +57,14 @@ namespace Arklumos
 		Entity m_SecondCamera;
 
 		Entity m_HoveredEntity;
+		uint32_t m_HoveredQuadCount = 0;
 
 		bool m_PrimaryCamera = true;
 
 		EditorCamera m_EditorCamera;
 
+		InputActionMap m_InputActions;
+
 		Ref<Texture2D> m_CheckerboardTexture;
 
 		bool m_ViewportFocused = false, m_ViewportHovered = false;
@@ -59,6 +75,17 @@ namespace Arklumos
 
 		int m_GizmoType = -1;
 
+		/*
+			Play mode runs the scene like the runtime: fixed updates, scripts and systems, rendered from the primary camera of the scene.
+			The edited scene is saved when playing starts and loaded back when it stops, so the simulation doesn't change it.
+		*/
+		enum class SceneState
+		{
+			Edit = 0,
+			Play = 1
+		};
+		SceneState m_SceneState = SceneState::Edit;
+
 		// Panels
 		SceneHierarchyPanel m_SceneHierarchyPanel;
 	};
@@ -33,10 +33,29 @@ namespace Arklumos
 	{
 		ImGui::Begin("Scene Hierarchy");
 
+		// Only the roots are drawn here, the children are drawn by their parent node
 		m_Context->m_Registry.each([&](auto entityID)
 															 {
 			Entity entity{ entityID , m_Context.get() };
-			DrawEntityNode(entity); });
+			if (!entity.GetParent())
+			{
+				DrawEntityNode(entity);
+			} });
+
+		if (m_ReparentRequested)
+		{
+			m_Context->SetParent(m_ReparentEntity, m_ReparentTarget);
+			m_ReparentRequested = false;
+		}
+
+		if (m_CreateChildRequested)
+		{
+			if (m_Context->m_Registry.valid(m_CreateChildParent))
+			{
+				m_Context->CreateEntity("Empty Entity").SetParent(m_CreateChildParent);
+			}
+			m_CreateChildRequested = false;
+		}
 
 		if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
 			m_SelectionContext = {};
@@ -72,17 +91,57 @@ namespace Arklumos
 	{
 		auto &tag = entity.GetComponent<TagComponent>().Tag;
 
+		// Copied: the storage of the component can change while the node is drawn (a child deleting itself removes its components)
+		const RelationshipComponent relationship = entity.GetComponent<RelationshipComponent>();
+
 		ImGuiTreeNodeFlags flags = ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
 		flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
+		if (relationship.ChildrenCount == 0)
+		{
+			flags |= ImGuiTreeNodeFlags_Leaf;
+		}
 		bool opened = ImGui::TreeNodeEx((void *)(uint64_t)(uint32_t)entity, flags, tag.c_str());
 		if (ImGui::IsItemClicked())
 		{
 			m_SelectionContext = entity;
 		}
 
+		// Drag an entity onto another one to make it a child of the target
+		if (ImGui::BeginDragDropSource())
+		{
+			uint32_t entityID = (uint32_t)entity;
+			ImGui::SetDragDropPayload("SCENE_HIERARCHY_ENTITY", &entityID, sizeof(uint32_t));
+			ImGui::Text("%s", tag.c_str());
+			ImGui::EndDragDropSource();
+		}
+
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+			{
+				m_ReparentEntity = Entity{(entt::entity) * (const uint32_t *)payload->Data, m_Context.get()};
+				m_ReparentTarget = entity;
+				m_ReparentRequested = true;
+			}
+			ImGui::EndDragDropTarget();
+		}
+
 		bool entityDeleted = false;
 		if (ImGui::BeginPopupContextItem())
 		{
+			if (ImGui::MenuItem("Create Child Entity"))
+			{
+				m_CreateChildParent = entity;
+				m_CreateChildRequested = true;
+			}
+
+			if (relationship.Parent != entt::null && ImGui::MenuItem("Detach From Parent"))
+			{
+				m_ReparentEntity = entity;
+				m_ReparentTarget = {};
+				m_ReparentRequested = true;
+			}
+
 			if (ImGui::MenuItem("Delete Entity"))
 			{
 				entityDeleted = true;
@@ -93,19 +152,22 @@ namespace Arklumos
 
 		if (opened)
 		{
-			ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
-			bool opened = ImGui::TreeNodeEx((void *)9817239, flags, tag.c_str());
-			if (opened)
+			// The next sibling is read before drawing a child, the child may delete itself
+			entt::entity child = relationship.FirstChild;
+			while (child != entt::null)
 			{
-				ImGui::TreePop();
+				entt::entity next = m_Context->m_Registry.get<RelationshipComponent>(child).NextSibling;
+				DrawEntityNode(Entity{child, m_Context.get()});
+				child = next;
 			}
 			ImGui::TreePop();
 		}
 
 		if (entityDeleted)
 		{
+			// The children are destroyed along with the entity, the selection may be one of them
 			m_Context->DestroyEntity(entity);
-			if (m_SelectionContext == entity)
+			if (m_SelectionContext && !m_Context->m_Registry.valid(m_SelectionContext))
 			{
 				m_SelectionContext = {};
 			}
@@ -277,6 +339,19 @@ namespace Arklumos
 				ImGui::CloseCurrentPopup();
 			}
 
+			if (ImGui::MenuItem("Fixed Step Interpolation"))
+			{
+				if (!m_SelectionContext.HasComponent<InterpolatedTransformComponent>())
+				{
+					m_SelectionContext.AddComponent<InterpolatedTransformComponent>();
+				}
+				else
+				{
+					AK_CORE_WARN("This entity already has the Fixed Step Interpolation Component!");
+				}
+				ImGui::CloseCurrentPopup();
+			}
+
 			ImGui::EndPopup();
 		}
 
@@ -357,6 +432,9 @@ namespace Arklumos
 
 		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [](auto &component)
 																					 { ImGui::ColorEdit4("Color", glm::value_ptr(component.Color)); });
+
+		DrawComponent<InterpolatedTransformComponent>("Fixed Step Interpolation", entity, [](auto &component)
+																									{ ImGui::TextWrapped("Drawn between the last two fixed updates in play mode"); });
 	}
 
 }
\ No newline at end of file
@@ -26,6 +26,14 @@ namespace Arklumos
 
 		Ref<Scene> m_Context;
 		Entity m_SelectionContext;
+
+		// Reparenting requested by a drag and drop, applied once the whole tree is drawn to not modify the links being walked
+		Entity m_ReparentEntity, m_ReparentTarget;
+		bool m_ReparentRequested = false;
+
+		// Child creation requested from the context menu of a node, applied once the tree is drawn like the reparenting (adding components can move the storage being read)
+		Entity m_CreateChildParent;
+		bool m_CreateChildRequested = false;
 	};
 
 }
\ No newline at end of file
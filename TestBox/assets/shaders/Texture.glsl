@@ -1,8 +1,16 @@
 // Basic Texture Shader
+//
+// Variants (see Renderer2D):
+//   MAX_TEXTURE_SLOTS: size of u_Textures, the cases of the switch past it are compiled out
+//   ENTITY_ID_OUTPUT: writes the entity ID to a second, integer color attachment (off unless Renderer2D::SetEntityIDOutput enables it)
 
 #type vertex
 #version 450
 
+#ifndef ENTITY_ID_OUTPUT
+#define ENTITY_ID_OUTPUT 0
+#endif
+
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
@@ -10,13 +18,15 @@ layout(location = 3) in float a_TexIndex;
 layout(location = 4) in float a_TilingFactor;
 layout(location = 5) in int a_EntityID;
 
-uniform mat4 u_ViewProjection;
+#include "Common/Camera.glsl"
 
 out vec4 v_Color;
 out vec2 v_TexCoord;
 out flat float v_TexIndex;
 out float v_TilingFactor;
+#if ENTITY_ID_OUTPUT
 out flat int v_EntityID;
+#endif
 
 void main()
 {
@@ -24,23 +34,36 @@ void main()
 	v_TexCoord = a_TexCoord;
 	v_TexIndex = a_TexIndex;
 	v_TilingFactor = a_TilingFactor;
+#if ENTITY_ID_OUTPUT
 	v_EntityID = a_EntityID;
+#endif
 	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
 }
 
 #type fragment
 #version 450
 
+#ifndef MAX_TEXTURE_SLOTS
+#define MAX_TEXTURE_SLOTS 32
+#endif
+#ifndef ENTITY_ID_OUTPUT
+#define ENTITY_ID_OUTPUT 0
+#endif
+
 layout(location = 0) out vec4 color;
+#if ENTITY_ID_OUTPUT
 layout(location = 1) out int color2;
+#endif
 
 in vec4 v_Color;
 in vec2 v_TexCoord;
 in flat float v_TexIndex;
 in float v_TilingFactor;
+#if ENTITY_ID_OUTPUT
 in flat int v_EntityID;
+#endif
 
-uniform sampler2D u_Textures[32];
+uniform sampler2D u_Textures[MAX_TEXTURE_SLOTS];
 
 void main()
 {
@@ -49,6 +72,7 @@ void main()
 	switch(int(v_TexIndex))
 	{
 		case  0: texColor *= texture(u_Textures[ 0], v_TexCoord * v_TilingFactor); break;
+#if MAX_TEXTURE_SLOTS > 1
 		case  1: texColor *= texture(u_Textures[ 1], v_TexCoord * v_TilingFactor); break;
 		case  2: texColor *= texture(u_Textures[ 2], v_TexCoord * v_TilingFactor); break;
 		case  3: texColor *= texture(u_Textures[ 3], v_TexCoord * v_TilingFactor); break;
@@ -56,6 +80,8 @@ void main()
 		case  5: texColor *= texture(u_Textures[ 5], v_TexCoord * v_TilingFactor); break;
 		case  6: texColor *= texture(u_Textures[ 6], v_TexCoord * v_TilingFactor); break;
 		case  7: texColor *= texture(u_Textures[ 7], v_TexCoord * v_TilingFactor); break;
+#endif
+#if MAX_TEXTURE_SLOTS > 8
 		case  8: texColor *= texture(u_Textures[ 8], v_TexCoord * v_TilingFactor); break;
 		case  9: texColor *= texture(u_Textures[ 9], v_TexCoord * v_TilingFactor); break;
 		case 10: texColor *= texture(u_Textures[10], v_TexCoord * v_TilingFactor); break;
@@ -64,6 +90,8 @@ void main()
 		case 13: texColor *= texture(u_Textures[13], v_TexCoord * v_TilingFactor); break;
 		case 14: texColor *= texture(u_Textures[14], v_TexCoord * v_TilingFactor); break;
 		case 15: texColor *= texture(u_Textures[15], v_TexCoord * v_TilingFactor); break;
+#endif
+#if MAX_TEXTURE_SLOTS > 16
 		case 16: texColor *= texture(u_Textures[16], v_TexCoord * v_TilingFactor); break;
 		case 17: texColor *= texture(u_Textures[17], v_TexCoord * v_TilingFactor); break;
 		case 18: texColor *= texture(u_Textures[18], v_TexCoord * v_TilingFactor); break;
@@ -80,8 +108,11 @@ void main()
 		case 29: texColor *= texture(u_Textures[29], v_TexCoord * v_TilingFactor); break;
 		case 30: texColor *= texture(u_Textures[30], v_TexCoord * v_TilingFactor); break;
 		case 31: texColor *= texture(u_Textures[31], v_TexCoord * v_TilingFactor); break;
+#endif
 	}
 	color = texColor;
 
+#if ENTITY_ID_OUTPUT
 	color2 = v_EntityID;
+#endif
 }
\ No newline at end of file
@@ -49,7 +49,11 @@ ExampleLayer::ExampleLayer()
 			layout(location = 0) in vec3 a_Position;
 			layout(location = 1) in vec4 a_Color;
 
-			uniform mat4 u_ViewProjection;
+			layout(std140) uniform Camera
+			{
+				mat4 u_ViewProjection;
+			};
+
 			uniform mat4 u_Transform;
 
 			out vec3 v_Position;
@@ -85,7 +89,11 @@ ExampleLayer::ExampleLayer()
 			
 			layout(location = 0) in vec3 a_Position;
 
-			uniform mat4 u_ViewProjection;
+			layout(std140) uniform Camera
+			{
+				mat4 u_ViewProjection;
+			};
+
 			uniform mat4 u_Transform;
 
 			out vec3 v_Position;
@@ -144,8 +152,11 @@ void ExampleLayer::OnUpdate(Arklumos::Timestep ts)
 
 	glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f));
 
-	m_FlatColorShader->Bind();
-	m_FlatColorShader->SetFloat3("u_Color", m_SquareColor);
+	// Direct shader/texture calls are render commands as well, they must run in order with the draws submitted around them
+	Arklumos::Renderer::Submit([shader = m_FlatColorShader, color = m_SquareColor]()
+														 {
+		shader->Bind();
+		shader->SetFloat3("u_Color", color); });
 
 	for (int y = 0; y < 20; y++)
 	{
@@ -159,9 +170,11 @@ void ExampleLayer::OnUpdate(Arklumos::Timestep ts)
 
 	auto textureShader = m_ShaderLibrary.Get("Texture");
 
-	m_Texture->Bind();
+	Arklumos::Renderer::Submit([texture = m_Texture]()
+														 { texture->Bind(); });
 	Arklumos::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.5f)));
-	m_ArklumosLogoTexture->Bind();
+	Arklumos::Renderer::Submit([texture = m_ArklumosLogoTexture]()
+														 { texture->Bind(); });
 	Arklumos::Renderer::Submit(textureShader, m_SquareVA, glm::scale(glm::mat4(1.0f), glm::vec3(1.5f)));
 
 	// Triangle
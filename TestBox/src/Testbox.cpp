@@ -8,7 +8,8 @@
 class Testbox : public Arklumos::Application
 {
 public:
-	Testbox()
+	Testbox(const Arklumos::ApplicationSpecification &specification)
+			: Arklumos::Application(specification)
 	{
 		// PushLayer(new ExampleLayer());
 		PushLayer(new Testbox2D());
@@ -21,5 +22,9 @@ public:
 
 Arklumos::Application *Arklumos::CreateApplication()
 {
-	return new Testbox();
+	Arklumos::ApplicationSpecification specification;
+	specification.Name = "TestBox";
+	specification.UseRenderThread = true;
+
+	return new Testbox(specification);
 }
\ No newline at end of file
@@ -88,6 +88,11 @@ project "Arklumos"
 		{
 		}
 
+	-- The AVX2 transform kernels are the only code built with AVX2 enabled (the CPU is checked at runtime before calling them)
+	filter "files:Arklumos/src/Arklumos/Math/TransformBatchAVX2.cpp"
+		flags { "NoPCH" }
+		vectorextensions "AVX2"
+
 	filter "configurations:Debug"
 		defines "AK_DEBUG"
 		runtime "Debug"